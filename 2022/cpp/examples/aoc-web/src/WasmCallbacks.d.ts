@@ -1,4 +1,5 @@
 export interface WasmCallbacks {
     reiceivePuzzleSolution: (day: number, part: number, solution?: string) => void;
+    receivePuzzleMetrics?: (day: number, phase: number, milliseconds: number, allocations: number, bytesAllocated: number, peakBytes: number) => void;
     debug?: (code: number) => void;
 }
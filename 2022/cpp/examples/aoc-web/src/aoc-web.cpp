@@ -1,18 +1,53 @@
 #include "aoc_y2022.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 
 #include <emscripten.h>
 
 extern "C" {
     extern void jsReceivePuzzleSolutionCb(int day, int part, const char *output, int outputLength);
+    extern void jsReceivePuzzleMetricsCb(int day, int phase, double milliseconds, double allocations,
+                                         double bytesAllocated, double peakBytes);
     extern void jsDebugCb(int out);
 }
 
+namespace
+{
+
+bool report_solution(const int day, const int part, AOC::Y2022::IPuzzle::Solution_t result)
+{
+    std::string resultString;
+    if (std::holds_alternative<std::int64_t>(result))
+    {
+        resultString = std::to_string(std::get<std::int64_t>(result));
+    }
+    else if (std::holds_alternative<std::string>(result))
+    {
+        resultString = std::move(std::get<std::string>(result));
+    }
+    if (resultString.size() < 1)
+    {
+        jsReceivePuzzleSolutionCb(day, part, nullptr, 0);
+        jsDebugCb(__LINE__);
+        return false;
+    }
+    jsReceivePuzzleSolutionCb(day, part, resultString.c_str(), static_cast<int>(resultString.size()));
+    return true;
+}
+
+// the input of the text area, kept between edits so that only the edited lines are parsed again
+std::unique_ptr<AOC::Y2022::IPuzzleSession> pSession;
+int sessionDay{};
+
+} // namespace
+
 EMSCRIPTEN_KEEPALIVE
 extern "C" int solve_puzzle(const int day, const char * const input, const int inputLength)
 {
@@ -27,34 +62,18 @@ extern "C" int solve_puzzle(const int day, const char * const input, const int i
     }
 
     const std::string_view input_view{input, static_cast<std::size_t>(inputLength)};
-    auto pPuzzle = AOC::Y2022::PuzzleFactory::CreatePuzzle(static_cast<std::uint8_t>(day), input_view);
+    auto pPuzzle = AOC::Y2022::PuzzleFactory::CreatePuzzle(
+        static_cast<std::uint8_t>(day), input_view,
+        AOC::Y2022::PuzzleOptions{.inputLifetime = AOC::Y2022::InputLifetime::borrowed});
     if (pPuzzle == nullptr)
     {
         jsDebugCb(__LINE__);
         return EXIT_FAILURE;
     }
 
-    const auto solvePart = [day](const auto &result, int part) -> bool {
-        std::string resultString;
-        if (std::holds_alternative<std::int64_t>(result))
-        {
-            resultString = std::to_string(std::get<std::int64_t>(result));
-        }
-        else if (std::holds_alternative<std::string>(result))
-        {
-            resultString = std::move(std::get<std::string>(result));
-        }
-        if (resultString.size() < 1)
-        {
-            jsReceivePuzzleSolutionCb(day, part, nullptr, 0);
-            jsDebugCb(__LINE__);
-            return false;
-        }
-        jsReceivePuzzleSolutionCb(day, part, resultString.c_str(), static_cast<int>(resultString.size()));
-        return true;
-    };
-    bool success = solvePart(pPuzzle->Part1(), 1);
-    success = solvePart(pPuzzle->Part2(), 2) && success;
+    auto solutions = AOC::Y2022::PuzzleFactory::SolveConcurrently(*pPuzzle);
+    bool success = report_solution(day, 1, std::move(solutions.part1));
+    success = report_solution(day, 2, std::move(solutions.part2)) && success;
     if (!success)
     {
         jsDebugCb(__LINE__);
@@ -64,6 +83,42 @@ extern "C" int solve_puzzle(const int day, const char * const input, const int i
     return EXIT_SUCCESS;
 }
 
+/*!
+ * \brief Like solve_puzzle, but additionally reports time and allocations of parsing, part 1 and part 2
+ * through jsReceivePuzzleMetricsCb (phase 0, 1 and 2).
+ */
+EMSCRIPTEN_KEEPALIVE
+extern "C" int solve_puzzle_instrumented(const int day, const char * const input, const int inputLength)
+{
+    if ((day < 1) || (day > 25) || (input == nullptr) || (inputLength < 1))
+    {
+        jsDebugCb(__LINE__);
+        return EXIT_FAILURE;
+    }
+
+    const std::string_view input_view{input, static_cast<std::size_t>(inputLength)};
+    auto report = AOC::Y2022::PuzzleFactory::SolveInstrumented(
+        static_cast<std::uint8_t>(day), input_view,
+        AOC::Y2022::PuzzleOptions{.inputLifetime = AOC::Y2022::InputLifetime::borrowed});
+    if (!report.created)
+    {
+        jsDebugCb(__LINE__);
+        return EXIT_FAILURE;
+    }
+
+    for (std::size_t phase = 0u; phase < report.phases.size(); ++phase)
+    {
+        const auto &metrics = report.phases[phase];
+        jsReceivePuzzleMetricsCb(day, static_cast<int>(phase),
+                                 std::chrono::duration<double, std::milli>(metrics.duration).count(),
+                                 static_cast<double>(metrics.allocations), static_cast<double>(metrics.bytesAllocated),
+                                 static_cast<double>(metrics.peakBytes));
+    }
+    bool success = report_solution(day, 1, std::move(report.part1));
+    success = report_solution(day, 2, std::move(report.part2)) && success;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 EMSCRIPTEN_KEEPALIVE
 extern "C" int has_implementation_for_day(int day)
 {
@@ -73,3 +128,50 @@ extern "C" int has_implementation_for_day(int day)
     }
     return AOC::Y2022::PuzzleFactory::has_implementation_for_day(static_cast<std::uint8_t>(day)) ? 1 : 0;
 }
+
+/*!
+ * \brief Keeps the input for edit_session, which then only needs to be passed the changes.
+ *
+ * Nothing is reported, the input is expected to be solved by solve_puzzle or solve_puzzle_instrumented already.
+ * Opening parses the input once more, so the front end only does so once the input is edited.
+ */
+EMSCRIPTEN_KEEPALIVE
+extern "C" int open_session(const int day, const char * const input, const int inputLength)
+{
+    pSession.reset();
+    if ((day < 1) || (day > 25) || (input == nullptr) || (inputLength < 0))
+    {
+        jsDebugCb(__LINE__);
+        return EXIT_FAILURE;
+    }
+    pSession = AOC::Y2022::PuzzleFactory::CreateSession(static_cast<std::uint8_t>(day),
+                                                        std::string_view{input, static_cast<std::size_t>(inputLength)});
+    sessionDay = day;
+    return (pSession != nullptr) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*!
+ * \brief Replaces length bytes at offset of the input given to open_session and reports the solutions like
+ * solve_puzzle.
+ */
+EMSCRIPTEN_KEEPALIVE
+extern "C" int edit_session(const int offset, const int length, const char * const replacement,
+                            const int replacementLength)
+{
+    if ((pSession == nullptr) || (offset < 0) || (length < 0) || (replacementLength < 0) ||
+        ((replacement == nullptr) && (replacementLength > 0)))
+    {
+        jsDebugCb(__LINE__);
+        return EXIT_FAILURE;
+    }
+    const std::string_view replacement_view{replacement, static_cast<std::size_t>(replacementLength)};
+    if (!pSession->Edit(static_cast<std::size_t>(offset), static_cast<std::size_t>(length), replacement_view))
+    {
+        jsDebugCb(__LINE__);
+        return EXIT_FAILURE;
+    }
+    auto solutions = pSession->Solve();
+    bool success = report_solution(sessionDay, 1, std::move(solutions.part1));
+    success = report_solution(sessionDay, 2, std::move(solutions.part2)) && success;
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -14,7 +14,12 @@ const page = {
 };
 
 let lastInput = { day: 0, text: "" };
-let endTimes: [number, number] = [performance.now(), performance.now()];
+// UTF-8 input of the open session, the wasm module is only passed the bytes that changed since
+let sessionInput: Uint8Array | undefined = undefined;
+// input of the last full solve, the session is only opened for it once it is edited
+let solvedText: string | undefined = undefined;
+type PhaseMetrics = { milliseconds: number; allocations: number; peakBytes: number };
+let phaseMetrics: PhaseMetrics[] = [];
 
 const aocWasmCallbacks: WasmCallbacks = {
   reiceivePuzzleSolution: (
@@ -36,20 +41,58 @@ const aocWasmCallbacks: WasmCallbacks = {
       }
       return;
     }
-    endTimes[index] = performance.now();
     let view = page.viewResults[index];
     view.innerText = solution || "failed";
   },
+  receivePuzzleMetrics: (
+    day: number,
+    phase: number,
+    milliseconds: number,
+    allocations: number,
+    bytesAllocated: number,
+    peakBytes: number
+  ): void => {
+    phaseMetrics[phase] = { milliseconds, allocations, peakBytes };
+  },
 };
 
 Module["onRuntimeInitialized"] = (_) => {
   type SolveFunction = (day: number, input: string, inputLen: number) => number;
   type HasImplementationFunction = (day: number) => number;
-  const solve_puzzle: SolveFunction = Module.cwrap("solve_puzzle", "number", [
+  const solve_puzzle: SolveFunction = Module.cwrap("solve_puzzle_instrumented", "number", [
     "number",
     "string",
     "number",
   ]);
+  type OpenSessionFunction = (day: number, input: Uint8Array, inputLen: number) => number;
+  type EditSessionFunction = (offset: number, length: number, replacement: Uint8Array, replacementLen: number) => number;
+  const open_session: OpenSessionFunction = Module.cwrap("open_session", "number", ["number", "array", "number"]);
+  const edit_session: EditSessionFunction = Module.cwrap("edit_session", "number", [
+    "number",
+    "number",
+    "array",
+    "number",
+  ]);
+  const encoder = new TextEncoder();
+
+  // the shortest byte range whose replacement turns the input before into the input after
+  const findEdit = (before: Uint8Array, after: Uint8Array) => {
+    const common = Math.min(before.length, after.length);
+    let prefix = 0;
+    while (prefix < common && before[prefix] === after[prefix]) {
+      prefix++;
+    }
+    let suffix = 0;
+    while (suffix < common - prefix && before[before.length - 1 - suffix] === after[after.length - 1 - suffix]) {
+      suffix++;
+    }
+    return {
+      offset: prefix,
+      length: before.length - prefix - suffix,
+      replacement: after.subarray(prefix, after.length - suffix),
+    };
+  };
+
   const has_implementation_for_day: HasImplementationFunction = Module.cwrap(
     "has_implementation_for_day",
     "number",
@@ -75,19 +118,48 @@ Module["onRuntimeInitialized"] = (_) => {
     if ((day === lastInput.day) && (puzzleInput == lastInput.text)) {
       return;
     }
+    const dayChanged = day !== lastInput.day;
     lastInput.day = day;
     lastInput.text = puzzleInput;
     if (day < 1 || isNaN(day) || puzzleInput.length < 1) {
       page.viewResults.forEach((viewResult) => (viewResult.innerText = ""));
+      sessionInput = undefined;
+      solvedText = undefined;
       // console.log("input error");
       return;
     }
+    if (!dayChanged && (sessionInput !== undefined || solvedText !== undefined)) {
+      // an edit in the text area, only the changed lines are parsed again
+      const startTime = performance.now();
+      if (sessionInput === undefined) {
+        // opening the session parses the solved input once more, which only pays off if it is edited
+        const solvedInput = encoder.encode(solvedText);
+        sessionInput = open_session(day, solvedInput, solvedInput.length) === 0 ? solvedInput : undefined;
+        solvedText = undefined;
+      }
+      if (sessionInput !== undefined) {
+        const input = encoder.encode(puzzleInput);
+        const edit = findEdit(sessionInput, input);
+        sessionInput = input;
+        edit_session(edit.offset, edit.length, edit.replacement, edit.replacement.length);
+        const endTime = performance.now();
+        page.timingsOutputs.innerHTML = `Incremental solve: ${(endTime - startTime).toFixed(5)}&nbsp;ms`;
+        return;
+      }
+    }
     page.viewResults.forEach((result) => (result.innerText = "computing…"));
+    phaseMetrics = [];
     const startTime = performance.now();
     solve_puzzle(day, puzzleInput, puzzleInput.length);
     const endTime = performance.now();
     const decimalPlaces = 5;
-    page.timingsOutputs.innerHTML = `Part&nbsp;1: ${(endTimes[0] - startTime).toFixed(decimalPlaces)}&nbsp;ms | Part&nbsp;2: ${(endTimes[1] - endTimes[0]).toFixed(decimalPlaces)}&nbsp;ms | Total ${(endTime - startTime).toFixed(decimalPlaces)}&nbsp;ms`;
+    const phaseNames = ["Parsing", "Part&nbsp;1", "Part&nbsp;2"];
+    const phases = phaseMetrics.map((metrics, phase) =>
+      `${phaseNames[phase]}: ${metrics.milliseconds.toFixed(decimalPlaces)}&nbsp;ms, ${metrics.allocations}&nbsp;allocations, peak&nbsp;${metrics.peakBytes}&nbsp;bytes`
+    );
+    page.timingsOutputs.innerHTML = [...phases, `Total ${(endTime - startTime).toFixed(decimalPlaces)}&nbsp;ms`].join(" | ");
+    sessionInput = undefined;
+    solvedText = puzzleInput;
   };
 
   const loadPuzzleInputFile = (file: File) => {
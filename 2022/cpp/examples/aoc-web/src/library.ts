@@ -19,6 +19,16 @@ mergeInto(LibraryManager.library, {
         : undefined;
     aocWasmCallbacks.reiceivePuzzleSolution(day, part, solution);
   },
+  jsReceivePuzzleMetricsCb: function (
+    day: number,
+    phase: number,
+    milliseconds: number,
+    allocations: number,
+    bytesAllocated: number,
+    peakBytes: number
+  ) {
+    aocWasmCallbacks.receivePuzzleMetrics?.(day, phase, milliseconds, allocations, bytesAllocated, peakBytes);
+  },
   jsDebugCb: function (code: number) {
     aocWasmCallbacks.debug?.(code);
   },
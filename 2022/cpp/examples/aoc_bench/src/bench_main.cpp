@@ -0,0 +1,268 @@
+#include "aoc_y2022.hpp"
+#include "duration_statistics.hpp"
+#include "input_source.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+using Nanoseconds = std::chrono::nanoseconds;
+
+enum class Phase : std::size_t
+{
+    parse, part1, part2, total, max,
+};
+constexpr std::array<std::string_view, static_cast<std::size_t>(Phase::max)> phaseNames{
+    "parse", "part1", "part2", "total",
+};
+
+struct Settings final
+{
+    std::string inputDirectory{AOC_Y2022_BENCH_DEFAULT_INPUT_DIR};
+    std::string outputFile{"aoc-2022-bench.json"};
+    std::uint32_t repeat{10u};
+    std::uint32_t warmup{1u};
+    std::vector<std::uint8_t> days{};
+};
+
+struct DayResult final
+{
+    std::uint8_t day{};
+    std::size_t inputBytes{};
+    bool solved{};
+    std::array<AOC::Y2022::DurationStatistics, static_cast<std::size_t>(Phase::max)> phases{};
+    double throughputMBps{};
+};
+
+[[nodiscard]] DayResult benchmark_day(const std::uint8_t day, const std::string_view input, const Settings &settings)
+{
+    DayResult result{.day = day, .inputBytes = input.size(), .solved = true};
+    std::array<std::vector<Nanoseconds>, static_cast<std::size_t>(Phase::max)> samples{};
+    for (auto &phaseSamples : samples)
+    {
+        phaseSamples.reserve(settings.repeat);
+    }
+    for (std::uint32_t run = 0u; run < (settings.warmup + settings.repeat); ++run)
+    {
+        const auto start = Clock::now();
+        auto pPuzzle = AOC::Y2022::PuzzleFactory::CreatePuzzle(
+            day, input, AOC::Y2022::PuzzleOptions{.inputLifetime = AOC::Y2022::InputLifetime::borrowed});
+        const auto parsed = Clock::now();
+        if (pPuzzle == nullptr)
+        {
+            result.solved = false;
+            return result;
+        }
+        const auto solution1 = pPuzzle->Part1();
+        const auto solved1 = Clock::now();
+        const auto solution2 = pPuzzle->Part2();
+        const auto solved2 = Clock::now();
+        result.solved = result.solved && !std::holds_alternative<std::monostate>(solution1) &&
+                        !std::holds_alternative<std::monostate>(solution2);
+        if (run < settings.warmup)
+        {
+            continue;
+        }
+        samples[static_cast<std::size_t>(Phase::parse)].push_back(parsed - start);
+        samples[static_cast<std::size_t>(Phase::part1)].push_back(solved1 - parsed);
+        samples[static_cast<std::size_t>(Phase::part2)].push_back(solved2 - solved1);
+        samples[static_cast<std::size_t>(Phase::total)].push_back(solved2 - start);
+    }
+    for (std::size_t phase = 0u; phase < samples.size(); ++phase)
+    {
+        result.phases[phase] = AOC::Y2022::compute_statistics(std::move(samples[phase]));
+    }
+    const auto medianTotal = std::chrono::duration<double>(result.phases[static_cast<std::size_t>(Phase::total)].median);
+    if (medianTotal.count() > 0.0)
+    {
+        result.throughputMBps = (static_cast<double>(result.inputBytes) / 1'000'000.0) / medianTotal.count();
+    }
+    return result;
+}
+
+void print_table(const std::vector<DayResult> &results)
+{
+    const auto toMicroseconds = [](const Nanoseconds ns) {
+        return std::chrono::duration<double, std::micro>(ns).count();
+    };
+    std::cout << std::left << std::setw(5) << "day" << std::setw(7) << "phase" << std::right << std::setw(14)
+              << "min [us]" << std::setw(14) << "median [us]" << std::setw(14) << "p99 [us]" << std::setw(12)
+              << "MB/s" << '\n';
+    std::cout << std::fixed << std::setprecision(1);
+    for (const auto &result : results)
+    {
+        for (std::size_t phase = 0u; phase < result.phases.size(); ++phase)
+        {
+            const auto &stats = result.phases[phase];
+            std::cout << std::left << std::setw(5) << ((phase == 0u) ? std::to_string(result.day) : "")
+                      << std::setw(7) << phaseNames[phase] << std::right << std::setw(14)
+                      << toMicroseconds(stats.min) << std::setw(14) << toMicroseconds(stats.median)
+                      << std::setw(14) << toMicroseconds(stats.p99);
+            if (phase == static_cast<std::size_t>(Phase::total))
+            {
+                std::cout << std::setw(12) << result.throughputMBps;
+            }
+            std::cout << '\n';
+        }
+        if (!result.solved)
+        {
+            std::cout << "     warning: day " << unsigned(result.day) << " returned no solution\n";
+        }
+    }
+}
+
+[[nodiscard]] bool write_json(const std::string &path, const std::vector<DayResult> &results, const Settings &settings)
+{
+    std::ofstream ofs(path);
+    if (!ofs.is_open())
+    {
+        return false;
+    }
+    ofs << "{\n  \"repeat\": " << settings.repeat << ",\n  \"warmup\": " << settings.warmup << ",\n  \"days\": [";
+    for (std::size_t idx = 0u; idx < results.size(); ++idx)
+    {
+        const auto &result = results[idx];
+        ofs << ((idx == 0u) ? "\n" : ",\n") << "    {\"day\": " << unsigned(result.day)
+            << ", \"input_bytes\": " << result.inputBytes << ", \"solved\": " << (result.solved ? "true" : "false")
+            << ", \"throughput_mb_per_s\": " << result.throughputMBps;
+        for (std::size_t phase = 0u; phase < result.phases.size(); ++phase)
+        {
+            const auto &stats = result.phases[phase];
+            ofs << ", \"" << phaseNames[phase] << "\": {\"min_ns\": " << stats.min.count()
+                << ", \"median_ns\": " << stats.median.count() << ", \"p99_ns\": " << stats.p99.count() << '}';
+        }
+        ofs << '}';
+    }
+    ofs << "\n  ]\n}\n";
+    return ofs.good();
+}
+
+[[nodiscard]] bool parse_arguments(const int argc, const char *const argv[], Settings &settings)
+{
+    const auto parseCount = [](const char *const str, std::uint32_t &out) {
+        char *end = nullptr;
+        const auto value = std::strtoul(str, &end, 10);
+        if ((end == str) || (*end != '\0') || (value > 1'000'000ul))
+        {
+            return false;
+        }
+        out = static_cast<std::uint32_t>(value);
+        return true;
+    };
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        const std::string_view arg{argv[idx]};
+        const bool hasValue = (idx + 1) < argc;
+        if ((arg == "--input-dir") && hasValue)
+        {
+            settings.inputDirectory = argv[++idx];
+        }
+        else if ((arg == "--output") && hasValue)
+        {
+            settings.outputFile = argv[++idx];
+        }
+        else if ((arg == "--repeat") && hasValue)
+        {
+            if (!parseCount(argv[++idx], settings.repeat) || (settings.repeat == 0u))
+            {
+                return false;
+            }
+        }
+        else if ((arg == "--warmup") && hasValue)
+        {
+            if (!parseCount(argv[++idx], settings.warmup))
+            {
+                return false;
+            }
+        }
+        else if ((arg == "--day") && hasValue)
+        {
+            std::uint32_t day{};
+            if (!parseCount(argv[++idx], day) || (day < 1u) || (day > 25u))
+            {
+                return false;
+            }
+            settings.days.push_back(static_cast<std::uint8_t>(day));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (settings.days.empty())
+    {
+        for (std::uint8_t day = 1u; day <= 25u; ++day)
+        {
+            if (AOC::Y2022::PuzzleFactory::has_implementation_for_day(day))
+            {
+                settings.days.push_back(day);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(const int argc, const char *const argv[])
+{
+    std::cout << "==Advent of Code 2022 benchmark==\n";
+    Settings settings{};
+    if ((argv == nullptr) || !parse_arguments(argc, argv, settings))
+    {
+        const char *const executableName = ((argc > 0) && (argv != nullptr) && (argv[0u] != nullptr)) ? argv[0u] : "";
+        std::cout << "usage: " << executableName
+                  << " [--input-dir <dir>] [--day <day>]... [--repeat <n>] [--warmup <n>] [--output <file.json>]\n";
+        std::cout << "the input directory must contain one file per day, named like day01.txt\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<DayResult> results;
+    for (const auto day : settings.days)
+    {
+        std::ostringstream path;
+        path << settings.inputDirectory << "/day" << std::setw(2) << std::setfill('0') << unsigned(day) << ".txt";
+        const auto pInputSource = AOC::Y2022::InputSource::Open(path.str());
+        if ((pInputSource == nullptr) || pInputSource->view().empty())
+        {
+            std::cerr << "skipping day " << unsigned(day) << ": cannot read " << path.str() << '\n';
+            continue;
+        }
+        if (!AOC::Y2022::PuzzleFactory::has_implementation_for_day(day))
+        {
+            std::cerr << "skipping day " << unsigned(day) << ": no implementation\n";
+            continue;
+        }
+        results.push_back(benchmark_day(day, pInputSource->view(), settings));
+    }
+    if (results.empty())
+    {
+        std::cerr << "error: nothing to benchmark\n";
+        return EXIT_FAILURE;
+    }
+
+    print_table(results);
+    if (!write_json(settings.outputFile, results, settings))
+    {
+        std::cerr << "error: cannot write " << settings.outputFile << '\n';
+        return EXIT_FAILURE;
+    }
+    std::cout << "results written to " << settings.outputFile << '\n';
+    const bool allSolved = std::all_of(results.begin(), results.end(), [](const auto &result) { return result.solved; });
+    return allSolved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
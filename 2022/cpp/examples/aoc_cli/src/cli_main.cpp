@@ -1,88 +1,636 @@
 #include "aoc_y2022.hpp"
+#include "input_source.hpp"
+#include "probe.hpp"
+#include "solver_daemon.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
-#include <fstream>
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
-#include <streambuf>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 #include <variant>
+#include <vector>
 
-int main(const int argc, const char *const argv[])
+namespace
+{
+
+bool print_solution(const AOC::Y2022::IPuzzle::Solution_t &result, const bool bPart2)
 {
-    std::cout << "==Advent of Code 2022==\n";
-    if (argc < 3)
+    const bool emptyResult = std::holds_alternative<std::monostate>(result);
+    if (!emptyResult)
     {
-        const char *const executableName = ((argc > 0) && (argv != nullptr) && (argv[0u] != nullptr)) ? argv[0u] : "";
-        std::cout << "usage: " << executableName << " <day> <inputfile>\n";
-        std::cout << "example: " << executableName << " 1 input01.txt\n";
-        return (argc == 1) ? EXIT_SUCCESS : EXIT_FAILURE;
+        std::cout << "result of part " << (bPart2 ? 2 : 1) << ":\n";
+        if (std::holds_alternative<std::int64_t>(result))
+        {
+            std::cout << std::get<std::int64_t>(result) << '\n';
+            return true;
+        }
+        if (std::holds_alternative<std::string>(result))
+        {
+            std::cout << std::get<std::string>(result) << '\n';
+            return true;
+        }
     }
+    std::cerr << "sorry! failed to solve part " << (bPart2 ? 2 : 1) << '\n';
+    return false;
+}
 
-    const auto day = [&argv]() -> std::uint8_t {
-        if (argv == nullptr)
+/*!
+ * \brief Solves every input listed in the manifest with PuzzleFactory::SolveBatch.
+ *
+ * Each line of the manifest holds a day and the path of an input file, separated by whitespace.
+ * Empty lines and lines starting with # are ignored.
+ */
+[[nodiscard]] int run_manifest(const std::string &manifestPath, AOC::Y2022::ResultCache *const pCache)
+{
+    const auto pManifest = AOC::Y2022::InputSource::Open(manifestPath);
+    if (pManifest == nullptr)
+    {
+        std::cerr << "error: cannot open manifest file\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<std::string> paths;
+    std::vector<std::unique_ptr<AOC::Y2022::InputSource>> inputSources;
+    std::vector<AOC::Y2022::BatchJob> jobs;
+    const auto trim = [](std::string_view str) {
+        constexpr std::string_view whitespace{" \t\r"};
+        const auto first = str.find_first_not_of(whitespace);
+        if (first == std::string_view::npos)
         {
-            return 0;
+            return std::string_view{};
         }
-        const auto dayTmp = std::strtol(argv[1u], nullptr, 0);
-        if ((dayTmp < 1l) || (dayTmp > 25l))
+        return str.substr(first, str.find_last_not_of(whitespace) - first + 1u);
+    };
+    auto manifest = pManifest->view();
+    for (std::size_t lineNumber = 1u; !manifest.empty(); ++lineNumber)
+    {
+        const auto lineEnd = manifest.find('\n');
+        const auto line = trim(manifest.substr(0u, lineEnd));
+        manifest.remove_prefix((lineEnd == std::string_view::npos) ? manifest.size() : (lineEnd + 1u));
+        if (line.empty() || (line.front() == '#'))
         {
-            std::cerr << "error: please select a day from 1 and 24\n";
-            return 0;
+            continue;
         }
-        return static_cast<std::uint8_t>(dayTmp);
-    }();
-    if (day == 0u)
+        const auto separator = line.find_first_of(" \t");
+        const auto dayString = line.substr(0u, separator);
+        const auto path = trim(line.substr(std::min(separator, line.size())));
+        unsigned day{};
+        const auto [end, ec] = std::from_chars(dayString.data(), dayString.data() + dayString.size(), day, 10);
+        if ((ec != std::errc{}) || (end != (dayString.data() + dayString.size())) || (day < 1u) || (day > 25u) ||
+            path.empty())
+        {
+            std::cerr << "error: invalid manifest entry in line " << lineNumber << '\n';
+            return EXIT_FAILURE;
+        }
+        paths.emplace_back(path);
+        inputSources.push_back(AOC::Y2022::InputSource::Open(paths.back()));
+        if (inputSources.back() == nullptr)
+        {
+            std::cerr << "error: cannot open input file " << paths.back() << '\n';
+            return EXIT_FAILURE;
+        }
+        jobs.push_back({.day = static_cast<std::uint8_t>(day), .input = inputSources.back()->view()});
+    }
+
+    std::vector<AOC::Y2022::BatchResult> results(jobs.size());
+    if (pCache == nullptr)
     {
-        return EXIT_FAILURE;
+        results = AOC::Y2022::PuzzleFactory::SolveBatch(jobs);
+    }
+    else
+    {
+        // only the inputs missing from the cache are solved, and their solutions are stored afterwards
+        std::vector<std::size_t> missingJobs;
+        std::vector<AOC::Y2022::BatchJob> uncachedJobs;
+        for (std::size_t idx = 0u; idx < jobs.size(); ++idx)
+        {
+            if (!AOC::Y2022::PuzzleFactory::has_implementation_for_day(jobs[idx].day))
+            {
+                continue;
+            }
+            if (auto solutions = pCache->Lookup(jobs[idx].day, jobs[idx].input))
+            {
+                results[idx] = {.created = true, .solutions = std::move(*solutions)};
+                continue;
+            }
+            missingJobs.push_back(idx);
+            uncachedJobs.push_back(jobs[idx]);
+        }
+        auto solvedResults = AOC::Y2022::PuzzleFactory::SolveBatch(uncachedJobs);
+        for (std::size_t idx = 0u; idx < missingJobs.size(); ++idx)
+        {
+            const auto &job = uncachedJobs[idx];
+            pCache->Store(job.day, job.input, solvedResults[idx].solutions);
+            results[missingJobs[idx]] = std::move(solvedResults[idx]);
+        }
+    }
+    bool allSolved = true;
+    for (std::size_t idx = 0u; idx < results.size(); ++idx)
+    {
+        std::cout << "== day " << unsigned(jobs[idx].day) << ": " << paths[idx] << '\n';
+        if (!results[idx].created)
+        {
+            std::cerr << "sorry, no implementation for day " << unsigned(jobs[idx].day) << '\n';
+            allSolved = false;
+            continue;
+        }
+        const bool solved1 = print_solution(results[idx].solutions.part1, false);
+        const bool solved2 = print_solution(results[idx].solutions.part2, true);
+        allSolved = allSolved && solved1 && solved2;
+    }
+    return allSolved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void print_instrumentation(const AOC::Y2022::SolveReport &report)
+{
+    using Phase = AOC::Y2022::SolveReport::Phase;
+    std::cout << "instrumentation:\n";
+    std::cout << std::left << std::setw(7) << "phase" << std::right << std::setw(14) << "time [us]";
+    if (report.allocationsTracked)
+    {
+        std::cout << std::setw(13) << "allocations" << std::setw(16) << "bytes" << std::setw(16) << "peak bytes";
+    }
+    std::cout << '\n' << std::fixed << std::setprecision(1);
+    for (std::size_t phase = 0u; phase < static_cast<std::size_t>(Phase::max); ++phase)
+    {
+        const auto &metrics = report[static_cast<Phase>(phase)];
+        std::cout << std::left << std::setw(7) << AOC::Y2022::SolveReport::phaseNames[phase] << std::right
+                  << std::setw(14) << std::chrono::duration<double, std::micro>(metrics.duration).count();
+        if (report.allocationsTracked)
+        {
+            std::cout << std::setw(13) << metrics.allocations << std::setw(16) << metrics.bytesAllocated
+                      << std::setw(16) << metrics.peakBytes;
+        }
+        std::cout << '\n';
     }
+}
+
+[[nodiscard]] bool is_regular_file(const std::string &path)
+{
+    std::error_code error{};
+    return (path != AOC::Y2022::InputSource::stdinPath) && std::filesystem::is_regular_file(path, error);
+}
 
-    std::ifstream ifs(argv[2u]);
-    if (!ifs.is_open())
+/*! \brief Feeds the input chunk by chunk into a streaming puzzle, never holding the whole input in memory. */
+[[nodiscard]] int solve_streaming(const std::uint8_t day, const std::string &path)
+{
+    const auto pPuzzle = AOC::Y2022::PuzzleFactory::CreateStreamingPuzzle(day);
+    std::size_t inputSize = 0u;
+    const bool readSuccess = AOC::Y2022::InputSource::ReadChunks(path, [&pPuzzle, &inputSize](const auto chunk) {
+        inputSize += chunk.size();
+        return pPuzzle->Push(chunk);
+    });
+    if (!readSuccess)
     {
         std::cerr << "error: cannot open input file\n";
         return EXIT_FAILURE;
     }
-    const std::string input((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-    ifs.close();
-    if (input.empty())
+    if (inputSize == 0u)
     {
         std::cerr << "error: empty input\n";
         return EXIT_FAILURE;
     }
+    const auto solutions = pPuzzle->Finish();
+    const bool solved = print_solution(solutions.part1, false) && print_solution(solutions.part2, true);
+    return solved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
-    auto pPuzzle = AOC::Y2022::PuzzleFactory::CreatePuzzle(day, input);
-    if (pPuzzle == nullptr)
+void print_cache_statistics(const AOC::Y2022::ResultCache &cache)
+{
+    std::cout << "cache " << cache.directory().string() << ": " << cache.hits() << " hits, " << cache.misses()
+              << " misses, " << cache.evictions() << " evictions\n";
+}
+
+/*! \brief Removes a <flag>[=<path>] argument, the path defaults to defaultPath. */
+[[nodiscard]] std::optional<std::filesystem::path> take_path_argument(std::vector<std::string> &args,
+                                                                      const std::string_view flag,
+                                                                      const std::filesystem::path &defaultPath)
+{
+    const auto it = std::ranges::find_if(args, [flag](const std::string_view arg) {
+        return (arg == flag) || (arg.starts_with(flag) && (arg.size() > flag.size()) && (arg[flag.size()] == '='));
+    });
+    if (it == args.end())
     {
-        std::cerr << "sorry, no implementation for day " << unsigned(day) << '\n';
+        return std::nullopt;
+    }
+    auto path = (it->size() > flag.size()) ? std::filesystem::path{it->substr(flag.size() + 1u)} : defaultPath;
+    args.erase(it);
+    return path;
+}
+
+/*! \brief Returns name in the temporary directory. */
+[[nodiscard]] std::filesystem::path temporary_path(const std::string_view name)
+{
+    std::error_code error{};
+    return std::filesystem::temp_directory_path(error) / name;
+}
+
+/*!
+ * \brief Returns aoc-2022 in the cache directory of the user, or an empty path if there is none.
+ *
+ * A directory which other users can write to is never chosen: they could plant entries answering the inputs of the
+ * user with forged solutions.
+ */
+[[nodiscard]] std::filesystem::path user_cache_directory()
+{
+    constexpr std::pair<const char *, const char *> locations[]{
+        {"XDG_CACHE_HOME", ""}, {"HOME", ".cache"}, {"LOCALAPPDATA", ""}};
+    for (const auto &[variable, subdirectory] : locations)
+    {
+        const char *const pValue = std::getenv(variable);
+        if ((pValue != nullptr) && std::filesystem::path{pValue}.is_absolute())
+        {
+            return std::filesystem::path{pValue} / subdirectory / "aoc-2022";
+        }
+    }
+    return {};
+}
+
+/*! \brief Removes a flag without a value, returns whether it was given. */
+[[nodiscard]] bool take_flag(std::vector<std::string> &args, const std::string_view flag)
+{
+    return std::erase(args, flag) != 0u;
+}
+
+/*! \brief Removes a --cache[=<directory>] argument and creates the result cache it asks for. */
+[[nodiscard]] std::optional<AOC::Y2022::ResultCache> take_cache_argument(std::vector<std::string> &args)
+{
+    auto directory = take_path_argument(args, "--cache", user_cache_directory());
+    if (!directory.has_value())
+    {
+        return std::nullopt;
+    }
+    if (directory->empty())
+    {
+        std::cerr << "warning: no cache directory of the user is known, solving without cache\n";
+        return std::nullopt;
+    }
+    return std::optional<AOC::Y2022::ResultCache>{std::in_place, std::move(*directory)};
+}
+
+/*! \brief Solves the requests of clients until one of them asks for the shutdown. */
+[[nodiscard]] int run_server(const std::filesystem::path &socketPath, AOC::Y2022::ResultCache *const pCache)
+{
+    const auto pServer = AOC::Y2022::SolverServer::Listen(socketPath, pCache);
+    if (pServer == nullptr)
+    {
+        std::cerr << "error: cannot listen on " << socketPath.string() << ", is another server running?\n";
         return EXIT_FAILURE;
     }
+    std::cout << "listening on " << socketPath.string() << std::endl;
+    const bool success = pServer->Run();
+    std::cout << "served " << pServer->requests_served() << " requests\n";
+    if (pCache != nullptr)
+    {
+        print_cache_statistics(*pCache);
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
 
-    const auto solvePart = [](const auto &result, bool bPart2) -> bool {
-        const bool emptyResult = std::holds_alternative<std::monostate>(result);
-        if (!emptyResult)
+/*!
+ * \brief Lets a running server solve the input, or asks it to shut down if there is no day.
+ *
+ * Files are only named to the server, which maps them itself. stdin, and every input if sendInline is set, is sent
+ * along instead.
+ */
+[[nodiscard]] int run_client(const std::filesystem::path &socketPath, const std::uint8_t day, const std::string &path,
+                             const bool sendInline)
+{
+    AOC::Y2022::SolverRequest request{.kind = AOC::Y2022::SolverRequest::Kind::shutdown};
+    if (day != 0u)
+    {
+        request.day = day;
+        if (sendInline || !is_regular_file(path))
         {
-            std::cout << "result of part " << (bPart2 ? 2 : 1) << ":\n";
-            if (std::holds_alternative<std::int64_t>(result))
+            const auto pInputSource = AOC::Y2022::InputSource::Open(path);
+            if (pInputSource == nullptr)
             {
-                std::cout << std::get<std::int64_t>(result) << '\n';
-                return true;
+                std::cerr << "error: cannot open input file\n";
+                return EXIT_FAILURE;
             }
-            if (std::holds_alternative<std::string>(result))
+            request.kind = AOC::Y2022::SolverRequest::Kind::payload;
+            request.data = pInputSource->view();
+        }
+        else
+        {
+            std::error_code error{};
+            request.kind = AOC::Y2022::SolverRequest::Kind::path;
+            request.data = std::filesystem::absolute(path, error).string();
+        }
+    }
+
+    using Kind = AOC::Y2022::SolverEvent::Kind;
+    bool solved = true;
+    bool failed = false;
+    const auto microseconds = [](const std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    const bool answered = AOC::Y2022::SolverClient::Send(socketPath, request, [&](const auto &event) {
+        switch (event.kind)
+        {
+        case Kind::read:
+            std::cout << std::fixed << std::setprecision(1) << "server read the input in "
+                      << microseconds(event.duration) << " us\n";
+            break;
+        case Kind::parse:
+            std::cout << "server parsed the input in " << microseconds(event.duration) << " us\n";
+            break;
+        case Kind::part1:
+        case Kind::part2:
+            solved = print_solution(event.solution, event.kind == Kind::part2) && solved;
+            std::cout << "server solved it in " << microseconds(event.duration) << " us\n";
+            break;
+        case Kind::done:
+            if (day != 0u)
             {
-                std::cout << std::get<std::string>(result) << '\n';
-                return true;
+                std::cout << "server answered in " << microseconds(event.duration) << " us\n";
             }
+            break;
+        case Kind::error:
+            std::cerr << "error: " << event.message << '\n';
+            failed = true;
+            break;
         }
-        std::cerr << "sorry! failed to solve part " << (bPart2 ? 2 : 1) << '\n';
-        return false;
-    };
-    if (solvePart(pPuzzle->Part1(), false) && solvePart(pPuzzle->Part2(), true))
+    });
+    if (!answered)
     {
-        return EXIT_SUCCESS;
+        std::cerr << "error: no answer from a server on " << socketPath.string() << '\n';
+        return EXIT_FAILURE;
     }
-    else
+    return (solved && !failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*! \brief Removes a <flag>=<value> or <flag> <value> argument, the value is empty if it is missing. */
+[[nodiscard]] std::optional<std::string> take_value_argument(std::vector<std::string> &args,
+                                                             const std::string_view flag)
+{
+    const auto it = std::ranges::find_if(args, [flag](const std::string_view arg) {
+        return (arg == flag) || (arg.starts_with(flag) && (arg.size() > flag.size()) && (arg[flag.size()] == '='));
+    });
+    if (it == args.end())
     {
+        return std::nullopt;
+    }
+    if (it->size() > flag.size())
+    {
+        auto value = it->substr(flag.size() + 1u);
+        args.erase(it);
+        return value;
+    }
+    const auto valueEnd = (std::next(it) == args.end()) ? std::next(it) : std::next(it, 2);
+    auto value = (std::next(it) == args.end()) ? std::string{} : *std::next(it);
+    args.erase(it, valueEnd);
+    return value;
+}
+
+/*! \brief Parses a decimal number, leading zeros do not select octal. */
+template <typename T> [[nodiscard]] bool parse_decimal(const std::string_view str, T &value)
+{
+    const auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value, 10);
+    return !str.empty() && (ec == std::errc{}) && (end == (str.data() + str.size()));
+}
+
+/*! \return the day, or 0 if it is not a number from 1 to 25 */
+[[nodiscard]] std::uint8_t parse_day(const std::string_view str)
+{
+    unsigned day{};
+    if (!parse_decimal(str, day) || (day < 1u) || (day > 25u))
+    {
+        std::cerr << "error: please select a day from 1 to 25\n";
+        return 0u;
+    }
+    return static_cast<std::uint8_t>(day);
+}
+
+/*!
+ * \brief Solves each input repeatedly and reports the distribution of the phase timings, see probe().
+ *
+ * Inputs whose day has no implementation or which cannot be read are reported as unsolved.
+ */
+[[nodiscard]] int run_probe(const std::vector<std::pair<std::uint8_t, std::string>> &inputs, const bool json,
+                            const AOC::Y2022::ProbeOptions &options)
+{
+    std::vector<AOC::Y2022::ProbeResult> results;
+    bool allSolved = true;
+    for (const auto &[day, path] : inputs)
+    {
+        results.push_back(AOC::Y2022::probe(day, path, options));
+        const auto &result = results.back();
+        if (!result.error.empty())
+        {
+            std::cerr << "error: day " << unsigned(day) << ": " << result.error << '\n';
+        }
+        if (!json)
+        {
+            print_probe_text(std::cout, result, options);
+        }
+        allSolved = allSolved && result.solved();
+    }
+    if (json)
+    {
+        print_probe_json(std::cout, results, options);
+    }
+    return allSolved ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*! \brief Lists the input dayNN.txt of every implemented day which has one in the directory. */
+[[nodiscard]] std::vector<std::pair<std::uint8_t, std::string>> find_inputs(const std::filesystem::path &directory)
+{
+    std::vector<std::pair<std::uint8_t, std::string>> inputs;
+    for (std::uint8_t day = 1u; day <= 25u; ++day)
+    {
+        if (!AOC::Y2022::PuzzleFactory::has_implementation_for_day(day))
+        {
+            continue;
+        }
+        const auto fileName = std::string{"day"} + ((day < 10u) ? "0" : "") + std::to_string(day) + ".txt";
+        const auto path = (directory / fileName).string();
+        if (!is_regular_file(path))
+        {
+            std::cerr << "skipping day " << unsigned(day) << ": no input " << path << '\n';
+            continue;
+        }
+        inputs.emplace_back(day, path);
+    }
+    return inputs;
+}
+
+} // namespace
+
+int main(const int argc, const char *const argv[])
+{
+    std::vector<std::string> args;
+    for (int idx = 0; (argv != nullptr) && (idx < argc); ++idx)
+    {
+        args.emplace_back((argv[idx] != nullptr) ? argv[idx] : "");
+    }
+    // stdout carries nothing but the document in JSON format
+    const auto format = take_value_argument(args, "--format");
+    const bool json = format.has_value() && (*format == "json");
+    if (!json)
+    {
+        std::cout << "==Advent of Code 2022==\n";
+    }
+    const auto repeat = take_value_argument(args, "--repeat");
+    const auto warmup = take_value_argument(args, "--warmup");
+    const auto allDirectory = take_value_argument(args, "--all");
+    const auto timing = take_value_argument(args, "--timing");
+    AOC::Y2022::ProbeOptions probeOptions{};
+    const auto timingName = std::ranges::find(AOC::Y2022::probeTimingNames, timing.value_or("concurrent"));
+    probeOptions.timing = static_cast<AOC::Y2022::ProbeTiming>(
+        std::distance(AOC::Y2022::probeTimingNames.begin(), timingName));
+    const bool validProbeOptions =
+        (!format.has_value() || json || (*format == "text")) &&
+        (!repeat.has_value() || (parse_decimal(*repeat, probeOptions.repeat) && (probeOptions.repeat > 0u))) &&
+        (!warmup.has_value() || parse_decimal(*warmup, probeOptions.warmup)) &&
+        (!allDirectory.has_value() || !allDirectory->empty()) &&
+        (timingName != AOC::Y2022::probeTimingNames.end());
+    const bool probeMode = format.has_value() || repeat.has_value() || warmup.has_value() || allDirectory.has_value() ||
+                           timing.has_value();
+    auto cache = take_cache_argument(args);
+    auto *const pCache = cache.has_value() ? &*cache : nullptr;
+    const auto serverSocket = take_path_argument(args, "--serve", temporary_path("aoc-2022.sock"));
+    const auto clientSocket = take_path_argument(args, "--client", temporary_path("aoc-2022.sock"));
+    const bool sendInline = take_flag(args, "--inline");
+    const bool shutdown = take_flag(args, "--shutdown");
+    const auto argCount = args.size();
+
+    if (probeMode && validProbeOptions && (pCache == nullptr) && !serverSocket.has_value() &&
+        !clientSocket.has_value() && !sendInline && !shutdown)
+    {
+        if (allDirectory.has_value() && (argCount == 1u))
+        {
+            return run_probe(find_inputs(*allDirectory), json, probeOptions);
+        }
+        if (!allDirectory.has_value() && (argCount == 3u))
+        {
+            const auto day = parse_day(args[1u]);
+            return (day != 0u) ? run_probe({{day, args[2u]}}, json, probeOptions) : EXIT_FAILURE;
+        }
+    }
+    if (serverSocket.has_value() && !clientSocket.has_value() && (argCount == 1u))
+    {
+        return run_server(*serverSocket, pCache);
+    }
+    if (clientSocket.has_value() && shutdown && (argCount == 1u))
+    {
+        return run_client(*clientSocket, 0u, {}, false);
+    }
+    if ((argCount == 3u) && (args[1u] == "--manifest"))
+    {
+        const auto result = run_manifest(args[2u], pCache);
+        if (pCache != nullptr)
+        {
+            print_cache_statistics(*pCache);
+        }
+        return result;
+    }
+    const bool instrument = (argCount == 4u) && (args[3u] == "--instrument");
+    if ((argCount < 3u) || ((argCount > 3u) && !instrument) || probeMode || serverSocket.has_value() || shutdown ||
+        (clientSocket.has_value() && instrument) || (sendInline && !clientSocket.has_value()))
+    {
+        const auto &executableName = args.empty() ? std::string{} : args[0u];
+        std::cout << "usage: " << executableName << " <day> <inputfile> [--instrument] [--cache[=<directory>]]\n";
+        std::cout << "       " << executableName << " --manifest <manifestfile> [--cache[=<directory>]]\n";
+        std::cout << "       " << executableName << " --serve[=<socket>] [--cache[=<directory>]]\n";
+        std::cout << "       " << executableName << " --client[=<socket>] <day> <inputfile> [--inline]\n";
+        std::cout << "       " << executableName << " --client[=<socket>] --shutdown\n";
+        std::cout << "       " << executableName
+                  << " <day> <inputfile> [--format=text|json] [--repeat <n>] [--warmup <n>]"
+                  << " [--timing=concurrent|instrumented]\n";
+        std::cout << "       " << executableName << " --all <inputdirectory> [--format=text|json] [--repeat <n>]"
+                  << " [--warmup <n>] [--timing=concurrent|instrumented]\n";
+        std::cout << "example: " << executableName << " 1 input01.txt\n";
+        std::cout << "use - as inputfile to read the input from stdin\n";
+        std::cout << "--instrument prints time, allocations and peak heap usage of parsing, part 1 and part 2\n";
+        std::cout << "--cache reuses the solutions of inputs solved before, stored in the directory or in\n"
+                  << "        aoc-2022 in $XDG_CACHE_HOME, ~/.cache or %LOCALAPPDATA%\n";
+        std::cout << "a manifest lists one input per line as <day> <inputfile>, all inputs are solved in parallel\n";
+        std::cout << "--serve keeps solving the inputs sent by --client until it is shut down, the socket defaults\n"
+                  << "        to aoc-2022.sock in the temporary directory\n";
+        std::cout << "--inline sends the input to the server instead of letting it read the file\n";
+        std::cout << "--repeat solves the input n times and prints min, median, p90, max, mean and standard deviation\n"
+                  << "        of the time of every phase, after solving it --warmup times without measuring\n";
+        std::cout << "--timing=concurrent measures parsing and solving as without --repeat, in parallel where the\n"
+                  << "        input allows it; --timing=instrumented measures the runs of --instrument, which parse\n"
+                  << "        on one thread and solve the parts one after the other\n";
+        std::cout << "--format=json prints the solutions and the statistics as a single JSON document\n";
+        std::cout << "--all solves the input dayNN.txt of every implemented day found in the directory\n";
+        return (argc == 1) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const auto day = parse_day(args[1u]);
+    if (day == 0u)
+    {
+        return EXIT_FAILURE;
+    }
+    if (clientSocket.has_value())
+    {
+        return run_client(*clientSocket, day, args[2u], sendInline);
+    }
+
+    // pipes cannot be mapped, so they are streamed into the puzzle instead of being buffered as a whole
+    // the cache needs the whole input to hash it
+    if (!instrument && (pCache == nullptr) && AOC::Y2022::PuzzleFactory::has_streaming_implementation_for_day(day) &&
+        !is_regular_file(args[2u]))
+    {
+        return solve_streaming(day, args[2u]);
+    }
+
+    // the input is mapped instead of copied where possible, it has to outlive the puzzle
+    const auto pInputSource = AOC::Y2022::InputSource::Open(args[2u]);
+    if (pInputSource == nullptr)
+    {
+        std::cerr << "error: cannot open input file\n";
+        return EXIT_FAILURE;
+    }
+    const auto input = pInputSource->view();
+    if (input.empty())
+    {
+        std::cerr << "error: empty input\n";
+        return EXIT_FAILURE;
+    }
+
+    const AOC::Y2022::PuzzleOptions options{.inputLifetime = AOC::Y2022::InputLifetime::borrowed};
+    AOC::Y2022::SolveReport report{};
+    if (instrument)
+    {
+        report = AOC::Y2022::PuzzleFactory::SolveInstrumented(day, input, options);
+    }
+    else if (auto pPuzzle = (pCache != nullptr) ? pCache->CreatePuzzle(day, input, options)
+                                                : AOC::Y2022::PuzzleFactory::CreatePuzzle(day, input, options);
+             pPuzzle != nullptr)
+    {
+        auto solutions = AOC::Y2022::PuzzleFactory::SolveConcurrently(*pPuzzle);
+        report.created = true;
+        report.part1 = std::move(solutions.part1);
+        report.part2 = std::move(solutions.part2);
+    }
+    if (!report.created)
+    {
+        std::cerr << "sorry, no implementation for day " << unsigned(day) << '\n';
         return EXIT_FAILURE;
     }
+
+    const bool solved = print_solution(report.part1, false) && print_solution(report.part2, true);
+    if (instrument)
+    {
+        print_instrumentation(report);
+    }
+    if (pCache != nullptr)
+    {
+        print_cache_statistics(*pCache);
+    }
+    return solved ? EXIT_SUCCESS : EXIT_FAILURE;
 }
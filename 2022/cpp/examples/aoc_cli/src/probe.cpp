@@ -0,0 +1,278 @@
+#include "probe.hpp"
+#include "input_source.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+using PhaseDurations = std::array<std::chrono::nanoseconds, static_cast<std::size_t>(SolveReport::Phase::max)>;
+
+/*! \brief Forwards to a puzzle and measures how long each part takes on the thread solving it. */
+class TimedPuzzle final : public IPuzzle
+{
+  public:
+    explicit TimedPuzzle(IPuzzle &puzzle) : puzzle(puzzle) {}
+
+    [[nodiscard]] Solution_t Part1() override { return timed(&IPuzzle::Part1, part1Duration); }
+    [[nodiscard]] Solution_t Part2() override { return timed(&IPuzzle::Part2, part2Duration); }
+    [[nodiscard]] bool PartsAreIndependent() const override { return puzzle.PartsAreIndependent(); }
+
+    std::chrono::nanoseconds part1Duration{};
+    std::chrono::nanoseconds part2Duration{};
+
+  private:
+    [[nodiscard]] Solution_t timed(Solution_t (IPuzzle::*const fnPart)(), std::chrono::nanoseconds &duration)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto solution = (puzzle.*fnPart)();
+        duration = std::chrono::steady_clock::now() - start;
+        return solution;
+    }
+
+    IPuzzle &puzzle;
+};
+
+/*!
+ * \brief Solves the input like the CLI does and returns the durations of the phases.
+ * \return false if there is no implementation for the day
+ */
+[[nodiscard]] bool run_concurrently(const std::uint8_t day, const std::string_view input, const PuzzleOptions &options,
+                                    PhaseDurations &durations)
+{
+    using Phase = SolveReport::Phase;
+    const auto start = std::chrono::steady_clock::now();
+    const auto pPuzzle = PuzzleFactory::CreatePuzzle(day, input, options);
+    durations[static_cast<std::size_t>(Phase::parse)] = std::chrono::steady_clock::now() - start;
+    if (pPuzzle == nullptr)
+    {
+        return false;
+    }
+    TimedPuzzle timedPuzzle{*pPuzzle};
+    static_cast<void>(PuzzleFactory::SolveConcurrently(timedPuzzle, options.scheduler));
+    durations[static_cast<std::size_t>(Phase::part1)] = timedPuzzle.part1Duration;
+    durations[static_cast<std::size_t>(Phase::part2)] = timedPuzzle.part2Duration;
+    return true;
+}
+
+void print_json_string(std::ostream &out, const std::string_view str)
+{
+    constexpr std::string_view hexDigits{"0123456789abcdef"};
+    out << '"';
+    for (const auto c : str)
+    {
+        const auto code = static_cast<unsigned char>(c);
+        if ((c == '"') || (c == '\\'))
+        {
+            out << '\\' << c;
+        }
+        else if (c == '\n')
+        {
+            out << "\\n";
+        }
+        else if (code < 0x20u)
+        {
+            out << "\\u00" << hexDigits[code >> 4u] << hexDigits[code & 0xfu];
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+void print_json_solution(std::ostream &out, const IPuzzle::Solution_t &solution)
+{
+    if (const auto *const pNumber = std::get_if<std::int64_t>(&solution))
+    {
+        out << *pNumber;
+    }
+    else if (const auto *const pText = std::get_if<std::string>(&solution))
+    {
+        print_json_string(out, *pText);
+    }
+    else
+    {
+        out << "null";
+    }
+}
+
+} // namespace
+
+bool ProbeResult::solved() const noexcept
+{
+    return error.empty() && !std::holds_alternative<std::monostate>(report.part1) &&
+           !std::holds_alternative<std::monostate>(report.part2);
+}
+
+ProbeResult probe(const std::uint8_t day, const std::string &inputPath, const ProbeOptions &options)
+{
+    ProbeResult result{.day = day, .inputPath = inputPath};
+    const auto pInputSource = InputSource::Open(inputPath);
+    if (pInputSource == nullptr)
+    {
+        result.error = "cannot open input file";
+        return result;
+    }
+    const auto input = pInputSource->view();
+    if (input.empty())
+    {
+        result.error = "empty input";
+        return result;
+    }
+
+    const PuzzleOptions puzzleOptions{.inputLifetime = InputLifetime::borrowed};
+    constexpr auto phaseCount = static_cast<std::size_t>(SolveReport::Phase::max);
+    std::array<std::vector<std::chrono::nanoseconds>, phaseCount> durations{};
+    const bool instrumented = (options.timing == ProbeTiming::instrumented);
+    for (std::size_t run = 0u; run < (options.warmup + options.repeat); ++run)
+    {
+        PhaseDurations runDurations{};
+        bool created = false;
+        if (instrumented)
+        {
+            result.report = PuzzleFactory::SolveInstrumented(day, input, puzzleOptions);
+            created = result.report.created;
+            for (std::size_t phase = 0u; phase < phaseCount; ++phase)
+            {
+                runDurations[phase] = result.report.phases[phase].duration;
+            }
+        }
+        else
+        {
+            created = run_concurrently(day, input, puzzleOptions, runDurations);
+        }
+        if (!created)
+        {
+            result.error = "no implementation for day " + std::to_string(day);
+            return result;
+        }
+        for (std::size_t phase = 0u; (run >= options.warmup) && (phase < phaseCount); ++phase)
+        {
+            durations[phase].push_back(runDurations[phase]);
+        }
+    }
+    if (!instrumented)
+    {
+        result.report = PuzzleFactory::SolveInstrumented(day, input, puzzleOptions);
+    }
+    for (std::size_t phase = 0u; phase < phaseCount; ++phase)
+    {
+        result.statistics[phase] = compute_statistics(std::move(durations[phase]));
+    }
+    return result;
+}
+
+void print_probe_text(std::ostream &out, const ProbeResult &result, const ProbeOptions &options)
+{
+    out << "== day " << unsigned(result.day) << ": " << result.inputPath << '\n';
+    if (!result.error.empty())
+    {
+        return;
+    }
+    for (const auto &[solution, part] : {std::pair{&result.report.part1, 1}, std::pair{&result.report.part2, 2}})
+    {
+        if (const auto *const pNumber = std::get_if<std::int64_t>(solution))
+        {
+            out << "result of part " << part << ":\n" << *pNumber << '\n';
+        }
+        else if (const auto *const pText = std::get_if<std::string>(solution))
+        {
+            out << "result of part " << part << ":\n" << *pText << '\n';
+        }
+        else
+        {
+            std::cerr << "sorry! failed to solve part " << part << '\n';
+        }
+    }
+
+    using Phase = SolveReport::Phase;
+    out << "timing of " << options.repeat << " runs after " << options.warmup << " warmup runs"
+        << ((options.timing == ProbeTiming::instrumented)
+                ? " (instrumented: parsed on this thread, one part after the other)"
+                : " (concurrent: parsed and solved like without --repeat)")
+        << ":\n";
+    out << std::left << std::setw(7) << "phase" << std::right;
+    for (const auto *const column : {"min [us]", "median [us]", "p90 [us]", "max [us]", "mean [us]", "stddev [us]"})
+    {
+        out << std::setw(13) << column;
+    }
+    if (result.report.allocationsTracked)
+    {
+        out << std::setw(13) << "allocations" << std::setw(16) << "peak bytes";
+    }
+    out << '\n' << std::fixed << std::setprecision(1);
+    const auto microseconds = [](const std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+    for (std::size_t phase = 0u; phase < static_cast<std::size_t>(Phase::max); ++phase)
+    {
+        const auto &statistics = result[static_cast<Phase>(phase)];
+        out << std::left << std::setw(7) << SolveReport::phaseNames[phase] << std::right;
+        for (const auto duration : {statistics.min, statistics.median, statistics.p90, statistics.max,
+                                    statistics.mean, statistics.stddev})
+        {
+            out << std::setw(13) << microseconds(duration);
+        }
+        if (result.report.allocationsTracked)
+        {
+            const auto &metrics = result.report[static_cast<Phase>(phase)];
+            out << std::setw(13) << metrics.allocations << std::setw(16) << metrics.peakBytes;
+        }
+        out << '\n';
+    }
+}
+
+void print_probe_json(std::ostream &out, const std::span<const ProbeResult> results, const ProbeOptions &options)
+{
+    out << R"({"timing": ")" << probeTimingNames[static_cast<std::size_t>(options.timing)] << R"(", "warmup": )"
+        << options.warmup << R"(, "repeat": )" << options.repeat << R"(, "results": [)";
+    for (std::size_t idx = 0u; idx < results.size(); ++idx)
+    {
+        const auto &result = results[idx];
+        out << ((idx == 0u) ? "" : ", ") << R"({"day": )" << unsigned(result.day) << R"(, "input": )";
+        print_json_string(out, result.inputPath);
+        out << R"(, "solved": )" << (result.solved() ? "true" : "false");
+        if (!result.error.empty())
+        {
+            out << R"(, "error": )";
+            print_json_string(out, result.error);
+            out << '}';
+            continue;
+        }
+        out << R"(, "part1": )";
+        print_json_solution(out, result.report.part1);
+        out << R"(, "part2": )";
+        print_json_solution(out, result.report.part2);
+        out << R"(, "phases": {)";
+        for (std::size_t phase = 0u; phase < static_cast<std::size_t>(SolveReport::Phase::max); ++phase)
+        {
+            const auto &statistics = result.statistics[phase];
+            out << ((phase == 0u) ? "" : ", ") << '"' << SolveReport::phaseNames[phase] << R"(": {)"
+                << R"("min_ns": )" << statistics.min.count() << R"(, "median_ns": )" << statistics.median.count()
+                << R"(, "p90_ns": )" << statistics.p90.count() << R"(, "max_ns": )" << statistics.max.count()
+                << R"(, "mean_ns": )" << statistics.mean.count() << R"(, "stddev_ns": )"
+                << statistics.stddev.count();
+            if (result.report.allocationsTracked)
+            {
+                const auto &metrics = result.report.phases[phase];
+                out << R"(, "allocations": )" << metrics.allocations << R"(, "bytes": )" << metrics.bytesAllocated
+                    << R"(, "peak_bytes": )" << metrics.peakBytes;
+            }
+            out << '}';
+        }
+        out << "}}";
+    }
+    out << "]}\n";
+}
+
+} // namespace AOC::Y2022
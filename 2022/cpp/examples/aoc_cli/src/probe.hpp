@@ -0,0 +1,82 @@
+#if !defined(AOC_Y2022_PROBE_HPP)
+#define AOC_Y2022_PROBE_HPP (1)
+
+#include "aoc_y2022.hpp"
+#include "duration_statistics.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*! \brief Which way of solving the runs of probe() measure. */
+enum class ProbeTiming : std::uint8_t
+{
+    concurrent,   //!< like the CLI: CreatePuzzle, parsing in parallel if the input is large, and SolveConcurrently
+    instrumented, //!< PuzzleFactory::SolveInstrumented: parsing on the calling thread, one part after the other
+    max,
+};
+constexpr std::array<std::string_view, static_cast<std::size_t>(ProbeTiming::max)> probeTimingNames{
+    "concurrent", "instrumented",
+};
+
+/*! \brief How often and in which way an input is solved by probe(). */
+struct ProbeOptions final
+{
+    std::size_t warmup{};   //!< runs in front of the measured ones, which are not reported
+    std::size_t repeat{1u}; //!< measured runs
+    ProbeTiming timing{ProbeTiming::concurrent};
+};
+
+struct ProbeResult final
+{
+    std::uint8_t day{};
+    std::string inputPath{};
+    std::string error{};  //!< why the input was not solved, empty on success
+    //! an instrumented run giving the solutions and the allocations, the last measured one if those are instrumented
+    SolveReport report{};
+    //! distribution of the durations of every phase over the measured runs
+    std::array<DurationStatistics, static_cast<std::size_t>(SolveReport::Phase::max)> statistics{};
+
+    [[nodiscard]] const DurationStatistics &operator[](const SolveReport::Phase phase) const
+    {
+        return statistics[static_cast<std::size_t>(phase)];
+    }
+    /*! \brief True if the input was solved and both parts have a solution. */
+    [[nodiscard]] bool solved() const noexcept;
+};
+
+/*!
+ * \brief Creates the puzzle of the input and solves both parts again and again, measuring every phase.
+ *
+ * The input is read once and shared by all runs. Concurrent runs time each part on the thread solving it, and are
+ * followed by one run of PuzzleFactory::SolveInstrumented for the allocation counters.
+ */
+[[nodiscard]] ProbeResult probe(std::uint8_t day, const std::string &inputPath, const ProbeOptions &options);
+
+/*! \brief Prints the solutions and the statistics in the format of the other human readable output. */
+void print_probe_text(std::ostream &out, const ProbeResult &result, const ProbeOptions &options);
+
+/*!
+ * \brief Prints all results as a single JSON document.
+ *
+ * \verbatim
+{"timing": "concurrent|instrumented", "warmup": <n>, "repeat": <n>,
+ "results": [{"day": 1, "input": "<path>", "solved": true,
+  "part1": <number|string|null>, "part2": <number|string|null>, "error": "<message>" (only on failure),
+  "phases": {"parse": {"min_ns": <n>, "median_ns": <n>, "p90_ns": <n>, "max_ns": <n>, "mean_ns": <n>,
+                       "stddev_ns": <n>, "allocations": <n>, "bytes": <n>, "peak_bytes": <n>}, "part1": ..., "part2": ...}}]}
+\endverbatim
+ * The allocation counters of the instrumented run are only present if the allocation hooks are linked.
+ */
+void print_probe_json(std::ostream &out, std::span<const ProbeResult> results, const ProbeOptions &options);
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_PROBE_HPP)
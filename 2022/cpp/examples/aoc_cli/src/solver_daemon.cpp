@@ -0,0 +1,580 @@
+#include "solver_daemon.hpp"
+#include "input_source.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define AOC_Y2022_SOLVER_DAEMON_POSIX (1)
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+constexpr std::string_view protocolLine{"aoc-y2022-daemon 1"};
+/*! \brief Longest line of the protocol, anything longer is not a request of a client. */
+constexpr std::size_t maxLineLength = 256u;
+
+[[nodiscard]] std::vector<std::string_view> split_words(std::string_view line)
+{
+    std::vector<std::string_view> words;
+    while (!line.empty())
+    {
+        const auto separator = std::min(line.find(' '), line.size());
+        words.push_back(line.substr(0u, separator));
+        line.remove_prefix(std::min(separator + 1u, line.size()));
+    }
+    return words;
+}
+
+template <typename T> [[nodiscard]] bool parse_word(const std::string_view word, T &value)
+{
+    const auto [end, ec] = std::from_chars(word.data(), word.data() + word.size(), value, 10);
+    return (ec == std::errc{}) && (end == (word.data() + word.size())) && !word.empty();
+}
+
+[[nodiscard]] std::string encode_part(const int part, const std::chrono::nanoseconds duration,
+                                      const IPuzzle::Solution_t &solution)
+{
+    auto encoded = "part " + std::to_string(part) + ' ' + std::to_string(duration.count());
+    if (const auto *const pNumber = std::get_if<std::int64_t>(&solution))
+    {
+        return encoded + " number " + std::to_string(*pNumber) + '\n';
+    }
+    if (const auto *const pText = std::get_if<std::string>(&solution))
+    {
+        return encoded + " text " + std::to_string(pText->size()) + '\n' + *pText + '\n';
+    }
+    return encoded + " none\n";
+}
+
+} // namespace
+
+#if defined(AOC_Y2022_SOLVER_DAEMON_POSIX)
+
+/*! \brief Buffered reads and complete writes on a connected socket, which is closed on destruction. */
+class Connection final
+{
+  public:
+    explicit Connection(const int fd) : fd(fd) {}
+    ~Connection()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+    }
+    Connection(const Connection &) = delete;
+    Connection(Connection &&) = delete;
+    Connection &operator=(const Connection &) = delete;
+    Connection &operator=(Connection &&) = delete;
+
+    [[nodiscard]] bool write(std::string_view data) const
+    {
+#if defined(MSG_NOSIGNAL)
+        // a client which hung up must not terminate the server through SIGPIPE
+        constexpr int flags = MSG_NOSIGNAL;
+#else
+        constexpr int flags = 0;
+#endif
+        while (!data.empty())
+        {
+            const auto written = ::send(fd, data.data(), data.size(), flags);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            data.remove_prefix(static_cast<std::size_t>(written));
+        }
+        return true;
+    }
+
+    /*! \brief Reads up to the next line feed, which is not part of the line. */
+    [[nodiscard]] bool read_line(std::string &line)
+    {
+        while (true)
+        {
+            const auto lf = buffer.find('\n', consumed);
+            if (lf != std::string::npos)
+            {
+                line.assign(buffer, consumed, lf - consumed);
+                consumed = lf + 1u;
+                return true;
+            }
+            if (((buffer.size() - consumed) > maxLineLength) || !fill())
+            {
+                return false;
+            }
+        }
+    }
+
+    [[nodiscard]] bool read_bytes(const std::size_t count, std::string &bytes)
+    {
+        while ((buffer.size() - consumed) < count)
+        {
+            if (!fill())
+            {
+                return false;
+            }
+        }
+        bytes.assign(buffer, consumed, count);
+        consumed += count;
+        return true;
+    }
+
+    [[nodiscard]] int get() const noexcept { return fd; }
+
+    /*! \brief Makes all further reads fail once the deadline has passed, however slowly the data trickles in. */
+    void set_deadline(const std::chrono::steady_clock::time_point until) noexcept { deadline = until; }
+
+  private:
+    [[nodiscard]] bool wait_until_readable() const
+    {
+        if (deadline == std::chrono::steady_clock::time_point::max())
+        {
+            return true;
+        }
+        while (true)
+        {
+            const auto remaining =
+                std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+            {
+                return false;
+            }
+            pollfd readable{.fd = fd, .events = POLLIN, .revents = 0};
+            const auto ready = ::poll(&readable, 1u, static_cast<int>(std::min<decltype(remaining)>(remaining, INT_MAX)));
+            if (ready > 0)
+            {
+                return true;
+            }
+            if ((ready == 0) || (errno != EINTR))
+            {
+                return false;
+            }
+        }
+    }
+
+    [[nodiscard]] bool fill()
+    {
+        constexpr std::size_t chunkSize = 64u * 1024u;
+        if (!wait_until_readable())
+        {
+            return false;
+        }
+        buffer.erase(0u, consumed);
+        consumed = 0u;
+        const auto size = buffer.size();
+        buffer.resize(size + chunkSize);
+        auto received = ::recv(fd, buffer.data() + size, chunkSize, 0);
+        while ((received < 0) && (errno == EINTR))
+        {
+            received = ::recv(fd, buffer.data() + size, chunkSize, 0);
+        }
+        buffer.resize(size + static_cast<std::size_t>(std::max<decltype(received)>(received, 0)));
+        return received > 0;
+    }
+
+    int fd{-1};
+    std::string buffer;
+    std::size_t consumed{};
+    std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::time_point::max()};
+};
+
+namespace
+{
+
+[[nodiscard]] bool make_address(const std::filesystem::path &socketPath, sockaddr_un &address)
+{
+    const auto &path = socketPath.native();
+    address = sockaddr_un{};
+    address.sun_family = AF_UNIX;
+    // the path has to fit including its terminating zero
+    if (path.empty() || (path.size() >= sizeof(address.sun_path)))
+    {
+        return false;
+    }
+    std::copy(path.begin(), path.end(), address.sun_path);
+    return true;
+}
+
+/*! \return connected socket, or -1 */
+[[nodiscard]] int connect_to(const sockaddr_un &address)
+{
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+SolverServer::SolverServer(const int listenSocket, std::filesystem::path socketPath, ResultCache *const pCache)
+    : listenSocket(listenSocket), socketPath(std::move(socketPath)), pCache(pCache)
+{
+}
+
+std::unique_ptr<SolverServer> SolverServer::Listen(const std::filesystem::path &socketPath, ResultCache *const pCache)
+{
+    sockaddr_un address{};
+    if (!make_address(socketPath, address))
+    {
+        return nullptr;
+    }
+    std::error_code error{};
+    if (const auto status = std::filesystem::symlink_status(socketPath, error); std::filesystem::exists(status))
+    {
+        // never replace anything but the socket of a server which is gone
+        if (!std::filesystem::is_socket(status))
+        {
+            return nullptr;
+        }
+        if (const int fd = connect_to(address); fd >= 0)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+        std::filesystem::remove(socketPath, error);
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+    constexpr int backlog = 16;
+    if ((::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) ||
+        (::listen(fd, backlog) != 0))
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<SolverServer>(new SolverServer(fd, socketPath, pCache));
+}
+
+SolverServer::~SolverServer()
+{
+    ::close(listenSocket);
+    std::error_code error{};
+    std::filesystem::remove(socketPath, error);
+}
+
+bool SolverServer::Run()
+{
+    while (true)
+    {
+        const int fd = ::accept(listenSocket, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if ((errno == EINTR) || (errno == ECONNABORTED))
+            {
+                continue;
+            }
+            return false;
+        }
+        Connection connection{fd};
+        // a client which sends its request slowly or never reads the answer must not block all others
+        connection.set_deadline(std::chrono::steady_clock::now() + requestTimeout);
+        const timeval sendTimeout{.tv_sec = requestTimeout.count(), .tv_usec = 0};
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+        if (!serve(connection))
+        {
+            return true;
+        }
+    }
+}
+
+bool SolverServer::serve(Connection &connection)
+{
+    std::string line;
+    if (!connection.read_line(line) || (line != protocolLine))
+    {
+        static_cast<void>(connection.write("error unsupported protocol\n"));
+        return true;
+    }
+    if (!connection.read_line(line))
+    {
+        return true;
+    }
+    if (line == "shutdown")
+    {
+        static_cast<void>(connection.write("done 0\n"));
+        return false;
+    }
+
+    const auto words = split_words(line);
+    unsigned day{};
+    std::size_t length{};
+    SolverRequest request{};
+    if ((words.size() != 4u) || (words[0u] != "solve") || !parse_word(words[1u], day) || (day < 1u) ||
+        (day > 25u) || ((words[2u] != "path") && (words[2u] != "payload")) || !parse_word(words[3u], length))
+    {
+        static_cast<void>(connection.write("error invalid request\n"));
+        return true;
+    }
+    request.kind = (words[2u] == "path") ? SolverRequest::Kind::path : SolverRequest::Kind::payload;
+    request.day = static_cast<std::uint8_t>(day);
+    if ((request.kind == SolverRequest::Kind::payload) && (length > maxPayloadSize))
+    {
+        static_cast<void>(connection.write("error payload too large\n"));
+        return true;
+    }
+    if ((request.kind == SolverRequest::Kind::path) && (length > maxPathLength))
+    {
+        static_cast<void>(connection.write("error path too long\n"));
+        return true;
+    }
+    if (!connection.read_bytes(length, request.data))
+    {
+        return true;
+    }
+    ++requestsServed;
+    solve(connection, request.day, request);
+    return true;
+}
+
+void SolverServer::solve(Connection &connection, const std::uint8_t day, const SolverRequest &request)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto elapsed = [](const Clock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - since);
+    };
+    const auto start = Clock::now();
+
+    // declared in front of the puzzle, since the input has to outlive it
+    std::unique_ptr<InputSource> pInputSource;
+    std::string_view input{request.data};
+    if (request.kind == SolverRequest::Kind::path)
+    {
+        // the stdin of the server is not the one of the client
+        pInputSource = (request.data != InputSource::stdinPath) ? InputSource::Open(request.data) : nullptr;
+        if (pInputSource == nullptr)
+        {
+            static_cast<void>(connection.write("error cannot open input file\n"));
+            return;
+        }
+        input = pInputSource->view();
+    }
+    if (input.empty())
+    {
+        static_cast<void>(connection.write("error empty input\n"));
+        return;
+    }
+    if (!connection.write("read " + std::to_string(elapsed(start).count()) + '\n'))
+    {
+        return;
+    }
+
+    const auto parseStart = Clock::now();
+    const PuzzleOptions options{.inputLifetime = InputLifetime::borrowed};
+    const auto pPuzzle = (pCache != nullptr) ? pCache->CreatePuzzle(day, input, options)
+                                             : PuzzleFactory::CreatePuzzle(day, input, options);
+    if (pPuzzle == nullptr)
+    {
+        static_cast<void>(connection.write("error no implementation for day " + std::to_string(day) + '\n'));
+        return;
+    }
+    if (!connection.write("parse " + std::to_string(elapsed(parseStart).count()) + '\n'))
+    {
+        return;
+    }
+
+    // each part is sent as soon as it is solved
+    std::mutex writeMutex;
+    const auto solvePart = [&connection, &elapsed, &pPuzzle, &writeMutex](const int part) {
+        const auto partStart = Clock::now();
+        const auto solution = (part == 1) ? pPuzzle->Part1() : pPuzzle->Part2();
+        const auto encoded = encode_part(part, elapsed(partStart), solution);
+        const std::scoped_lock lock{writeMutex};
+        static_cast<void>(connection.write(encoded));
+    };
+    if (pPuzzle->PartsAreIndependent())
+    {
+        Scheduler::shared().fork_join([&solvePart]() { solvePart(1); }, [&solvePart]() { solvePart(2); });
+    }
+    else
+    {
+        solvePart(1);
+        solvePart(2);
+    }
+    static_cast<void>(connection.write("done " + std::to_string(elapsed(start).count()) + '\n'));
+}
+
+bool SolverClient::Send(const std::filesystem::path &socketPath, const SolverRequest &request,
+                        const std::function<void(const SolverEvent &)> &fnEvent)
+{
+    sockaddr_un address{};
+    if (!make_address(socketPath, address))
+    {
+        return false;
+    }
+    // answered like the server would, which closes the connection before the client finished sending it
+    if ((request.kind == SolverRequest::Kind::payload) && (request.data.size() > SolverServer::maxPayloadSize))
+    {
+        fnEvent(SolverEvent{.kind = SolverEvent::Kind::error, .message = "payload too large"});
+        return true;
+    }
+    Connection connection{connect_to(address)};
+    if (connection.get() < 0)
+    {
+        return false;
+    }
+    auto message = std::string{protocolLine} + '\n';
+    if (request.kind == SolverRequest::Kind::shutdown)
+    {
+        message += "shutdown\n";
+    }
+    else
+    {
+        message += "solve " + std::to_string(request.day) +
+                   ((request.kind == SolverRequest::Kind::path) ? " path " : " payload ") +
+                   std::to_string(request.data.size()) + '\n';
+    }
+    if (!connection.write(message) ||
+        ((request.kind != SolverRequest::Kind::shutdown) && !connection.write(request.data)))
+    {
+        return false;
+    }
+
+    std::string line;
+    while (connection.read_line(line))
+    {
+        SolverEvent event{};
+        const auto words = split_words(line);
+        if (words.empty())
+        {
+            return false;
+        }
+        if (words[0u] == "error")
+        {
+            event.kind = SolverEvent::Kind::error;
+            event.message = std::string_view{line}.substr(std::min(line.size(), std::size_t{6u}));
+            fnEvent(event);
+            return true;
+        }
+        std::int64_t nanoseconds{};
+        if ((words.size() < 2u) || !parse_word(words[(words[0u] == "part") ? 2u : 1u], nanoseconds))
+        {
+            return false;
+        }
+        event.duration = std::chrono::nanoseconds{nanoseconds};
+        if (words[0u] == "part")
+        {
+            std::int64_t value{};
+            std::size_t length{};
+            if ((words.size() < 4u) || ((words[1u] != "1") && (words[1u] != "2")))
+            {
+                return false;
+            }
+            event.kind = (words[1u] == "1") ? SolverEvent::Kind::part1 : SolverEvent::Kind::part2;
+            if ((words[3u] == "number") && (words.size() == 5u) && parse_word(words[4u], value))
+            {
+                event.solution = value;
+            }
+            else if ((words[3u] == "text") && (words.size() == 5u) && parse_word(words[4u], length))
+            {
+                std::string text;
+                std::string lineFeed;
+                if (!connection.read_bytes(length, text) || !connection.read_bytes(1u, lineFeed))
+                {
+                    return false;
+                }
+                event.solution = std::move(text);
+            }
+            else if (words[3u] != "none")
+            {
+                return false;
+            }
+        }
+        else if (words[0u] == "read")
+        {
+            event.kind = SolverEvent::Kind::read;
+        }
+        else if (words[0u] == "parse")
+        {
+            event.kind = SolverEvent::Kind::parse;
+        }
+        else if (words[0u] == "done")
+        {
+            event.kind = SolverEvent::Kind::done;
+            fnEvent(event);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+        fnEvent(event);
+    }
+    return false;
+}
+
+#else // !defined(AOC_Y2022_SOLVER_DAEMON_POSIX)
+
+class Connection final
+{
+};
+
+SolverServer::SolverServer(const int listenSocket, std::filesystem::path socketPath, ResultCache *const pCache)
+    : listenSocket(listenSocket), socketPath(std::move(socketPath)), pCache(pCache)
+{
+}
+
+std::unique_ptr<SolverServer> SolverServer::Listen(const std::filesystem::path & /*socketPath*/,
+                                                   ResultCache *const /*pCache*/)
+{
+    return nullptr;
+}
+
+SolverServer::~SolverServer() = default;
+
+bool SolverServer::Run()
+{
+    return false;
+}
+
+bool SolverServer::serve(Connection & /*connection*/)
+{
+    return false;
+}
+
+void SolverServer::solve(Connection & /*connection*/, const std::uint8_t /*day*/, const SolverRequest & /*request*/)
+{
+}
+
+bool SolverClient::Send(const std::filesystem::path & /*socketPath*/, const SolverRequest & /*request*/,
+                        const std::function<void(const SolverEvent &)> & /*fnEvent*/)
+{
+    return false;
+}
+
+#endif // defined(AOC_Y2022_SOLVER_DAEMON_POSIX)
+
+} // namespace AOC::Y2022
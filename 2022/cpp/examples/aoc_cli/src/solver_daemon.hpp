@@ -0,0 +1,135 @@
+#if !defined(AOC_Y2022_SOLVER_DAEMON_HPP)
+#define AOC_Y2022_SOLVER_DAEMON_HPP (1)
+
+#include "aoc_y2022.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace AOC::Y2022
+{
+
+class Connection;
+
+/*!
+ * \brief Request to a SolverServer.
+ *
+ * On the socket, a request is the line "aoc-y2022-daemon 1" followed by one of
+ * \verbatim
+solve <day> path <length>\n<path>         the server reads the input file itself
+solve <day> payload <length>\n<input>     the input is sent along
+shutdown\n
+\endverbatim
+ * Paths may be up to SolverServer::maxPathLength bytes long, payloads up to SolverServer::maxPayloadSize bytes.
+ */
+struct SolverRequest final
+{
+    enum class Kind : std::uint8_t
+    {
+        path, payload, shutdown,
+    };
+
+    Kind kind{Kind::path};
+    std::uint8_t day{};
+    std::string data{}; //!< path or input, depending on the kind
+};
+
+/*!
+ * \brief One line of the answer of a SolverServer, which is sent as soon as it is known.
+ *
+ * On the socket, an answer is either the single line "error <message>" or the lines
+ * \verbatim
+read <ns>                          input read or mapped
+parse <ns>                         puzzle created
+part <1|2> <ns> none               both parts, in the order they are solved
+part <1|2> <ns> number <value>
+part <1|2> <ns> text <length>\n<text>
+done <ns>                          total time on the server
+\endverbatim
+ */
+struct SolverEvent final
+{
+    enum class Kind : std::uint8_t
+    {
+        read, parse, part1, part2, done, error,
+    };
+
+    Kind kind{Kind::error};
+    std::chrono::nanoseconds duration{};
+    IPuzzle::Solution_t solution{};
+    std::string message{}; //!< reason of an error
+};
+
+/*!
+ * \brief Solves requests arriving on a Unix domain socket, keeping the process, the threads of the shared scheduler
+ *        and the result cache warm between them.
+ *
+ * Every connection carries a single request. Connections are served one after the other, the parts of a puzzle are
+ * still solved in parallel. So that a single client cannot hold up all others, it has to send its whole request
+ * within requestTimeout, and every write of the answer gives up once the client stopped reading for as long.
+ * Only available on POSIX systems.
+ */
+class SolverServer final
+{
+  public:
+    /*! \brief Largest input sent along with a request, larger ones are answered with "error payload too large". */
+    static constexpr std::size_t maxPayloadSize = std::size_t{256u} * 1024u * 1024u;
+    /*! \brief Longest path of an input file, longer ones are answered with "error path too long". */
+    static constexpr std::size_t maxPathLength = 4096u;
+    static constexpr std::chrono::seconds requestTimeout{10};
+
+    /*!
+     * \brief Binds the socket, replacing a socket file which is left over from a server that was killed.
+     * \param pCache  result cache to answer from and to store new solutions in, may be nullptr
+     * \return nullptr if the socket cannot be created or another server listens on it
+     */
+    [[nodiscard]] static std::unique_ptr<SolverServer> Listen(const std::filesystem::path &socketPath,
+                                                              ResultCache *pCache = nullptr);
+
+    /*! \brief Closes the socket and removes its file. */
+    ~SolverServer();
+    SolverServer(const SolverServer &) = delete;
+    SolverServer(SolverServer &&) = delete;
+    SolverServer &operator=(const SolverServer &) = delete;
+    SolverServer &operator=(SolverServer &&) = delete;
+
+    /*!
+     * \brief Serves requests until a client asks for the shutdown.
+     * \return false if accepting connections failed
+     */
+    bool Run();
+
+    [[nodiscard]] std::size_t requests_served() const noexcept { return requestsServed; }
+
+  private:
+    SolverServer(int listenSocket, std::filesystem::path socketPath, ResultCache *pCache);
+
+    /*! \return false if the client asked for the shutdown */
+    bool serve(Connection &connection);
+    void solve(Connection &connection, std::uint8_t day, const SolverRequest &request);
+
+    int listenSocket{-1};
+    std::filesystem::path socketPath;
+    ResultCache *pCache{};
+    std::size_t requestsServed{};
+};
+
+class SolverClient final
+{
+  public:
+    /*!
+     * \brief Sends the request and reports every line of the answer as soon as it arrives.
+     * \return false if the server cannot be reached or the answer ends early
+     */
+    [[nodiscard]] static bool Send(const std::filesystem::path &socketPath, const SolverRequest &request,
+                                   const std::function<void(const SolverEvent &)> &fnEvent);
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_SOLVER_DAEMON_HPP)
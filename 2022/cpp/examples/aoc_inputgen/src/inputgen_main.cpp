@@ -0,0 +1,70 @@
+#include "input_generator.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+int main(const int argc, const char *const argv[])
+{
+    if ((argc < 3) || (argc > 5) || (argv == nullptr))
+    {
+        const char *const executableName = ((argc > 0) && (argv != nullptr) && (argv[0u] != nullptr)) ? argv[0u] : "";
+        std::cerr << "==Advent of Code 2022 input generator==\n";
+        std::cerr << "usage: " << executableName << " <day> <size> [seed] [outputfile]\n";
+        std::cerr << "example: " << executableName << " 1 100000000 42 input01.txt\n";
+        std::cerr << "writes to stdout if no output file is given\n";
+        return (argc == 1) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    const auto parseNumber = [](const char *const str, std::uint64_t &out) {
+        char *end = nullptr;
+        const auto value = std::strtoull(str, &end, 10);
+        if ((end == str) || (*end != '\0'))
+        {
+            return false;
+        }
+        out = value;
+        return true;
+    };
+    std::uint64_t day{};
+    AOC::Y2022::InputGenerator::Settings settings{};
+    if (!parseNumber(argv[1u], day) || (day < 1u) || (day > 25u))
+    {
+        std::cerr << "error: please select a day from 1 and 25\n";
+        return EXIT_FAILURE;
+    }
+    if (!AOC::Y2022::InputGenerator::has_generator_for_day(static_cast<std::uint8_t>(day)))
+    {
+        std::cerr << "sorry, no generator for day " << day << '\n';
+        return EXIT_FAILURE;
+    }
+    if (!parseNumber(argv[2u], settings.size) || ((argc > 3) && !parseNumber(argv[3u], settings.seed)))
+    {
+        std::cerr << "error: size and seed must be decimal numbers\n";
+        return EXIT_FAILURE;
+    }
+
+    bool success = false;
+    if (argc > 4)
+    {
+        std::ofstream ofs(argv[4u], std::ios::binary);
+        if (!ofs.is_open())
+        {
+            std::cerr << "error: cannot open output file\n";
+            return EXIT_FAILURE;
+        }
+        success = AOC::Y2022::InputGenerator::Generate(static_cast<std::uint8_t>(day), settings, ofs);
+    }
+    else
+    {
+        success = AOC::Y2022::InputGenerator::Generate(static_cast<std::uint8_t>(day), settings, std::cout);
+    }
+    if (!success)
+    {
+        std::cerr << "error: failed to write the input\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,41 @@
+#include "duration_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+
+namespace AOC::Y2022
+{
+
+[[nodiscard]] DurationStatistics compute_statistics(std::vector<std::chrono::nanoseconds> durations)
+{
+    if (durations.empty())
+    {
+        return {};
+    }
+    std::ranges::sort(durations);
+    const auto count = durations.size();
+    const auto percentile = [&durations, count](const std::size_t percent) {
+        const auto rank = ((percent * count) + 99u) / 100u;
+        return durations[std::max<std::size_t>(rank, 1u) - 1u];
+    };
+    const auto total = std::accumulate(durations.begin(), durations.end(), std::chrono::nanoseconds{});
+    const auto mean = static_cast<double>(total.count()) / static_cast<double>(count);
+    const auto squares = std::accumulate(durations.begin(), durations.end(), 0.0,
+                                         [mean](const double sum, const std::chrono::nanoseconds duration) {
+                                             const auto deviation = static_cast<double>(duration.count()) - mean;
+                                             return sum + (deviation * deviation);
+                                         });
+    return DurationStatistics{
+        .min = durations.front(),
+        .median = percentile(50u),
+        .p90 = percentile(90u),
+        .p99 = percentile(99u),
+        .max = durations.back(),
+        .mean = std::chrono::nanoseconds{std::llround(mean)},
+        .stddev = std::chrono::nanoseconds{std::llround(std::sqrt(squares / static_cast<double>(count)))},
+    };
+}
+
+} // namespace AOC::Y2022
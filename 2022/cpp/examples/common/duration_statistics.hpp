@@ -0,0 +1,31 @@
+#if !defined(AOC_Y2022_DURATION_STATISTICS_HPP)
+#define AOC_Y2022_DURATION_STATISTICS_HPP (1)
+
+#include <chrono>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Distribution of repeatedly measured durations.
+ *
+ * The median and the percentiles use the nearest rank, so that each of them is one of the measured durations.
+ */
+struct DurationStatistics final
+{
+    std::chrono::nanoseconds min{};
+    std::chrono::nanoseconds median{};
+    std::chrono::nanoseconds p90{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds max{};
+    std::chrono::nanoseconds mean{};
+    std::chrono::nanoseconds stddev{}; //!< of the population
+};
+
+/*! \brief Computes the distribution of the durations, all zero if there are none. */
+[[nodiscard]] DurationStatistics compute_statistics(std::vector<std::chrono::nanoseconds> durations);
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_DURATION_STATISTICS_HPP)
@@ -0,0 +1,175 @@
+#include "input_source.hpp"
+
+#include <array>
+#include <cstdio>
+#include <functional>
+
+#if defined(_WIN32)
+#if !defined(NOMINMAX)
+#define NOMINMAX
+#endif
+#if !defined(WIN32_LEAN_AND_MEAN)
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define AOC_Y2022_INPUT_SOURCE_POSIX (1)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+/*! \brief Reads the stream in chunks until its end or until fnChunkCb returns false. */
+[[nodiscard]] bool read_stream(std::FILE *pFile, const std::function<bool(std::string_view)> &fnChunkCb)
+{
+    std::array<char, 64u * 1024u> chunk{};
+    while (true)
+    {
+        const auto count = std::fread(chunk.data(), 1u, chunk.size(), pFile);
+        if ((count != 0u) && !fnChunkCb(std::string_view{chunk.data(), count}))
+        {
+            return true;
+        }
+        if (count < chunk.size())
+        {
+            return std::ferror(pFile) == 0;
+        }
+    }
+}
+
+[[nodiscard]] bool read_path(const std::string &path, const std::function<bool(std::string_view)> &fnChunkCb)
+{
+    if (path == InputSource::stdinPath)
+    {
+#if defined(_WIN32)
+        _setmode(_fileno(stdin), _O_BINARY);
+#endif
+        return read_stream(stdin, fnChunkCb);
+    }
+    std::FILE *const pFile = std::fopen(path.c_str(), "rb");
+    if (pFile == nullptr)
+    {
+        return false;
+    }
+    const bool success = read_stream(pFile, fnChunkCb);
+    std::fclose(pFile);
+    return success;
+}
+
+} // namespace
+
+std::unique_ptr<InputSource> InputSource::Open(const std::string &path)
+{
+    std::unique_ptr<InputSource> pSource{new InputSource()};
+    if ((path != stdinPath) && pSource->map_file(path))
+    {
+        return pSource;
+    }
+    if (!pSource->read_file(path))
+    {
+        return nullptr;
+    }
+    return pSource;
+}
+
+InputSource::~InputSource()
+{
+    if (mapping == nullptr)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping);
+#elif defined(AOC_Y2022_INPUT_SOURCE_POSIX)
+    munmap(mapping, size);
+#endif
+}
+
+bool InputSource::map_file([[maybe_unused]] const std::string &path)
+{
+#if defined(_WIN32)
+    const HANDLE hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                     FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize{};
+    if ((GetFileType(hFile) != FILE_TYPE_DISK) || !GetFileSizeEx(hFile, &fileSize) || (fileSize.QuadPart <= 0))
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+    const HANDLE hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0u, 0u, nullptr);
+    CloseHandle(hFile);
+    if (hMapping == nullptr)
+    {
+        return false;
+    }
+    // the view keeps the mapping object alive
+    void *const pView = MapViewOfFile(hMapping, FILE_MAP_READ, 0u, 0u, 0u);
+    CloseHandle(hMapping);
+    if (pView == nullptr)
+    {
+        return false;
+    }
+    mapping = pView;
+    size = static_cast<std::size_t>(fileSize.QuadPart);
+#elif defined(AOC_Y2022_INPUT_SOURCE_POSIX)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat fileStat{};
+    if ((fstat(fd, &fileStat) != 0) || !S_ISREG(fileStat.st_mode) || (fileStat.st_size <= 0))
+    {
+        ::close(fd);
+        return false;
+    }
+    const auto fileSize = static_cast<std::size_t>(fileStat.st_size);
+    void *const pView = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (pView == MAP_FAILED)
+    {
+        return false;
+    }
+#if defined(POSIX_MADV_SEQUENTIAL)
+    posix_madvise(pView, fileSize, POSIX_MADV_SEQUENTIAL);
+#endif
+    mapping = pView;
+    size = fileSize;
+#else
+    return false;
+#endif
+    data = static_cast<const char *>(mapping);
+    return true;
+}
+
+bool InputSource::ReadChunks(const std::string &path, const std::function<bool(std::string_view)> &fnChunkCb)
+{
+    return read_path(path, fnChunkCb);
+}
+
+bool InputSource::read_file(const std::string &path)
+{
+    const bool success = read_path(path, [this](const std::string_view chunk) {
+        buffer.append(chunk);
+        return true;
+    });
+    data = buffer.data();
+    size = buffer.size();
+    return success;
+}
+
+} // namespace AOC::Y2022
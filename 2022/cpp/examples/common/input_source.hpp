@@ -0,0 +1,62 @@
+#if !defined(AOC_Y2022_INPUT_SOURCE_HPP)
+#define AOC_Y2022_INPUT_SOURCE_HPP (1)
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Read-only view of a puzzle input that avoids copying the file where possible.
+ *
+ * Regular files are memory mapped, so `view()` points directly into the page cache and can be handed to
+ * `PuzzleFactory::CreatePuzzle` without a copy. Pipes, character devices, empty files, the path "-" (stdin)
+ * and platforms without mapping support fall back to a buffered read into an owned string.
+ * The view stays valid for the lifetime of the InputSource.
+ */
+class InputSource final
+{
+  public:
+    /*! \brief Path that selects stdin. */
+    static constexpr std::string_view stdinPath{"-"};
+
+    /*! \brief Opens the given file, returns nullptr if it cannot be opened or read. */
+    [[nodiscard]] static std::unique_ptr<InputSource> Open(const std::string &path);
+
+    /*!
+     * \brief Reads the given file in chunks of at most 64 KiB without keeping it in memory.
+     *
+     * Stops early if fnChunkCb returns false. The chunks are only valid during the callback.
+     * \return false if the file cannot be opened or read
+     */
+    [[nodiscard]] static bool ReadChunks(const std::string &path,
+                                         const std::function<bool(std::string_view)> &fnChunkCb);
+
+    ~InputSource();
+    InputSource(const InputSource &) = delete;
+    InputSource &operator=(const InputSource &) = delete;
+    InputSource(InputSource &&) = delete;
+    InputSource &operator=(InputSource &&) = delete;
+
+    [[nodiscard]] std::string_view view() const noexcept { return {data, size}; }
+    [[nodiscard]] bool is_mapped() const noexcept { return mapping != nullptr; }
+
+  private:
+    InputSource() = default;
+
+    [[nodiscard]] bool map_file(const std::string &path);
+    [[nodiscard]] bool read_file(const std::string &path);
+
+    const char *data{};
+    std::size_t size{};
+    void *mapping{};
+    std::string buffer{};
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_INPUT_SOURCE_HPP)
@@ -3,5 +3,7 @@
 
 #include "types.hpp"
 #include "puzzle_factory.hpp"
+#include "puzzle_registry.hpp"
+#include "result_cache.hpp"
 
 #endif // !defined(AOC_Y2022_HPP)
@@ -18,12 +18,19 @@ class IPuzzle
       one, two,
     };
     using Solution_t = std::variant<std::monostate, std::int64_t, std::string>;
+    struct Solutions final
+    {
+        Solution_t part1{};
+        Solution_t part2{};
+    };
 
   public:
     virtual ~IPuzzle() = default;
 
     [[nodiscard]] Solution_t virtual Part1() = 0;
     [[nodiscard]] Solution_t virtual Part2() = 0;
+    /*! \brief True if Part1() and Part2() only read the parsed input, so that they may run concurrently. */
+    [[nodiscard]] virtual bool PartsAreIndependent() const { return false; }
 
   protected:
     IPuzzle() = default;
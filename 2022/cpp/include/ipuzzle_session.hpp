@@ -0,0 +1,45 @@
+#if !defined(AOC_Y2022_IPUZZLE_SESSION_HPP)
+#define AOC_Y2022_IPUZZLE_SESSION_HPP (1)
+
+#include "ipuzzle.hpp"
+#include "types.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Input that is edited in place and solved again after every edit, e.g. while it is typed in an editor.
+ *
+ * The session owns a copy of the input. Days with an incremental implementation only parse the lines an edit
+ * touches and only recompute what depends on them; the solutions are always the same as those of the IPuzzle
+ * constructed from the current input.
+ */
+class IPuzzleSession
+{
+  public:
+    virtual ~IPuzzleSession() = default;
+
+    /*!
+     * \brief Replaces length bytes of the input at offset by the replacement.
+     * \return false if the range is not within the input, which is left unchanged then
+     */
+    virtual bool Edit(std::size_t offset, std::size_t length, std::string_view replacement) = 0;
+    /*! \brief Current input, valid until the next edit. */
+    [[nodiscard]] virtual std::string_view Input() const = 0;
+    /*! \brief Solutions of both parts for the current input. */
+    [[nodiscard]] virtual IPuzzle::Solutions Solve() = 0;
+
+  protected:
+    IPuzzleSession() = default;
+    IPuzzleSession(const IPuzzleSession &) = default;
+    IPuzzleSession(IPuzzleSession &&) = default;
+    IPuzzleSession &operator=(const IPuzzleSession &) = default;
+    IPuzzleSession &operator=(IPuzzleSession &&) = default;
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_IPUZZLE_SESSION_HPP)
@@ -0,0 +1,42 @@
+#if !defined(AOC_Y2022_ISTREAMING_PUZZLE_HPP)
+#define AOC_Y2022_ISTREAMING_PUZZLE_HPP (1)
+
+#include "ipuzzle.hpp"
+#include "types.hpp"
+
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Puzzle which consumes its input in chunks of arbitrary size, solving both parts in a single pass.
+ *
+ * Only days that do not need the whole input at once offer this interface. Their memory usage does not depend on
+ * the size of the input, so inputs larger than the available memory can be solved. Chunks may split lines
+ * anywhere; the solutions are the same as those of the IPuzzle constructed from the concatenated chunks.
+ */
+class IStreamingPuzzle
+{
+  public:
+    virtual ~IStreamingPuzzle() = default;
+
+    /*!
+     * \brief Consumes the next chunk, which does not need to stay valid after the call.
+     * \return false if the input is already known to be invalid, further chunks can be skipped then
+     */
+    virtual bool Push(std::string_view chunk) = 0;
+    /*! \brief Marks the end of the input and returns the solutions of both parts. */
+    [[nodiscard]] virtual IPuzzle::Solutions Finish() = 0;
+
+  protected:
+    IStreamingPuzzle() = default;
+    IStreamingPuzzle(const IStreamingPuzzle &) = default;
+    IStreamingPuzzle(IStreamingPuzzle &&) = default;
+    IStreamingPuzzle &operator=(const IStreamingPuzzle &) = default;
+    IStreamingPuzzle &operator=(IStreamingPuzzle &&) = default;
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_ISTREAMING_PUZZLE_HPP)
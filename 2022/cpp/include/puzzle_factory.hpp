@@ -2,21 +2,94 @@
 #define AOC_Y2022_GAME_FACTORY_HPP (1)
 
 #include "ipuzzle.hpp"
+#include "ipuzzle_session.hpp"
+#include "istreaming_puzzle.hpp"
+#include "puzzle_instrumentation.hpp"
+#include "puzzle_options.hpp"
+#include "puzzle_registry.hpp"
+#include "scheduler.hpp"
 #include "types.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace AOC::Y2022
 {
 
+/*! \brief One input of a batch, the input buffer has to stay valid until SolveBatch returns. */
+struct BatchJob final
+{
+    std::uint8_t day{};
+    std::string_view input{};
+};
+
+struct BatchResult final
+{
+    bool created{}; //!< false if there is no implementation for the day
+    IPuzzle::Solutions solutions{};
+};
+
 AOC_Y2022_API
 class PuzzleFactory final
 {
   public:
-    [[nodiscard]] static std::unique_ptr<IPuzzle> CreatePuzzle(std::uint8_t game, std::string_view input);
+    [[nodiscard]] static std::unique_ptr<IPuzzle> CreatePuzzle(std::uint8_t game, std::string_view input,
+                                                               const PuzzleOptions &options = {});
     [[nodiscard]] static bool has_implementation_for_day(std::uint8_t day);
+
+    /*!
+     * \brief Creates a puzzle which is fed the input chunk by chunk, for inputs that should not be held in memory.
+     * \return nullptr if the day has no streaming implementation
+     */
+    [[nodiscard]] static std::unique_ptr<IStreamingPuzzle> CreateStreamingPuzzle(std::uint8_t day,
+                                                                               const PuzzleOptions &options = {});
+    [[nodiscard]] static bool has_streaming_implementation_for_day(std::uint8_t day);
+
+    /*!
+     * \brief Creates a session which keeps a copy of the input and solves it again after every edit.
+     *
+     * Days with an incremental implementation only parse the lines an edit touches and take nothing but the parse
+     * mode and the number of top elves from the options; any other day solves the whole input again.
+     * \return nullptr if there is no implementation for the day
+     */
+    [[nodiscard]] static std::unique_ptr<IPuzzleSession> CreateSession(std::uint8_t day, std::string_view input,
+                                                                       const PuzzleOptions &options = {});
+    [[nodiscard]] static bool has_incremental_implementation_for_day(std::uint8_t day);
+
+    /*!
+     * \brief Solves both parts as parallel tasks of the scheduler if the puzzle marks them as independent.
+     *
+     * Solves one part after the other if the puzzle does not allow it or the scheduler has a single thread.
+     * The memory resource the puzzle was created with has to be thread-safe then.
+     * \param pScheduler  scheduler to run the parts on, nullptr selects Scheduler::shared()
+     */
+    [[nodiscard]] static IPuzzle::Solutions SolveConcurrently(IPuzzle &puzzle, Scheduler *pScheduler = nullptr);
+
+    /*!
+     * \brief Solves many inputs as tasks of a work-stealing scheduler and returns the results in the order of the jobs.
+     *
+     * \param threadCount  number of threads of a scheduler created for this batch, including the calling thread;
+     *                     0 runs the jobs on options.scheduler, or Scheduler::shared() if that is nullptr
+     * The inputs are always borrowed, since they outlive every puzzle created here. Every job allocates from its own
+     * monotonic arena, which takes its memory from options.memoryResource; that resource has to be thread-safe.
+     */
+    [[nodiscard]] static std::vector<BatchResult> SolveBatch(std::span<const BatchJob> jobs,
+                                                             const PuzzleOptions &options = {},
+                                                             std::size_t threadCount = 0u);
+
+    /*!
+     * \brief Creates the puzzle and solves both parts, measuring every phase on the calling thread.
+     *
+     * Construction counts as the parse phase. Allocation counters are only filled if the allocation hooks are
+     * linked, see AllocationTracker. They only count the allocations of the calling thread, so the input is parsed
+     * on the calling thread alone unless options.scheduler is set.
+     */
+    [[nodiscard]] static SolveReport SolveInstrumented(std::uint8_t day, std::string_view input,
+                                                       const PuzzleOptions &options = {});
 };
 
 } // namespace AOC::Y2022
@@ -0,0 +1,80 @@
+#if !defined(AOC_Y2022_PUZZLE_INSTRUMENTATION_HPP)
+#define AOC_Y2022_PUZZLE_INSTRUMENTATION_HPP (1)
+
+#include "ipuzzle.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Counts the heap allocations of the calling thread.
+ *
+ * The counters are only fed if the executable links the `aoc_y2022_allocation_hooks` object library, which
+ * replaces the global `operator new` and `operator delete`. Without it, `is_installed()` returns false and all
+ * counters stay zero.
+ */
+AOC_Y2022_API
+class AllocationTracker final
+{
+  public:
+    struct Counters final
+    {
+        std::uint64_t allocations{};
+        std::uint64_t bytesAllocated{};
+        std::int64_t currentBytes{}; //!< may become negative if memory from another thread is released
+        std::int64_t peakBytes{};
+    };
+
+  public:
+    static void on_allocate(std::size_t bytes) noexcept;
+    static void on_deallocate(std::size_t bytes) noexcept;
+    static void mark_installed() noexcept;
+    [[nodiscard]] static bool is_installed() noexcept;
+
+    [[nodiscard]] static Counters snapshot() noexcept;
+    /*! \brief Lowers the peak to the current usage, so that a new peak can be measured from here. */
+    static void reset_peak() noexcept;
+};
+
+/*! \brief Cost of one phase of solving a puzzle, measured on the calling thread. */
+struct PhaseMetrics final
+{
+    std::chrono::nanoseconds duration{};
+    std::uint64_t allocations{};
+    std::uint64_t bytesAllocated{};
+    std::uint64_t peakBytes{}; //!< highest heap usage during the phase, relative to its start
+};
+
+/*! \brief Solutions of both parts together with per-phase metrics. */
+struct SolveReport final
+{
+    enum class Phase : std::size_t
+    {
+        parse, part1, part2, max,
+    };
+    static constexpr std::array<std::string_view, static_cast<std::size_t>(Phase::max)> phaseNames{
+        "parse", "part1", "part2",
+    };
+
+    [[nodiscard]] const PhaseMetrics &operator[](const Phase phase) const
+    {
+        return phases[static_cast<std::size_t>(phase)];
+    }
+
+    bool created{};              //!< false if there is no implementation for the day
+    bool allocationsTracked{};   //!< false if the allocation hooks are not linked
+    IPuzzle::Solution_t part1{};
+    IPuzzle::Solution_t part2{};
+    std::array<PhaseMetrics, static_cast<std::size_t>(Phase::max)> phases{};
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_PUZZLE_INSTRUMENTATION_HPP)
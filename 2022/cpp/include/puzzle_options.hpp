@@ -0,0 +1,69 @@
+#if !defined(AOC_Y2022_PUZZLE_OPTIONS_HPP)
+#define AOC_Y2022_PUZZLE_OPTIONS_HPP (1)
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace AOC::Y2022
+{
+
+class Scheduler;
+
+/*! \brief Tells a puzzle whether it may keep a reference to the input buffer it is constructed with. */
+enum class InputLifetime : std::uint8_t
+{
+    copied,   //!< the buffer may be released right after construction, the puzzle keeps its own copy if needed
+    borrowed, //!< the caller guarantees that the buffer outlives the puzzle
+};
+
+/*! \brief Tells a puzzle how far it may trust its input. */
+enum class ParseMode : std::uint8_t
+{
+    validate, //!< every line is matched against its expected format, malformed input gives no solution
+    trusted,  //!< fields are taken from fixed positions of well-formed lines, malformed input gives garbage
+};
+
+/*! \brief Options which are passed to every puzzle on construction. */
+struct PuzzleOptions final
+{
+    InputLifetime inputLifetime{InputLifetime::copied};
+    /*!
+     * \brief Trusted parsing skips validating every line, which takes most of the parse time of large inputs.
+     *
+     * Unless NDEBUG is defined, every trusted parse is checked against the validating one, see
+     * AOC_Y2022_CHECK_TRUSTED_PARSING.
+     */
+    ParseMode parseMode{ParseMode::validate};
+    /*!
+     * \brief Resource the puzzle takes the memory of its containers from, it has to outlive the puzzle.
+     *
+     * The puzzle allocates from it while parsing and solving. nullptr selects the global operator new.
+     * A std::pmr::monotonic_buffer_resource per puzzle avoids contention on the global heap when many puzzles are
+     * solved in parallel and is released in one go.
+     */
+    std::pmr::memory_resource *memoryResource{};
+    /*!
+     * \brief Scheduler running the parallel work of the puzzle, like parsing large inputs, on its threads.
+     *
+     * It has to outlive the puzzle. nullptr selects Scheduler::shared(), a Scheduler with a single thread makes the
+     * puzzle work sequentially.
+     */
+    Scheduler *scheduler{};
+    /*!
+     * \brief Number of elves whose calories part 2 of day 01 sums up, the puzzle asks for 3.
+     *
+     * The memory of day 01 grows with this count, not with the input. Solutions for any other count are neither
+     * precomputed nor cached.
+     */
+    std::size_t topElves{3u};
+
+    /*! \brief True if the options make a puzzle answer other questions than the ones of the puzzle text. */
+    [[nodiscard]] constexpr bool changes_solutions() const noexcept { return topElves != 3u; }
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_PUZZLE_OPTIONS_HPP)
@@ -0,0 +1,142 @@
+#if !defined(AOC_Y2022_PUZZLE_REGISTRY_HPP)
+#define AOC_Y2022_PUZZLE_REGISTRY_HPP (1)
+
+#include "ipuzzle.hpp"
+#include "ipuzzle_session.hpp"
+#include "istreaming_puzzle.hpp"
+#include "puzzle_options.hpp"
+#include "types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace AOC::Y2022
+{
+
+/*! \brief Every day with an implementation, all dispatching from a day number to its puzzle is generated from it. */
+using SupportedDays = std::integer_sequence<std::uint8_t, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 12u, 17u>;
+/*! \brief Days which can also consume their input chunk by chunk, see IStreamingPuzzle. */
+using StreamingDays = std::integer_sequence<std::uint8_t, 1u, 2u, 3u, 4u, 6u, 10u>;
+/*! \brief Days which only parse the edited lines in an IPuzzleSession, see PuzzleSession. */
+using IncrementalDays = std::integer_sequence<std::uint8_t, 1u, 2u, 3u, 4u, 10u>;
+
+template <std::uint8_t... days>
+[[nodiscard]] constexpr bool contains_day(std::integer_sequence<std::uint8_t, days...>, const std::uint8_t day) noexcept
+{
+    return ((day == days) || ...);
+}
+
+template <std::uint8_t day>
+concept SupportedDay = contains_day(SupportedDays{}, day);
+template <std::uint8_t day>
+concept StreamingDay = contains_day(StreamingDays{}, day);
+template <std::uint8_t day>
+concept IncrementalDay = contains_day(IncrementalDays{}, day);
+
+/*!
+ * \brief Turns a day number known at runtime into a compile-time constant.
+ *
+ * Calls fnDay(std::integral_constant<std::uint8_t, day>{}) if day is one of the days of the list.
+ * \return false if the list does not contain the day
+ */
+template <std::uint8_t... days, typename FnDay>
+constexpr bool visit_day(const std::uint8_t day, std::integer_sequence<std::uint8_t, days...>, FnDay &&fnDay)
+{
+    return (((day == days) && (fnDay(std::integral_constant<std::uint8_t, days>{}), true)) || ...);
+}
+
+/*! \brief Parsed input and solvers of one day, defined in the source file of the day. */
+template <std::uint8_t day> class PuzzleImpl;
+template <std::uint8_t day> class StreamingPuzzleImpl;
+template <std::uint8_t day> class SessionImpl;
+class EditableInput;
+
+/*! \brief IPuzzle of one day, see PuzzleFactory::CreatePuzzle for picking the day at runtime. */
+template <std::uint8_t day>
+    requires SupportedDay<day>
+class Puzzle final : public IPuzzle
+{
+  public:
+    explicit Puzzle(std::string_view input, const PuzzleOptions &options = {});
+    Puzzle(const Puzzle &) = delete;
+    Puzzle(Puzzle &&) = delete;
+    Puzzle &operator=(const Puzzle &) = delete;
+    Puzzle &operator=(Puzzle &&) = delete;
+    ~Puzzle() override;
+
+    [[nodiscard]] Solution_t Part1() override;
+    [[nodiscard]] Solution_t Part2() override;
+    [[nodiscard]] bool PartsAreIndependent() const override;
+    /*! \brief True if the input is the embedded input of the day, whose solutions were computed by the compiler. */
+    [[nodiscard]] bool IsPrecomputed() const noexcept;
+
+    /*!
+     * \brief Parses the input and solves both parts, one after the other.
+     *
+     * The parsed input lives on the stack of this call and both parts are called directly, so there is neither the
+     * heap allocation of the puzzle nor a virtual call; only the containers of the parsed input allocate, from
+     * options.memoryResource.
+     */
+    [[nodiscard]] static Solutions Solve(std::string_view input, const PuzzleOptions &options = {});
+
+  private:
+    std::unique_ptr<PuzzleImpl<day>> pImpl;
+};
+
+/*! \brief IStreamingPuzzle of one day, see PuzzleFactory::CreateStreamingPuzzle for picking the day at runtime. */
+template <std::uint8_t day>
+    requires StreamingDay<day>
+class StreamingPuzzle final : public IStreamingPuzzle
+{
+  public:
+    explicit StreamingPuzzle(const PuzzleOptions &options = {});
+    StreamingPuzzle(const StreamingPuzzle &) = delete;
+    StreamingPuzzle(StreamingPuzzle &&) = delete;
+    StreamingPuzzle &operator=(const StreamingPuzzle &) = delete;
+    StreamingPuzzle &operator=(StreamingPuzzle &&) = delete;
+    ~StreamingPuzzle() override;
+
+    bool Push(std::string_view chunk) override;
+    [[nodiscard]] IPuzzle::Solutions Finish() override;
+
+  private:
+    std::unique_ptr<StreamingPuzzleImpl<day>> pImpl;
+};
+
+/*! \brief IPuzzleSession of one day, see PuzzleFactory::CreateSession for picking the day at runtime. */
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+class PuzzleSession final : public IPuzzleSession
+{
+  public:
+    explicit PuzzleSession(std::string_view input, const PuzzleOptions &options = {});
+    PuzzleSession(const PuzzleSession &) = delete;
+    PuzzleSession(PuzzleSession &&) = delete;
+    PuzzleSession &operator=(const PuzzleSession &) = delete;
+    PuzzleSession &operator=(PuzzleSession &&) = delete;
+    ~PuzzleSession() override;
+
+    bool Edit(std::size_t offset, std::size_t length, std::string_view replacement) override;
+    [[nodiscard]] std::string_view Input() const override;
+    [[nodiscard]] IPuzzle::Solutions Solve() override;
+
+  private:
+    std::unique_ptr<EditableInput> pInput;
+    std::unique_ptr<SessionImpl<day>> pImpl;
+};
+
+/*! \brief Solves both parts of the day selected at compile time, see Puzzle::Solve. */
+template <std::uint8_t day>
+    requires SupportedDay<day>
+[[nodiscard]] IPuzzle::Solutions solve(const std::string_view input, const PuzzleOptions &options = {})
+{
+    return Puzzle<day>::Solve(input, options);
+}
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_PUZZLE_REGISTRY_HPP)
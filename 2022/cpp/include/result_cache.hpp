@@ -0,0 +1,86 @@
+#if !defined(AOC_Y2022_RESULT_CACHE_HPP)
+#define AOC_Y2022_RESULT_CACHE_HPP (1)
+
+#include "ipuzzle.hpp"
+#include "puzzle_options.hpp"
+#include "types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Stores the solutions of solved inputs on disk, so that solving the same input again is a file read.
+ *
+ * An entry is keyed by the day, a hash of the input and the build id of the library, so solutions of another
+ * build are never returned. Every entry is a small file in the cache directory. Once the files exceed the size
+ * limit, the least recently used ones are removed; a hit counts as a use. Several processes may share a directory,
+ * the worst outcome of a race is a miss. All functions are thread-safe.
+ */
+AOC_Y2022_API
+class ResultCache final
+{
+  public:
+    static constexpr std::uint64_t defaultSizeLimit = 16u * 1024u * 1024u;
+
+    explicit ResultCache(std::filesystem::path directory, std::uint64_t sizeLimit = defaultSizeLimit);
+
+    /*! \brief Hash of all sources of the library, entries of other builds are ignored. */
+    [[nodiscard]] static std::string_view build_id() noexcept;
+    /*! \brief Fast, non-cryptographic 64-bit hash of an input. */
+    [[nodiscard]] static std::uint64_t hash_input(std::string_view input) noexcept;
+
+    [[nodiscard]] std::optional<IPuzzle::Solutions> Lookup(std::uint8_t day, std::string_view input);
+    /*! \brief Stores the solutions and evicts the least recently used entries beyond the size limit. */
+    void Store(std::uint8_t day, std::string_view input, const IPuzzle::Solutions &solutions);
+
+    /*!
+     * \brief Creates a puzzle which answers from the cache, or solves the input and stores both solutions.
+     *
+     * On a hit, the input is not even parsed. On a miss, the solutions are stored as soon as both parts have been
+     * solved. Options which change the solutions bypass the cache. Trusted parsing reads the entries stored by
+     * validating runs, but never stores any. The cache has to outlive the puzzle.
+     * \return nullptr if there is no implementation for the day
+     */
+    [[nodiscard]] std::unique_ptr<IPuzzle> CreatePuzzle(std::uint8_t day, std::string_view input,
+                                                        const PuzzleOptions &options = {});
+
+    [[nodiscard]] std::uint64_t hits() const noexcept { return hitCount.load(); }
+    [[nodiscard]] std::uint64_t misses() const noexcept { return missCount.load(); }
+    [[nodiscard]] std::uint64_t evictions() const noexcept { return evictionCount.load(); }
+    [[nodiscard]] const std::filesystem::path &directory() const noexcept { return cacheDirectory; }
+
+    /*! \brief Identifies an input without holding on to it. */
+    struct Key final
+    {
+        std::uint8_t day{};
+        std::uint64_t inputSize{};
+        std::uint64_t inputHash{};
+    };
+    [[nodiscard]] static Key make_key(std::uint8_t day, std::string_view input) noexcept;
+    [[nodiscard]] std::optional<IPuzzle::Solutions> Lookup(const Key &key);
+    void Store(const Key &key, const IPuzzle::Solutions &solutions);
+
+  private:
+    [[nodiscard]] std::filesystem::path entry_path(const Key &key) const;
+    void evict();
+
+    std::filesystem::path cacheDirectory;
+    std::uint64_t sizeLimit;
+    std::mutex mutex; //!< serializes the file accesses of this process
+    std::atomic<std::uint64_t> hitCount{0u};
+    std::atomic<std::uint64_t> missCount{0u};
+    std::atomic<std::uint64_t> evictionCount{0u};
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_RESULT_CACHE_HPP)
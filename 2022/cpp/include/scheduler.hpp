@@ -0,0 +1,129 @@
+#if !defined(AOC_Y2022_SCHEDULER_HPP)
+#define AOC_Y2022_SCHEDULER_HPP (1)
+
+#include "types.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+class WorkStealingPool;
+
+/*!
+ * \brief Work-stealing task scheduler which all parallel work of the library runs on.
+ *
+ * The calling thread always takes part in the work, so a scheduler with a single thread runs everything
+ * sequentially and starts no thread at all. Work may be started from within a task: waiting for it runs other
+ * tasks meanwhile instead of blocking a thread. If a task throws, the first exception is rethrown by run()
+ * once all started tasks have finished.
+ *
+ * Puzzles and the solve functions of PuzzleFactory use shared() unless they are given a scheduler, so parallel
+ * parsing, solving both parts concurrently and batches all draw from the same threads instead of oversubscribing.
+ */
+AOC_Y2022_API
+class Scheduler final
+{
+  public:
+    using IndexRange = std::pair<std::size_t, std::size_t>; //!< first index and one behind the last index
+
+    /*! \brief Creates a scheduler with threadCount threads including the caller, 0 selects one per core. */
+    explicit Scheduler(std::size_t threadCount = 0u);
+    ~Scheduler();
+    Scheduler(const Scheduler &) = delete;
+    Scheduler &operator=(const Scheduler &) = delete;
+    Scheduler(Scheduler &&) = delete;
+    Scheduler &operator=(Scheduler &&) = delete;
+
+    /*! \brief Scheduler of the process with one thread per core, created on first use. */
+    [[nodiscard]] static Scheduler &shared();
+    /*! \brief Returns the given scheduler, or the shared one for nullptr. */
+    [[nodiscard]] static Scheduler &resolve(Scheduler *pScheduler);
+    /*! \brief Number of threads available on this platform, at least 1. */
+    [[nodiscard]] static std::size_t hardware_thread_count() noexcept;
+
+    /*! \brief Number of threads running tasks, including the calling thread. */
+    [[nodiscard]] std::size_t thread_count() const noexcept;
+
+    /*! \brief Calls fnTask with every index below taskCount as a task of its own and waits for all of them. */
+    void run(std::size_t taskCount, const std::function<void(std::size_t)> &fnTask);
+
+    /*!
+     * \brief Number of chunks an index range of the given size is split into.
+     *
+     * A few chunks per thread keep all threads busy even if some indices take longer; every chunk holds at least
+     * grainSize indices.
+     */
+    [[nodiscard]] std::size_t chunk_count(std::size_t size, std::size_t grainSize = 1u) const noexcept;
+    /*! \brief Bounds of one of chunkCount chunks of about the same size which [first, last) is split into. */
+    [[nodiscard]] static constexpr IndexRange chunk_of(const std::size_t first, const std::size_t last,
+                                                       const std::size_t chunk, const std::size_t chunkCount) noexcept
+    {
+        const auto size = last - first;
+        return {first + ((size * chunk) / chunkCount), first + ((size * (chunk + 1u)) / chunkCount)};
+    }
+
+    /*! \brief Calls fnRange(begin, end) on consecutive chunks covering [first, last) in parallel. */
+    template <typename FnRange>
+    void parallel_for(const std::size_t first, const std::size_t last, const FnRange &fnRange,
+                      const std::size_t grainSize = 1u)
+    {
+        if (first >= last)
+        {
+            return;
+        }
+        const auto chunks = chunk_count(last - first, grainSize);
+        run(chunks, [first, last, chunks, &fnRange](const std::size_t chunk) {
+            const auto [begin, end] = chunk_of(first, last, chunk, chunks);
+            fnRange(begin, end);
+        });
+    }
+
+    /*!
+     * \brief Maps consecutive chunks of [first, last) with fnRange(begin, end) in parallel and combines the results.
+     *
+     * The partial results are combined from left to right on the calling thread, so fnCombine only has to be
+     * associative and the result does not depend on the number of threads.
+     */
+    template <typename T, typename FnRange, typename FnCombine>
+    [[nodiscard]] T parallel_reduce(const std::size_t first, const std::size_t last, T identity,
+                                    const FnRange &fnRange, const FnCombine &fnCombine,
+                                    const std::size_t grainSize = 1u)
+    {
+        if (first >= last)
+        {
+            return identity;
+        }
+        const auto chunks = chunk_count(last - first, grainSize);
+        std::vector<T> partialResults(chunks, identity);
+        run(chunks, [first, last, chunks, &fnRange, &partialResults](const std::size_t chunk) {
+            const auto [begin, end] = chunk_of(first, last, chunk, chunks);
+            partialResults[chunk] = fnRange(begin, end);
+        });
+        for (auto &partialResult : partialResults)
+        {
+            identity = fnCombine(std::move(identity), std::move(partialResult));
+        }
+        return identity;
+    }
+
+    /*! \brief Runs all tasks in parallel and waits for them. */
+    void fork_join(std::span<const std::function<void()>> tasks);
+    template <typename... Fns> void fork_join(Fns &&...fns)
+    {
+        const std::function<void()> tasks[]{std::forward<Fns>(fns)...};
+        fork_join(std::span<const std::function<void()>>{tasks});
+    }
+
+  private:
+    std::unique_ptr<WorkStealingPool> pPool;
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_SCHEDULER_HPP)
@@ -0,0 +1,608 @@
+#include "input_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+/*!
+ * \brief SplitMix64 pseudo random number generator.
+ *
+ * The standard library engines are portable, but the distributions are not, so the generators only use this
+ * class to derive values from the seed.
+ */
+class Random final
+{
+  public:
+    explicit Random(const std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next()
+    {
+        state += 0x9E37'79B9'7F4A'7C15ull;
+        auto z = state;
+        z = (z ^ (z >> 30u)) * 0xBF58'476D'1CE4'E5B9ull;
+        z = (z ^ (z >> 27u)) * 0x94D0'49BB'1331'11EBull;
+        return z ^ (z >> 31u);
+    }
+
+    /*! \brief Returns a value in the closed range [lo, hi]. */
+    std::uint64_t uniform(const std::uint64_t lo, const std::uint64_t hi)
+    {
+        return lo + (next() % (hi - lo + 1u));
+    }
+
+    template <typename T> void shuffle(T &container)
+    {
+        for (auto idx = container.size(); idx > 1u; --idx)
+        {
+            const auto other = static_cast<std::size_t>(uniform(0u, idx - 1u));
+            std::swap(container[idx - 1u], container[other]);
+        }
+    }
+
+  private:
+    std::uint64_t state;
+};
+
+/*!
+ * \brief Buffers the generated text, so that even inputs with billions of lines are written in large blocks.
+ */
+class Writer final
+{
+  public:
+    explicit Writer(std::ostream &out) : out(out)
+    {
+        buffer.reserve(flushThreshold + 256u);
+    }
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+    ~Writer()
+    {
+        flush();
+    }
+
+    Writer &put(const char c)
+    {
+        buffer.push_back(c);
+        return flush_if_full();
+    }
+
+    Writer &put(const std::string_view str)
+    {
+        buffer.append(str);
+        return flush_if_full();
+    }
+
+    Writer &put_number(const std::int64_t number)
+    {
+        std::array<char, 24u> digits{};
+        const auto [end, ec] = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+        buffer.append(digits.data(), end);
+        return flush_if_full();
+    }
+
+    void end_line()
+    {
+        put('\n');
+    }
+
+    void flush()
+    {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+
+  private:
+    Writer &flush_if_full()
+    {
+        if (buffer.size() >= flushThreshold)
+        {
+            flush();
+        }
+        return *this;
+    }
+
+    static constexpr std::size_t flushThreshold = 1u << 16u;
+    std::ostream &out;
+    std::string buffer;
+};
+
+[[nodiscard]] std::int64_t as_number(const std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value);
+}
+
+void generate_day01(Random &random, const std::uint64_t size, Writer &writer)
+{
+    const auto lines = std::max<std::uint64_t>(size, 2u);
+    for (std::uint64_t written = 0u; written < lines;)
+    {
+        const auto groupSize = random.uniform(1u, 15u);
+        for (std::uint64_t item = 0u; (item < groupSize) && (written < lines); ++item, ++written)
+        {
+            writer.put_number(as_number(random.uniform(1'000u, 60'000u))).end_line();
+        }
+        // only separate groups if there is room for at least one more item
+        if ((written + 1u) < lines)
+        {
+            writer.end_line();
+            ++written;
+        }
+    }
+}
+
+void generate_day02(Random &random, const std::uint64_t size, Writer &writer)
+{
+    const auto lines = std::max<std::uint64_t>(size, 2u);
+    for (std::uint64_t line = 0u; line < lines; ++line)
+    {
+        writer.put(static_cast<char>('A' + random.uniform(0u, 2u)))
+            .put(' ')
+            .put(static_cast<char>('X' + random.uniform(0u, 2u)))
+            .end_line();
+    }
+}
+
+void generate_day03(Random &random, const std::uint64_t size, Writer &writer)
+{
+    // Each group of three elves draws its items from three disjoint pools of 17 item types plus the badge.
+    // Thus, the badge is the only item type all three rucksacks share. Within a rucksack, the two
+    // compartments use disjoint halves of the pool and only share one item type.
+    constexpr std::size_t itemTypes = 52u;
+    constexpr std::size_t groupSize = 3u;
+    constexpr std::size_t poolSize = (itemTypes - 1u) / groupSize;
+    const auto toChar = [](const std::uint8_t item) {
+        return (item < 26u) ? static_cast<char>('a' + item) : static_cast<char>('A' + (item - 26u));
+    };
+    const auto groups = (std::max<std::uint64_t>(size, groupSize) + groupSize - 1u) / groupSize;
+    std::array<std::uint8_t, itemTypes> allItems{};
+    std::iota(allItems.begin(), allItems.end(), std::uint8_t{0u});
+    std::string compartment1;
+    std::string compartment2;
+    for (std::uint64_t group = 0u; group < groups; ++group)
+    {
+        random.shuffle(allItems);
+        const auto badge = allItems.back();
+        for (std::size_t elf = 0u; elf < groupSize; ++elf)
+        {
+            std::vector<std::uint8_t> pool(allItems.begin() + static_cast<std::ptrdiff_t>(elf * poolSize),
+                                           allItems.begin() + static_cast<std::ptrdiff_t>((elf + 1u) * poolSize));
+            pool.push_back(badge);
+            random.shuffle(pool);
+            const auto shared = pool.front();
+            const auto half = pool.size() / 2u;
+            const auto compartmentSize = static_cast<std::size_t>(random.uniform(2u, 16u));
+            const auto fill = [&](std::string &compartment, const std::size_t first, const std::size_t last) {
+                compartment.assign(1u, toChar(shared));
+                while (compartment.size() < compartmentSize)
+                {
+                    compartment.push_back(toChar(pool[static_cast<std::size_t>(random.uniform(first, last - 1u))]));
+                }
+            };
+            fill(compartment1, 1u, half);
+            fill(compartment2, half, pool.size());
+            if (badge != shared)
+            {
+                const auto badgePosition = std::find(pool.begin(), pool.end(), badge) - pool.begin();
+                auto &compartment = (static_cast<std::size_t>(badgePosition) < half) ? compartment1 : compartment2;
+                compartment[1u] = toChar(badge);
+            }
+            random.shuffle(compartment1);
+            random.shuffle(compartment2);
+            writer.put(compartment1).put(compartment2).end_line();
+        }
+    }
+}
+
+void generate_day04(Random &random, const std::uint64_t size, Writer &writer)
+{
+    const auto lines = std::max<std::uint64_t>(size, 2u);
+    for (std::uint64_t line = 0u; line < lines; ++line)
+    {
+        const auto start1 = random.uniform(1u, 99u);
+        const auto end1 = random.uniform(start1, 99u);
+        const auto start2 = random.uniform(1u, 99u);
+        const auto end2 = random.uniform(start2, 99u);
+        writer.put_number(as_number(start1)).put('-').put_number(as_number(end1)).put(',');
+        writer.put_number(as_number(start2)).put('-').put_number(as_number(end2)).end_line();
+    }
+}
+
+void generate_day05(Random &random, const std::uint64_t size, Writer &writer)
+{
+    constexpr std::size_t numStacks = 9u;
+    std::array<std::uint64_t, numStacks> heights{};
+    for (auto &height : heights)
+    {
+        height = random.uniform(0u, 8u);
+    }
+    heights[static_cast<std::size_t>(random.uniform(0u, numStacks - 1u))] += 1u;
+    const auto maxHeight = *std::max_element(heights.begin(), heights.end());
+    for (auto level = maxHeight; level > 0u; --level)
+    {
+        for (std::size_t stack = 0u; stack < numStacks; ++stack)
+        {
+            if (stack > 0u)
+            {
+                writer.put(' ');
+            }
+            if (heights[stack] >= level)
+            {
+                writer.put('[').put(static_cast<char>('A' + random.uniform(0u, 25u))).put(']');
+            }
+            else
+            {
+                writer.put("   ");
+            }
+        }
+        writer.end_line();
+    }
+    for (std::size_t stack = 0u; stack < numStacks; ++stack)
+    {
+        writer.put((stack > 0u) ? "  " : " ").put(static_cast<char>('1' + stack)).put(' ');
+    }
+    writer.end_line();
+    writer.end_line();
+
+    const auto moves = std::max<std::uint64_t>(size, 1u);
+    for (std::uint64_t move = 0u; move < moves; ++move)
+    {
+        std::size_t source{};
+        do
+        {
+            source = static_cast<std::size_t>(random.uniform(0u, numStacks - 1u));
+        } while (heights[source] == 0u);
+        auto destination = static_cast<std::size_t>(random.uniform(0u, numStacks - 2u));
+        if (destination >= source)
+        {
+            ++destination;
+        }
+        const auto quantity = random.uniform(1u, std::min<std::uint64_t>(heights[source], 12u));
+        heights[source] -= quantity;
+        heights[destination] += quantity;
+        writer.put("move ").put_number(as_number(quantity));
+        writer.put(" from ").put_number(as_number(source + 1u));
+        writer.put(" to ").put_number(as_number(destination + 1u)).end_line();
+    }
+}
+
+void generate_day06(Random &random, const std::uint64_t size, Writer &writer)
+{
+    // A body of only three different letters cannot contain a marker, so both markers are found in the
+    // last characters, and solvers have to scan the whole input.
+    constexpr std::size_t longestMarker = 14u;
+    const auto length = std::max<std::uint64_t>(size, longestMarker);
+    for (std::uint64_t pos = longestMarker; pos < length; ++pos)
+    {
+        writer.put(static_cast<char>('a' + random.uniform(0u, 2u)));
+    }
+    std::string tail{"defghijklmnopq"};
+    random.shuffle(tail);
+    writer.put(tail).end_line();
+}
+
+void generate_day07(Random &random, const std::uint64_t size, Writer &writer)
+{
+    // Every directory is listed exactly once before it is entered. The file sizes add up to 50'000'000, so
+    // that the update (part 2) always requires deleting a directory. A dedicated subdirectory of the root,
+    // which is visited last, receives the remainder.
+    constexpr std::int64_t totalSize = 50'000'000;
+    constexpr std::int64_t randomFilesLimit = 45'000'000;
+    constexpr std::size_t maxDepth = 16u;
+    auto remainingLines = static_cast<std::int64_t>(std::max<std::uint64_t>(size, 10u));
+    const auto expectedFiles = std::max<std::int64_t>(remainingLines * 3 / 10, 1);
+    const auto meanFileSize = std::max<std::int64_t>((randomFilesLimit * 2 / 3) / expectedFiles, 1);
+    std::int64_t usedSpace = 0;
+    std::uint64_t nameCounter = 0u;
+    constexpr std::array<std::string_view, 4u> extensions{"", ".txt", ".dat", ".log"};
+
+    const auto putLine = [&writer, &remainingLines](const std::string_view line) {
+        writer.put(line).end_line();
+        --remainingLines;
+    };
+    const auto visit = [&](const std::size_t depth, auto &&recursion) -> void {
+        putLine("$ ls");
+        if (depth == 0u)
+        {
+            putLine("dir remainder");
+        }
+        std::vector<std::uint64_t> subdirectories;
+        const auto numSubdirectories = ((depth < maxDepth) && (remainingLines > 8)) ? random.uniform(1u, 4u) : 0u;
+        for (std::uint64_t idx = 0u; idx < numSubdirectories; ++idx)
+        {
+            subdirectories.push_back(nameCounter++);
+            writer.put("dir d").put_number(as_number(subdirectories.back())).end_line();
+            --remainingLines;
+        }
+        const auto numFiles = random.uniform(0u, 5u);
+        for (std::uint64_t idx = 0u; idx < numFiles; ++idx)
+        {
+            auto fileSize = as_number(random.uniform(1u, static_cast<std::uint64_t>(2 * meanFileSize)));
+            if ((usedSpace + fileSize) > randomFilesLimit)
+            {
+                fileSize = 1;
+            }
+            usedSpace += fileSize;
+            writer.put_number(fileSize).put(" f").put_number(as_number(nameCounter++));
+            writer.put(extensions[static_cast<std::size_t>(random.uniform(0u, extensions.size() - 1u))]).end_line();
+            --remainingLines;
+        }
+        for (const auto subdirectory : subdirectories)
+        {
+            writer.put("$ cd d").put_number(as_number(subdirectory)).end_line();
+            --remainingLines;
+            recursion(depth + 1u, recursion);
+            putLine("$ cd ..");
+        }
+    };
+
+    putLine("$ cd /");
+    visit(0u, visit);
+    putLine("$ cd remainder");
+    putLine("$ ls");
+    writer.put_number(totalSize - usedSpace).put(" remainder.dat").end_line();
+}
+
+void generate_day08(Random &random, const std::uint64_t size, Writer &writer)
+{
+    const auto width = std::max<std::uint64_t>(size, 2u);
+    for (std::uint64_t row = 0u; row < width; ++row)
+    {
+        for (std::uint64_t col = 0u; col < width; ++col)
+        {
+            writer.put(static_cast<char>('0' + random.uniform(0u, 9u)));
+        }
+        writer.end_line();
+    }
+}
+
+void generate_day09(Random &random, const std::uint64_t size, Writer &writer)
+{
+    constexpr std::string_view directions{"URLD"};
+    const auto lines = std::max<std::uint64_t>(size, 1u);
+    for (std::uint64_t line = 0u; line < lines; ++line)
+    {
+        writer.put(directions[static_cast<std::size_t>(random.uniform(0u, directions.size() - 1u))]).put(' ');
+        writer.put_number(as_number(random.uniform(1u, 20u))).end_line();
+    }
+}
+
+void generate_day10(Random &random, const std::uint64_t size, Writer &writer)
+{
+    // keep the register close to the display, like the original puzzle inputs
+    const auto lines = std::max<std::uint64_t>(size, 1u);
+    std::int64_t cpuRegister = 1;
+    for (std::uint64_t line = 0u; line < lines; ++line)
+    {
+        if (random.uniform(0u, 2u) == 0u)
+        {
+            writer.put("noop").end_line();
+            continue;
+        }
+        const auto magnitude = as_number(random.uniform(1u, 15u));
+        const bool decrease = (cpuRegister > 30) || ((cpuRegister >= 0) && (random.uniform(0u, 1u) == 0u));
+        const auto operand = decrease ? -magnitude : magnitude;
+        cpuRegister += operand;
+        writer.put("addx ").put_number(operand).end_line();
+    }
+}
+
+void generate_day11(Random &random, const std::uint64_t size, Writer &writer)
+{
+    struct MonkeyTemplate final
+    {
+        char operation;
+        std::int64_t operand; // 0: "old"
+        std::int64_t divisor;
+        std::uint64_t targetIfTrue;
+        std::uint64_t targetIfFalse;
+    };
+    static constexpr std::array<MonkeyTemplate, 8u> monkeys{
+        MonkeyTemplate{'*', 5, 11, 2u, 3u}, MonkeyTemplate{'*', 11, 5, 4u, 0u},
+        MonkeyTemplate{'+', 2, 19, 5u, 6u}, MonkeyTemplate{'+', 5, 13, 2u, 6u},
+        MonkeyTemplate{'*', 0, 7, 0u, 3u},  MonkeyTemplate{'+', 4, 17, 7u, 1u},
+        MonkeyTemplate{'+', 6, 2, 7u, 5u},  MonkeyTemplate{'+', 7, 3, 4u, 1u},
+    };
+    // Worry levels only shrink by division in part 1. Some starting values end up being squared again and
+    // again, which would overflow 64 bit integers. Only hand out values, which survive the 20 rounds.
+    const auto survivesPart1 = [](std::size_t monkey, std::int64_t worries) {
+        for (std::size_t round = 0u; round < 20u;)
+        {
+            const auto &m = monkeys[monkey];
+            const auto operand = (m.operand == 0) ? worries : m.operand;
+            if ((m.operation == '*') && (worries > (std::numeric_limits<std::int64_t>::max() / operand)))
+            {
+                return false;
+            }
+            worries = ((m.operation == '*') ? (worries * operand) : (worries + operand)) / 3;
+            const auto target = static_cast<std::size_t>(((worries % m.divisor) == 0) ? m.targetIfTrue : m.targetIfFalse);
+            round += (target < monkey) ? 1u : 0u;
+            monkey = target;
+        }
+        return true;
+    };
+    std::array<std::vector<std::int64_t>, monkeys.size()> safeValues{};
+    for (std::size_t monkey = 0u; monkey < monkeys.size(); ++monkey)
+    {
+        for (std::int64_t worries = 50; worries < 100; ++worries)
+        {
+            if (survivesPart1(monkey, worries))
+            {
+                safeValues[monkey].push_back(worries);
+            }
+        }
+    }
+
+    const auto numItems = std::max<std::uint64_t>(size, monkeys.size());
+    std::array<std::uint64_t, monkeys.size()> itemsPerMonkey{};
+    itemsPerMonkey.fill(1u);
+    for (std::uint64_t item = monkeys.size(); item < numItems; ++item)
+    {
+        ++itemsPerMonkey[static_cast<std::size_t>(random.uniform(0u, monkeys.size() - 1u))];
+    }
+    for (std::size_t monkey = 0u; monkey < monkeys.size(); ++monkey)
+    {
+        const auto &m = monkeys[monkey];
+        const auto &values = safeValues[monkey];
+        if (monkey > 0u)
+        {
+            writer.end_line();
+        }
+        writer.put("Monkey ").put_number(as_number(monkey)).put(':').end_line();
+        writer.put("  Starting items: ");
+        for (std::uint64_t item = 0u; item < itemsPerMonkey[monkey]; ++item)
+        {
+            writer.put((item > 0u) ? ", " : "");
+            writer.put_number(values[static_cast<std::size_t>(random.uniform(0u, values.size() - 1u))]);
+        }
+        writer.end_line();
+        writer.put("  Operation: new = old ").put(m.operation).put(' ');
+        if (m.operand == 0)
+        {
+            writer.put("old");
+        }
+        else
+        {
+            writer.put_number(m.operand);
+        }
+        writer.end_line();
+        writer.put("  Test: divisible by ").put_number(m.divisor).end_line();
+        writer.put("    If true: throw to monkey ").put_number(as_number(m.targetIfTrue)).end_line();
+        writer.put("    If false: throw to monkey ").put_number(as_number(m.targetIfFalse)).end_line();
+    }
+}
+
+void generate_day12(Random &random, const std::uint64_t size, Writer &writer)
+{
+    // A path along the top row and down the rightmost column climbs steadily from S (top left) to
+    // E (bottom right), so there always is a solution. All other squares are random.
+    constexpr std::uint64_t minWidth = 26u;
+    const auto width = std::max<std::uint64_t>(size, minWidth);
+    const auto pathSteps = (2u * width) - 2u;
+    const auto pathHeight = [pathSteps](const std::uint64_t step) {
+        return static_cast<char>('a' + ((25u * step) / pathSteps));
+    };
+    for (std::uint64_t row = 0u; row < width; ++row)
+    {
+        for (std::uint64_t col = 0u; col < width; ++col)
+        {
+            if ((row == 0u) && (col == 0u))
+            {
+                writer.put('S');
+            }
+            else if ((row == (width - 1u)) && (col == (width - 1u)))
+            {
+                writer.put('E');
+            }
+            else if (row == 0u)
+            {
+                writer.put(pathHeight(col));
+            }
+            else if (col == (width - 1u))
+            {
+                writer.put(pathHeight(width - 1u + row));
+            }
+            else
+            {
+                writer.put(static_cast<char>('a' + random.uniform(0u, 25u)));
+            }
+        }
+        writer.end_line();
+    }
+}
+
+void generate_day17(Random &random, const std::uint64_t size, Writer &writer)
+{
+    const auto length = std::max<std::uint64_t>(size, 1u);
+    for (std::uint64_t pos = 0u; pos < length; ++pos)
+    {
+        writer.put((random.uniform(0u, 1u) == 0u) ? '<' : '>');
+    }
+    writer.end_line();
+}
+
+using GeneratorFunction = void (*)(Random &, std::uint64_t, Writer &);
+
+[[nodiscard]] GeneratorFunction get_generator(const std::uint8_t day)
+{
+    switch (day)
+    {
+    case 1u:
+        return generate_day01;
+    case 2u:
+        return generate_day02;
+    case 3u:
+        return generate_day03;
+    case 4u:
+        return generate_day04;
+    case 5u:
+        return generate_day05;
+    case 6u:
+        return generate_day06;
+    case 7u:
+        return generate_day07;
+    case 8u:
+        return generate_day08;
+    case 9u:
+        return generate_day09;
+    case 10u:
+        return generate_day10;
+    case 11u:
+        return generate_day11;
+    case 12u:
+        return generate_day12;
+    case 17u:
+        return generate_day17;
+    default:
+        return nullptr;
+    }
+}
+
+} // namespace
+
+[[nodiscard]] bool InputGenerator::has_generator_for_day(const std::uint8_t day)
+{
+    return get_generator(day) != nullptr;
+}
+
+bool InputGenerator::Generate(const std::uint8_t day, const Settings &settings, std::ostream &out)
+{
+    const auto generator = get_generator(day);
+    if (generator == nullptr)
+    {
+        return false;
+    }
+    // different days must not share their random sequence for the same seed
+    Random random{settings.seed ^ (0xA0C2'0220'0000'0000ull + day)};
+    {
+        Writer writer{out};
+        generator(random, settings.size, writer);
+    }
+    return out.good();
+}
+
+[[nodiscard]] std::string InputGenerator::Generate(const std::uint8_t day, const Settings &settings)
+{
+    std::ostringstream out;
+    if (!Generate(day, settings, out))
+    {
+        return {};
+    }
+    return std::move(out).str();
+}
+
+} // namespace AOC::Y2022
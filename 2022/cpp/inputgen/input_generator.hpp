@@ -0,0 +1,50 @@
+#if !defined(AOC_Y2022_INPUT_GENERATOR_HPP)
+#define AOC_Y2022_INPUT_GENERATOR_HPP (1)
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Generates synthetic, valid puzzle inputs of arbitrary size.
+ *
+ * The output only depends on the day, the size and the seed, so a given triple always produces the same
+ * bytes on every platform. The meaning of `size` depends on the day:
+ *
+ * | day | size                                   |
+ * |-----|----------------------------------------|
+ * | 01  | lines (calorie items and separators)   |
+ * | 02  | lines                                  |
+ * | 03  | lines (rounded up to groups of three)  |
+ * | 04  | lines                                  |
+ * | 05  | move instructions                      |
+ * | 06  | characters (at least 14)               |
+ * | 07  | terminal lines (approximately)         |
+ * | 08  | width and height of the forest         |
+ * | 09  | lines                                  |
+ * | 10  | lines (part 2 needs at most 240 cycles)|
+ * | 11  | starting items, spread over 8 monkeys  |
+ * | 12  | width and height of the map (min. 26)  |
+ * | 17  | jet pattern characters                 |
+ */
+class InputGenerator final
+{
+  public:
+    struct Settings final
+    {
+        std::uint64_t size{1000u};
+        std::uint64_t seed{2022u};
+    };
+
+  public:
+    [[nodiscard]] static bool has_generator_for_day(std::uint8_t day);
+    static bool Generate(std::uint8_t day, const Settings &settings, std::ostream &out);
+    [[nodiscard]] static std::string Generate(std::uint8_t day, const Settings &settings);
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_INPUT_GENERATOR_HPP)
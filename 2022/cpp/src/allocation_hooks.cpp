@@ -0,0 +1,211 @@
+// Replaces the global allocation functions to feed the AllocationTracker. This file is not part of
+// aoc_y2022_core: executables opt in by linking the aoc_y2022_allocation_hooks object library.
+#include "puzzle_instrumentation.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace
+{
+
+// every block starts with a header holding its size, so that operator delete knows how much is released
+constexpr std::size_t headerSize = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+static_assert(headerSize >= sizeof(std::size_t));
+
+void *allocate(const std::size_t size) noexcept
+{
+    auto *const pBlock = static_cast<unsigned char *>(std::malloc(size + headerSize));
+    if (pBlock == nullptr)
+    {
+        return nullptr;
+    }
+    *reinterpret_cast<std::size_t *>(pBlock) = size;
+    AOC::Y2022::AllocationTracker::on_allocate(size);
+    return pBlock + headerSize;
+}
+
+// over-aligned blocks are cut out of a larger one, their header also remembers where that one starts
+struct AlignedHeader final
+{
+    unsigned char *pBlock;
+    std::size_t size;
+};
+
+void *allocate_aligned(const std::size_t size, const std::align_val_t alignment) noexcept
+{
+    const auto align = std::max(static_cast<std::size_t>(alignment), alignof(AlignedHeader));
+    if (size > (std::numeric_limits<std::size_t>::max() - sizeof(AlignedHeader) - align))
+    {
+        return nullptr;
+    }
+    auto *const pBlock = static_cast<unsigned char *>(std::malloc(size + sizeof(AlignedHeader) + align - 1u));
+    if (pBlock == nullptr)
+    {
+        return nullptr;
+    }
+    const auto first = reinterpret_cast<std::uintptr_t>(pBlock + sizeof(AlignedHeader));
+    auto *const ptr = pBlock + (sizeof(AlignedHeader) + (((align - (first % align)) % align)));
+    *reinterpret_cast<AlignedHeader *>(ptr - sizeof(AlignedHeader)) = AlignedHeader{.pBlock = pBlock, .size = size};
+    AOC::Y2022::AllocationTracker::on_allocate(size);
+    return ptr;
+}
+
+template <typename... Alignment> void *allocate_or_throw(const std::size_t size, const Alignment... alignment)
+{
+    while (true)
+    {
+        void *ptr = nullptr;
+        if constexpr (sizeof...(Alignment) == 0u)
+        {
+            ptr = allocate(size);
+        }
+        else
+        {
+            ptr = allocate_aligned(size, alignment...);
+        }
+        if (ptr != nullptr)
+        {
+            return ptr;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr)
+        {
+            throw std::bad_alloc{};
+        }
+        handler();
+    }
+}
+
+void deallocate(void *const ptr) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    auto *const pBlock = static_cast<unsigned char *>(ptr) - headerSize;
+    AOC::Y2022::AllocationTracker::on_deallocate(*reinterpret_cast<const std::size_t *>(pBlock));
+    std::free(pBlock);
+}
+
+void deallocate_aligned(void *const ptr) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    const auto *const pHeader = static_cast<unsigned char *>(ptr) - sizeof(AlignedHeader);
+    const auto header = *reinterpret_cast<const AlignedHeader *>(pHeader);
+    AOC::Y2022::AllocationTracker::on_deallocate(header.size);
+    std::free(header.pBlock);
+}
+
+[[maybe_unused]] const bool installed = []() {
+    AOC::Y2022::AllocationTracker::mark_installed();
+    return true;
+}();
+
+} // namespace
+
+void *operator new(const std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void *operator new[](const std::size_t size)
+{
+    return allocate_or_throw(size);
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void *const ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void *const ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void *const ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void *const ptr, std::size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void *const ptr, const std::nothrow_t &) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void *const ptr, const std::nothrow_t &) noexcept
+{
+    deallocate(ptr);
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    return allocate_or_throw(size, alignment);
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return allocate_or_throw(size, alignment);
+}
+
+void *operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate_aligned(size, alignment);
+}
+
+void *operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *const ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void *const ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void *const ptr, std::size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void *const ptr, std::size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void *const ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void *const ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    deallocate_aligned(ptr);
+}
@@ -0,0 +1,52 @@
+#include "puzzle_instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+// plain aggregates only: they are touched from within operator new and must not allocate themselves
+thread_local AllocationTracker::Counters threadCounters{};
+std::atomic<bool> hooksInstalled{false};
+
+} // namespace
+
+void AllocationTracker::on_allocate(const std::size_t bytes) noexcept
+{
+    auto &counters = threadCounters;
+    ++counters.allocations;
+    counters.bytesAllocated += bytes;
+    counters.currentBytes += static_cast<std::int64_t>(bytes);
+    counters.peakBytes = std::max(counters.peakBytes, counters.currentBytes);
+}
+
+void AllocationTracker::on_deallocate(const std::size_t bytes) noexcept
+{
+    threadCounters.currentBytes -= static_cast<std::int64_t>(bytes);
+}
+
+void AllocationTracker::mark_installed() noexcept
+{
+    hooksInstalled.store(true, std::memory_order_relaxed);
+}
+
+bool AllocationTracker::is_installed() noexcept
+{
+    return hooksInstalled.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Counters AllocationTracker::snapshot() noexcept
+{
+    return threadCounters;
+}
+
+void AllocationTracker::reset_peak() noexcept
+{
+    threadCounters.peakBytes = threadCounters.currentBytes;
+}
+
+} // namespace AOC::Y2022
@@ -1,8 +1,11 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <ranges>
@@ -14,76 +17,388 @@ namespace AOC::Y2022
 {
 
 namespace {
-    using Calories = std::uint32_t;
+    /*!
+     * \brief Calories of an item or a sum of items.
+     *
+     * Items and sums saturate instead of wrapping around, the largest value marks calories which are too many to be
+     * a solution.
+     */
+    using Calories = std::uint64_t;
 
-    AOC_Y2022_CONSTEXPR auto parse_input(std::string_view input_string_view)
+    /*! \brief Parses an item, numbers which exceed 64 bits saturate. */
+    AOC_Y2022_CONSTEXPR Calories parse_calories(const std::string_view line)
     {
-        return parse_to_vector_of_numbers<Calories, '\n'>(input_string_view);
+        Calories calories{};
+        return parse_decimal_checked(line, calories) ? calories : std::numeric_limits<Calories>::max();
     }
 
-    AOC_Y2022_CONSTEXPR auto get_elf_list(const auto &parsedInput)
+    /*! \brief No solution if the calories exceed the range of a solution. */
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t to_solution(const Calories calories)
     {
-        std::vector<Calories> elfCalories;
-        elfCalories.push_back(0u);
-        for(const auto &food_item_calories : parsedInput)
+        if (calories > static_cast<Calories>(std::numeric_limits<std::int64_t>::max()))
         {
-            if (food_item_calories == 0u)
+            return std::monostate{};
+        }
+        return static_cast<std::int64_t>(calories);
+    }
+
+    /*!
+     * \brief Folds the items into the sums of the elves on the fly, keeping only the elves carrying the most calories
+     *        in a min-heap of fixed size.
+     *
+     * Its memory grows with the number of elves asked for, not with the input.
+     */
+    class TopElves final {
+    public:
+        AOC_Y2022_CONSTEXPR explicit TopElves(const std::size_t count, const ResourceAllocator<Calories> &allocator = {})
+            : count(count), heap(allocator)
+        {
+            heap.reserve(count);
+        }
+
+        /*! \brief Adds the calories of an item to the current elf, no calories finish the elf. */
+        AOC_Y2022_CONSTEXPR void add_item(const Calories calories)
+        {
+            if (calories == 0u)
             {
-                elfCalories.push_back(0u);
-                continue;
+                finish_elf();
+                return;
+            }
+            currentElf = add_saturated(currentElf, calories);
+        }
+
+        AOC_Y2022_CONSTEXPR void finish_elf()
+        {
+            add_elf(currentElf);
+            currentElf = 0u;
+        }
+
+        AOC_Y2022_CONSTEXPR void add_elf(const Calories calories)
+        {
+            mostCalories = std::max(mostCalories, calories);
+            // the elf with the fewest calories of the top elves is in front, the one to be replaced next
+            if (heap.size() < count)
+            {
+                heap.push_back(calories);
+                std::push_heap(heap.begin(), heap.end(), std::greater());
+                return;
             }
-            elfCalories.back() += food_item_calories;
+            if (!heap.empty() && (calories > heap.front()))
+            {
+                std::pop_heap(heap.begin(), heap.end(), std::greater());
+                heap.back() = calories;
+                std::push_heap(heap.begin(), heap.end(), std::greater());
+            }
+        }
+
+        /*! \brief Adds the elves of other, which has to keep the same count of elves. */
+        AOC_Y2022_CONSTEXPR void merge(const TopElves &other)
+        {
+            mostCalories = std::max(mostCalories, other.mostCalories);
+            for (const auto calories : other.heap)
+            {
+                add_elf(calories);
+            }
+        }
+
+        [[nodiscard]] AOC_Y2022_CONSTEXPR Calories most() const { return mostCalories; }
+        /*! \brief Sum of the top elves, elves missing to their count carry nothing. */
+        [[nodiscard]] AOC_Y2022_CONSTEXPR Calories sum() const
+        {
+            return std::accumulate(heap.begin(), heap.end(), Calories{}, add_saturated<Calories>);
+        }
+
+    private:
+        std::size_t count;
+        ResourceVector<Calories> heap;
+        Calories currentElf{};
+        Calories mostCalories{};
+    };
+
+    /*!
+     * \brief Elves found in the lines of a part of the input.
+     *
+     * The elves cut off at both ends of the part may continue in the neighbouring parts, so they are summed up
+     * separately until the parts are combined.
+     */
+    struct Elves final {
+        TopElves top;     //!< elves which begin and end within the part
+        std::size_t numberOfItems{};
+        Calories first{}; //!< items in front of the first separator
+        Calories last{};  //!< items behind the last separator
+        bool separated{}; //!< false if all items of the part belong to first
+
+        /*! \brief Adds the elves at both ends, once the part covers the whole input. */
+        AOC_Y2022_CONSTEXPR void finish()
+        {
+            top.add_elf(first);
+            if (separated)
+            {
+                top.add_elf(last);
+            }
+        }
+    };
+
+    /*!
+     * \brief Sums up the lines starting within [begin, end).
+     *
+     * A line holds the calories of one item, or nothing between two elves. The last line may reach behind end.
+     */
+    AOC_Y2022_CONSTEXPR void sum_up_lines(const std::string_view input, std::size_t begin, const std::size_t end,
+                                          Elves &elves)
+    {
+        if ((begin != 0u) && (input[begin - 1u] != '\n'))
+        {
+            begin = std::min(input.find('\n', begin), input.size() - 1u) + 1u;
+        }
+        for (auto lineBegin = begin; lineBegin < end;)
+        {
+            ++elves.numberOfItems;
+            const auto calories = parse_calories(input.substr(lineBegin));
+            if (calories == 0u)
+            {
+                if (elves.separated)
+                {
+                    elves.top.add_elf(elves.last);
+                }
+                elves.separated = true;
+                elves.last = 0u;
+            }
+            else
+            {
+                auto &elf = elves.separated ? elves.last : elves.first;
+                elf = add_saturated(elf, calories);
+            }
+            const auto lf = input.find('\n', lineBegin);
+            if (lf == std::string_view::npos)
+            {
+                break;
+            }
+            lineBegin = lf + 1u;
         }
-        return elfCalories;
     }
 
-    AOC_Y2022_CONSTEXPR auto part_1(const auto &parsedInput)
+    /*! \brief Joins the elves of two adjacent parts, the elf cut by the boundary between them is made whole. */
+    AOC_Y2022_CONSTEXPR Elves combine(Elves left, const Elves &right)
     {
-        const auto elfCalories = get_elf_list(parsedInput);
-        return *std::max_element(elfCalories.begin(), elfCalories.end());
+        left.numberOfItems += right.numberOfItems;
+        if (!right.separated)
+        {
+            auto &elf = left.separated ? left.last : left.first;
+            elf = add_saturated(elf, right.first);
+            return left;
+        }
+        if (left.separated)
+        {
+            left.top.add_elf(add_saturated(left.last, right.first));
+        }
+        else
+        {
+            left.first = add_saturated(left.first, right.first);
+        }
+        left.top.merge(right.top);
+        left.last = right.last;
+        left.separated = true;
+        return left;
+    }
+
+    AOC_Y2022_CONSTEXPR Elves sum_up(const std::string_view input, const std::size_t topElfCount,
+                                     const ResourceAllocator<Calories> &allocator = {})
+    {
+        Elves elves{.top = TopElves{topElfCount, allocator}};
+        sum_up_lines(input, 0u, input.size(), elves);
+        elves.finish();
+        return elves;
     }
 
-    AOC_Y2022_CONSTEXPR auto part_2(const auto &parsedInput)
+    /*! \brief Sums up chunks of the input on the threads of the scheduler, each keeping its own top elves. */
+    Elves sum_up_in_parallel(const std::string_view input, const PuzzleOptions &options)
     {
-        auto elfCalories = get_elf_list(parsedInput);
-        constexpr auto numberOfTopElves = 3u;
-        std::partial_sort(elfCalories.begin(), elfCalories.begin() + numberOfTopElves, elfCalories.end(), std::greater());
-        return std::accumulate(elfCalories.begin(), elfCalories.begin() + numberOfTopElves, 0u);
+        // chunks much smaller than this are summed up faster than a task is scheduled
+        constexpr std::size_t minimumChunkSize = 64u * 1024u;
+        // the memory resource of the options does not have to be thread-safe
+        const Elves identity{.top = TopElves{options.topElves}};
+        auto elves = Scheduler::resolve(options.scheduler)
+                         .parallel_reduce(
+                             0u, input.size(), identity,
+                             [&input, &identity](const std::size_t begin, const std::size_t end) {
+                                 auto chunkElves = identity;
+                                 sum_up_lines(input, begin, end, chunkElves);
+                                 return chunkElves;
+                             },
+                             [](Elves &&left, Elves &&right) { return combine(std::move(left), right); },
+                             minimumChunkSize);
+        elves.finish();
+        return elves;
     }
 }
 
-class PuzzleDay01Impl final {
+template <> class PuzzleImpl<1u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay01Impl(std::vector<Calories> &&calories) : caloriesList(calories) {}
-    std::vector<Calories> caloriesList;
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const std::string_view input)
+        : PuzzleImpl(sum_up(input, PuzzleOptions{}.topElves))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : PuzzleImpl(should_parse_in_parallel(input, options)
+                         ? sum_up_in_parallel(input, options)
+                         : sum_up(input, options.topElves, options.memoryResource))
+    {
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        if (numberOfItems < 2)
+        {
+            return std::monostate{};
+        }
+        return to_solution(mostCalories);
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        if (numberOfItems < 2)
+        {
+            return std::monostate{};
+        }
+        return to_solution(topCalories);
+    }
+
+    static constexpr bool partsAreIndependent = true;
+
+private:
+    // the input is not kept, both parts are known after a single pass over it
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const Elves &elves)
+        : numberOfItems(elves.numberOfItems), mostCalories(elves.top.most()), topCalories(elves.top.sum())
+    {
+    }
+
+    std::size_t numberOfItems{};
+    Calories mostCalories{};
+    Calories topCalories{};
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(01)
+template <> class StreamingPuzzleImpl<1u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions &options) : topElves(options.topElves, options.memoryResource) {}
 
-PuzzleDay01::PuzzleDay01(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay01Impl>(parse_input(input)))
-{
-}
+    bool push(const std::string_view chunk)
+    {
+        return lines.push(chunk, [this](const std::string_view line) {
+            add_item(line);
+            return true;
+        });
+    }
 
-PuzzleDay01::~PuzzleDay01() = default;
+    [[nodiscard]] IPuzzle::Solutions finish()
+    {
+        lines.finish([this](const std::string_view line) {
+            add_item(line);
+            return true;
+        });
+        topElves.finish_elf();
+        if (numberOfItems < 2u)
+        {
+            return {};
+        }
+        return {.part1 = to_solution(topElves.most()), .part2 = to_solution(topElves.sum())};
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay01::Part1()
-{
-    if (!pImpl || (pImpl->caloriesList.size() < 2))
+private:
+    AOC_Y2022_CONSTEXPR void add_item(const std::string_view line)
     {
-        return std::monostate{};
+        ++numberOfItems;
+        topElves.add_item(parse_calories(line));
     }
-    return part_1(pImpl->caloriesList);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay01::Part2()
-{
-    if (!pImpl || (pImpl->caloriesList.size() < 2))
+    LineCarry lines;
+    std::size_t numberOfItems{};
+    TopElves topElves;
+};
+
+template <> class SessionImpl<1u> final {
+public:
+    explicit SessionImpl(const PuzzleOptions &options) : topElfCount(options.topElves) {}
+
+    void update(const EditableInput &input, const EditableInput::LineEdit &edit)
     {
-        return std::monostate{};
+        // only the elves who carry one of the changed items are summed up again, the elves behind them just move
+        const auto elfOf = [this](const std::size_t item) {
+            return static_cast<std::size_t>(std::upper_bound(elves.begin(), elves.end(), item,
+                                                             [](const std::size_t value, const Elf &elf) {
+                                                                 return value < elf.firstItem;
+                                                             }) -
+                                            elves.begin()) -
+                   1u;
+        };
+        const auto firstElf = elfOf(edit.first);
+        // removing a separator joins the elf behind the edit to the edited one
+        const auto behindLastElf = elfOf(edit.first + edit.removed) + 1u;
+        const auto begin = elves[firstElf].firstItem;
+        const auto oldEnd = (behindLastElf < elves.size()) ? elves[behindLastElf].firstItem : calories.size();
+
+        std::vector<Calories> inserted(edit.inserted);
+        for (std::size_t line = 0u; line != edit.inserted; ++line)
+        {
+            inserted[line] = parse_calories(input[edit.first + line]);
+        }
+        const auto removedBegin = calories.begin() + static_cast<std::ptrdiff_t>(edit.first);
+        calories.insert(calories.erase(removedBegin, removedBegin + static_cast<std::ptrdiff_t>(edit.removed)),
+                        inserted.begin(), inserted.end());
+
+        const auto end = oldEnd - edit.removed + edit.inserted;
+        std::vector<Elf> summed{Elf{.firstItem = begin}};
+        for (auto item = begin; item < end; ++item)
+        {
+            if (calories[item] != 0u)
+            {
+                summed.back().calories = add_saturated(summed.back().calories, calories[item]);
+                continue;
+            }
+            // the separator in front of the first elf behind the edit does not start another one
+            if (((item + 1u) < end) || (behindLastElf == elves.size()))
+            {
+                summed.push_back(Elf{.firstItem = item + 1u});
+            }
+        }
+        for (auto elf = elves.begin() + static_cast<std::ptrdiff_t>(behindLastElf); elf != elves.end(); ++elf)
+        {
+            elf->firstItem = elf->firstItem - edit.removed + edit.inserted;
+        }
+        const auto firstElfIt = elves.begin() + static_cast<std::ptrdiff_t>(firstElf);
+        elves.insert(elves.erase(firstElfIt, elves.begin() + static_cast<std::ptrdiff_t>(behindLastElf)),
+                     summed.begin(), summed.end());
     }
-    return part_2(pImpl->caloriesList);
-}
+
+    [[nodiscard]] IPuzzle::Solutions solve() const
+    {
+        if (calories.size() < 2u)
+        {
+            return {};
+        }
+        TopElves topElves{topElfCount};
+        for (const auto &elf : elves)
+        {
+            topElves.add_elf(elf.calories);
+        }
+        return {.part1 = to_solution(topElves.most()), .part2 = to_solution(topElves.sum())};
+    }
+
+private:
+    struct Elf final
+    {
+        std::size_t firstItem{};
+        Calories calories{};
+    };
+
+    std::size_t topElfCount;
+    std::vector<Calories> calories; //!< one item per line, 0 separates two elves
+    std::vector<Elf> elves{Elf{}};
+};
+
+template class Puzzle<1u>;
+template class StreamingPuzzle<1u>;
+template class PuzzleSession<1u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -106,14 +421,37 @@ constexpr const char * exampleInput = R"DAY01(
 )DAY01";
 consteval bool TestDay01()
 {
-    PuzzleDay01Impl parsed{parse_input(exampleInput)};
+    const PuzzleImpl<1u> parsed{exampleInput};
+    if (IPuzzle::Solution_t{std::int64_t{24000}} != parsed.part1())
+    {
+        return false;
+    }
+    if (IPuzzle::Solution_t{std::int64_t{45000}} != parsed.part2())
+    {
+        return false;
+    }
 
-    if (24000u != part_1(parsed.caloriesList))
+    const auto topTwo = sum_up(exampleInput, 2u);
+    if ((15u != topTwo.numberOfItems) || (24000u != topTwo.top.most()))
+    {
+        return false;
+    }
+    if (35000u != topTwo.top.sum())
     {
         return false;
     }
 
-    return 45000u == part_2(parsed.caloriesList);
+    // split in front of a line, cutting the elf carrying 11000 calories, and within lines
+    const std::string_view input{exampleInput};
+    Elves combined{.top = TopElves{2u}};
+    for (const auto &[begin, end] : {std::pair{0u, 28u}, std::pair{28u, 42u}, std::pair{42u, 47u}, std::pair{47u, 56u}})
+    {
+        Elves part{.top = TopElves{2u}};
+        sum_up_lines(input, begin, end, part);
+        combined = combine(std::move(combined), part);
+    }
+    combined.finish();
+    return (15u == combined.numberOfItems) && (35000u == combined.top.sum());
 }
 
 static_assert(TestDay01(), "");
@@ -1,9 +1,11 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 #include "ctre.hpp"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <numeric>
 #include <string_view>
@@ -44,22 +46,33 @@ namespace {
         return ret;
     }
 
-    AOC_Y2022_CONSTEXPR auto parse_input(std::string_view input_string_view)
+    AOC_Y2022_CONSTEXPR bool parse_turn_validated(const std::string_view line, Turn &turn)
     {
-        std::vector<Turn> strategy;
-        for_each_line(input_string_view, [&strategy](const std::string_view &line) -> bool {
-            if (auto [whole, theirs, ours] = ctre::match<"(^[A-C]) ([X-Z])$">(line); whole)
-            {
-                strategy.emplace_back(convert_input_shape(theirs.to_view()[0], 'A'), convert_input_shape(ours.to_view()[0], 'X'));
-                return true;
-            }
-            strategy.clear();
+        if (auto [whole, theirs, ours] = ctre::match<"(^[A-C]) ([X-Z])$">(line); whole)
+        {
+            turn = Turn{convert_input_shape(theirs.to_view()[0], 'A'), convert_input_shape(ours.to_view()[0], 'X')};
+            return true;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_turn_trusted(const std::string_view line, Turn &turn)
+    {
+        if (line.size() < 3u)
+        {
             return false;
-        });
-        return strategy;
+        }
+        turn = Turn{convert_input_shape(line[0u], 'A'), convert_input_shape(line[2u], 'X')};
+        return true;
     }
 
-    AOC_Y2022_CONSTEXPR auto determine_winner(const Shape first, const Shape second)
+    AOC_Y2022_CONSTEXPR bool parse_turn(const std::string_view line, Turn &turn,
+                                        const ParseMode mode = ParseMode::validate)
+    {
+        return parse_in_mode(mode, line, turn, parse_turn_validated, parse_turn_trusted);
+    }
+
+    constexpr auto determine_winner(const Shape first, const Shape second)
     {
         if ((first == second) || (first >= Shape::max) || (second >= Shape::max))
         {
@@ -70,7 +83,7 @@ namespace {
             : Winner::first;
     }
 
-    AOC_Y2022_CONSTEXPR auto update_score(auto &score, Winner winner, Shape shape)
+    constexpr auto update_score(auto &score, Winner winner, Shape shape)
     {
         switch (winner)
         {
@@ -89,7 +102,7 @@ namespace {
         return true;
     }
 
-    AOC_Y2022_CONSTEXPR auto select_shape(const Shape firstShape, Winner desiredOutcome)
+    constexpr auto select_shape(const Shape firstShape, Winner desiredOutcome)
     {
         switch (desiredOutcome)
         {
@@ -104,70 +117,463 @@ namespace {
         }
     }
 
-    AOC_Y2022_CONSTEXPR auto part_1(const auto &strategyGuide)
+    /*!
+     * \brief Points of a single turn in one part, indexed by [theirs][ours].
+     *
+     * Beside the nine turns of the puzzle, the tables cover Shape::max, which trusted parsing yields for unexpected
+     * characters. Every turn which can be scored gets at least one point for the shape, so 0 marks the others.
+     */
+    using PointsTable = std::array<std::array<std::uint8_t, 4u>, 4u>;
+
+    constexpr PointsTable make_points_table(const auto &fnScoreTurn)
     {
-        std::uint32_t score = 0u;
-        for(const auto &turn : strategyGuide)
+        PointsTable table{};
+        for (std::size_t theirs = 0u; theirs < table.size(); ++theirs)
         {
-            const auto winner = determine_winner(turn.first, turn.second);
-            if (!update_score(score, winner, turn.second))
+            for (std::size_t ours = 0u; ours < table[theirs].size(); ++ours)
             {
-                return 0u;
+                unsigned points = 0u;
+                if (fnScoreTurn(points, static_cast<Shape>(theirs), static_cast<Shape>(ours)))
+                {
+                    table[theirs][ours] = static_cast<std::uint8_t>(points);
+                }
             }
         }
-        return score;
+        return table;
     }
 
-    AOC_Y2022_CONSTEXPR auto part_2(const auto &strategyGuide)
+    //! the second column holds the shape we play
+    constexpr auto part1Points = make_points_table([](unsigned &points, const Shape theirs, const Shape ours) {
+        return update_score(points, determine_winner(theirs, ours), ours);
+    });
+
+    //! the second column holds the outcome of the turn
+    constexpr auto part2Points = make_points_table([](unsigned &points, const Shape theirs, const Shape outcome) {
+        const auto desiredOutcome = static_cast<Winner>(outcome);
+        return update_score(points, desiredOutcome, select_shape(theirs, desiredOutcome));
+    });
+
+    /*!
+     * \brief How often each turn is played, indexed by [theirs][ours] like the points tables.
+     *
+     * Both parts depend on nothing else, so either is scored from the histogram in constant time.
+     */
+    struct TurnHistogram final {
+        std::array<std::array<std::uint64_t, 4u>, 4u> counts{};
+
+        AOC_Y2022_CONSTEXPR void add(const Turn &turn)
+        {
+            ++counts[static_cast<std::size_t>(turn.first)][static_cast<std::size_t>(turn.second)];
+        }
+
+        AOC_Y2022_CONSTEXPR TurnHistogram &operator+=(const TurnHistogram &other)
+        {
+            for (std::size_t theirs = 0u; theirs < counts.size(); ++theirs)
+            {
+                for (std::size_t ours = 0u; ours < counts[theirs].size(); ++ours)
+                {
+                    counts[theirs][ours] += other.counts[theirs][ours];
+                }
+            }
+            return *this;
+        }
+
+        AOC_Y2022_CONSTEXPR TurnHistogram &operator-=(const TurnHistogram &other)
+        {
+            for (std::size_t theirs = 0u; theirs < counts.size(); ++theirs)
+            {
+                for (std::size_t ours = 0u; ours < counts[theirs].size(); ++ours)
+                {
+                    counts[theirs][ours] -= other.counts[theirs][ours];
+                }
+            }
+            return *this;
+        }
+
+        [[nodiscard]] AOC_Y2022_CONSTEXPR std::uint64_t number_of_turns() const
+        {
+            std::uint64_t turns = 0u;
+            for (const auto &row : counts)
+            {
+                turns = std::accumulate(row.begin(), row.end(), turns);
+            }
+            return turns;
+        }
+
+        /*! \brief Total points of the part, or 0 if a single turn cannot be scored. */
+        [[nodiscard]] AOC_Y2022_CONSTEXPR std::uint64_t score(const PointsTable &points) const
+        {
+            std::uint64_t score = 0u;
+            for (std::size_t theirs = 0u; theirs < counts.size(); ++theirs)
+            {
+                for (std::size_t ours = 0u; ours < counts[theirs].size(); ++ours)
+                {
+                    if ((points[theirs][ours] == 0u) && (counts[theirs][ours] != 0u))
+                    {
+                        return 0u;
+                    }
+                    score += counts[theirs][ours] * points[theirs][ours];
+                }
+            }
+            return score;
+        }
+    };
+
+    /*!
+     * \brief Turns of the lines in a part of the input.
+     *
+     * Like the lines of the strategy guide, the turns end at the first empty line, and an invalid line in front of
+     * it invalidates the whole guide.
+     */
+    struct GuideLines final {
+        TurnHistogram turns{};
+        bool invalid{};
+        bool endedByEmptyLine{};
+    };
+
+#if defined(AOC_Y2022_SIMD_AVX2) || defined(AOC_Y2022_SIMD_SSE2)
+    /*!
+     * \brief Counts the turns of blocks of well-formed lines "A X\n" from pos on, and returns where the first block
+     *        which is not made up of them begins.
+     *
+     * A block is checked bytewise against the ranges of the characters first. Then each line is compared with the
+     * nine possible lines as a 32-bit word, and every lane counts the matches of one of the turns. Blocks holding
+     * any other line, for example an empty line, a '\r' or a line of trusted input, are left to the scalar path.
+     */
+    inline std::size_t count_blocks_simd(const std::string_view input, std::size_t pos, const std::size_t end,
+                                         TurnHistogram &histogram)
     {
-        std::uint32_t score = 0u;
-        for (const auto &turn : strategyGuide)
+        constexpr auto turnWord = [](const std::uint32_t theirs, const std::uint32_t ours) {
+            return static_cast<int>(('A' + theirs) | (std::uint32_t{' '} << 8u) | (('X' + ours) << 16u) |
+                                    (std::uint32_t{'\n'} << 24u));
+        };
+        // the lanes count at most one line per register of a block, a 32-bit lane of up to 2^30 blocks is safe
+        constexpr std::size_t blocksPerFlush = std::size_t{1u} << 28u;
+        constexpr std::size_t registersPerBlock = 4u;
+        constexpr std::size_t turnCount = 9u;
+
+        const char *const data = input.data();
+        std::size_t pendingBlocks = 0u;
+#if defined(AOC_Y2022_SIMD_AVX2)
+        constexpr std::size_t blockSize = registersPerBlock * sizeof(__m256i);
+        const auto lowest = _mm256_set1_epi32(turnWord(0u, 0u));
+        const auto highest = _mm256_set1_epi32(0x00020002);
+        // the vector types carry attributes which std::array would drop
+        __m256i lanes[turnCount]{};
+        const auto flush = [&lanes, &histogram]() {
+            for (std::size_t turn = 0u; turn < turnCount; ++turn)
+            {
+                std::array<std::uint32_t, sizeof(__m256i) / sizeof(std::uint32_t)> counts{};
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(counts.data()), lanes[turn]);
+                histogram.counts[turn / 3u][turn % 3u] += std::accumulate(counts.begin(), counts.end(), std::uint64_t{});
+                lanes[turn] = _mm256_setzero_si256();
+            }
+        };
+        for (; (pos + blockSize) <= end; pos += blockSize)
         {
-            const auto desiredOutcome = static_cast<Winner>(turn.second);
-            const auto &theirShape = turn.first;
-            const auto ourShape = select_shape(theirShape, desiredOutcome);
-            if (!update_score(score, desiredOutcome, ourShape))
+            __m256i lines[registersPerBlock]{};
+            auto valid = _mm256_set1_epi32(-1);
+            for (std::size_t idx = 0u; idx < registersPerBlock; ++idx)
             {
-                return 0u;
+                lines[idx] = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos + (idx * sizeof(__m256i))));
+                const auto offsets = _mm256_sub_epi8(lines[idx], lowest);
+                valid = _mm256_and_si256(valid, _mm256_cmpeq_epi8(_mm256_max_epu8(offsets, highest), highest));
+            }
+            if (static_cast<std::uint32_t>(_mm256_movemask_epi8(valid)) != 0xffffffffu)
+            {
+                break;
+            }
+            for (std::size_t turn = 0u; turn < turnCount; ++turn)
+            {
+                const auto word = _mm256_set1_epi32(turnWord(static_cast<std::uint32_t>(turn / 3u),
+                                                             static_cast<std::uint32_t>(turn % 3u)));
+                for (const auto &block : lines)
+                {
+                    lanes[turn] = _mm256_sub_epi32(lanes[turn], _mm256_cmpeq_epi32(block, word));
+                }
+            }
+            if (++pendingBlocks == blocksPerFlush)
+            {
+                flush();
+                pendingBlocks = 0u;
+            }
+        }
+#else
+        constexpr std::size_t blockSize = registersPerBlock * sizeof(__m128i);
+        const auto lowest = _mm_set1_epi32(turnWord(0u, 0u));
+        const auto highest = _mm_set1_epi32(0x00020002);
+        // the vector types carry attributes which std::array would drop
+        __m128i lanes[turnCount]{};
+        const auto flush = [&lanes, &histogram]() {
+            for (std::size_t turn = 0u; turn < turnCount; ++turn)
+            {
+                std::array<std::uint32_t, sizeof(__m128i) / sizeof(std::uint32_t)> counts{};
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(counts.data()), lanes[turn]);
+                histogram.counts[turn / 3u][turn % 3u] += std::accumulate(counts.begin(), counts.end(), std::uint64_t{});
+                lanes[turn] = _mm_setzero_si128();
+            }
+        };
+        for (; (pos + blockSize) <= end; pos += blockSize)
+        {
+            __m128i lines[registersPerBlock]{};
+            auto valid = _mm_set1_epi32(-1);
+            for (std::size_t idx = 0u; idx < registersPerBlock; ++idx)
+            {
+                lines[idx] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos + (idx * sizeof(__m128i))));
+                const auto offsets = _mm_sub_epi8(lines[idx], lowest);
+                valid = _mm_and_si128(valid, _mm_cmpeq_epi8(_mm_max_epu8(offsets, highest), highest));
+            }
+            if (static_cast<std::uint32_t>(_mm_movemask_epi8(valid)) != 0xffffu)
+            {
+                break;
+            }
+            for (std::size_t turn = 0u; turn < turnCount; ++turn)
+            {
+                const auto word = _mm_set1_epi32(turnWord(static_cast<std::uint32_t>(turn / 3u),
+                                                          static_cast<std::uint32_t>(turn % 3u)));
+                for (const auto &block : lines)
+                {
+                    lanes[turn] = _mm_sub_epi32(lanes[turn], _mm_cmpeq_epi32(block, word));
+                }
+            }
+            if (++pendingBlocks == blocksPerFlush)
+            {
+                flush();
+                pendingBlocks = 0u;
+            }
+        }
+#endif
+        flush();
+        return pos;
+    }
+#endif
+
+    /*!
+     * \brief Counts the turns of the lines starting within [begin, end). The last line may reach behind end.
+     *
+     * Runs of well-formed lines are counted by the vectorized kernel, which needs no parsing at all, every other
+     * line is parsed in the given mode.
+     */
+    AOC_Y2022_CONSTEXPR void count_turns(const std::string_view input, std::size_t begin, const std::size_t end,
+                                         GuideLines &guide, const ParseMode mode = ParseMode::validate)
+    {
+        if ((begin != 0u) && (input[begin - 1u] != '\n'))
+        {
+            begin = std::min(input.find('\n', begin), input.size() - 1u) + 1u;
+        }
+        for (auto lineBegin = begin; lineBegin < end;)
+        {
+#if defined(AOC_Y2022_SIMD_AVX2) || defined(AOC_Y2022_SIMD_SSE2)
+            if (!std::is_constant_evaluated())
+            {
+                lineBegin = count_blocks_simd(input, lineBegin, end, guide.turns);
+                if (lineBegin >= end)
+                {
+                    break;
+                }
+            }
+#endif
+            const auto lineBreak = find_line_break(input, lineBegin);
+            const auto line = input.substr(lineBegin, lineBreak - lineBegin);
+            if (line.empty())
+            {
+                guide.endedByEmptyLine = true;
+                return;
+            }
+            Turn turn{};
+            if (!parse_turn(line, turn, mode))
+            {
+                guide.invalid = true;
+                return;
+            }
+            guide.turns.add(turn);
+            const auto nextLine = find_next_line(input, lineBreak);
+            if (nextLine == std::string_view::npos)
+            {
+                break;
             }
+            lineBegin = nextLine;
         }
-        return score;
     }
 
+    /*! \brief Joins the turns of two adjacent parts, nothing behind an empty line is part of the guide. */
+    AOC_Y2022_CONSTEXPR GuideLines combine(GuideLines left, const GuideLines &right)
+    {
+        if (left.invalid || left.endedByEmptyLine)
+        {
+            return left;
+        }
+        left.turns += right.turns;
+        left.invalid = right.invalid;
+        left.endedByEmptyLine = right.endedByEmptyLine;
+        return left;
+    }
+
+    AOC_Y2022_CONSTEXPR GuideLines count_guide(const std::string_view input, const ParseMode mode = ParseMode::validate)
+    {
+        GuideLines guide{};
+        count_turns(input, 0u, input.size(), guide, mode);
+        return guide;
+    }
+
+    /*! \brief Counts the turns of chunks of the input on the threads of the scheduler. */
+    GuideLines count_guide_in_parallel(const std::string_view input, const PuzzleOptions &options)
+    {
+        // chunks much smaller than this are counted faster than a task is scheduled
+        constexpr std::size_t minimumChunkSize = 64u * 1024u;
+        return Scheduler::resolve(options.scheduler)
+            .parallel_reduce(
+                0u, input.size(), GuideLines{},
+                [&input, mode = options.parseMode](const std::size_t begin, const std::size_t end) {
+                    GuideLines guide{};
+                    count_turns(input, begin, end, guide, mode);
+                    return guide;
+                },
+                [](GuideLines &&left, GuideLines &&right) { return combine(left, right); }, minimumChunkSize);
+    }
 }
 
-class PuzzleDay02Impl final {
+template <> class PuzzleImpl<2u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay02Impl(std::vector<Turn> &&strategy) : strategyGuide(strategy) {}
-    std::vector<Turn> strategyGuide;
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const std::string_view input) : PuzzleImpl(count_guide(input)) {}
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : PuzzleImpl(should_parse_in_parallel(input, options) ? count_guide_in_parallel(input, options)
+                                                               : count_guide(input, options.parseMode))
+    {
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        if (turns.number_of_turns() < 2u)
+        {
+            return std::monostate{};
+        }
+        return static_cast<std::int64_t>(turns.score(part1Points));
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        if (turns.number_of_turns() < 2u)
+        {
+            return std::monostate{};
+        }
+        return static_cast<std::int64_t>(turns.score(part2Points));
+    }
+
+    static constexpr bool partsAreIndependent = true;
+
+private:
+    // only the histogram of the turns is kept, an invalid line leaves no turns to be solved
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const GuideLines &guide) : turns(guide.invalid ? TurnHistogram{} : guide.turns)
+    {
+    }
+
+    TurnHistogram turns{};
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(02)
+template <> class StreamingPuzzleImpl<2u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions &options) : parseMode(options.parseMode) {}
 
-PuzzleDay02::PuzzleDay02(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay02Impl>(parse_input(input)))
-{
-}
+    bool push(const std::string_view chunk)
+    {
+        if (state != State::parsing)
+        {
+            return state != State::failed;
+        }
+        lines.push(chunk, [this](const std::string_view line) { return add_turn(line); });
+        return state != State::failed;
+    }
 
-PuzzleDay02::~PuzzleDay02() = default;
+    [[nodiscard]] IPuzzle::Solutions finish()
+    {
+        if (state == State::parsing)
+        {
+            lines.finish([this](const std::string_view line) { return add_turn(line); });
+        }
+        if ((state == State::failed) || (turns.number_of_turns() < 2u))
+        {
+            return {};
+        }
+        return {.part1 = static_cast<std::int64_t>(turns.score(part1Points)),
+                .part2 = static_cast<std::int64_t>(turns.score(part2Points))};
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay02::Part1()
-{
-    if (!pImpl || (pImpl->strategyGuide.size() < 2))
+private:
+    enum class State : std::uint8_t
     {
-        return std::monostate{};
+        parsing, stopped, failed,
+    };
+
+    // mirrors count_turns: an empty line ends the strategy guide, an invalid line discards it
+    AOC_Y2022_CONSTEXPR bool add_turn(const std::string_view line)
+    {
+        if (line.empty())
+        {
+            state = State::stopped;
+            return false;
+        }
+        Turn turn{};
+        if (!parse_turn(line, turn, parseMode))
+        {
+            state = State::failed;
+            return false;
+        }
+        turns.add(turn);
+        return true;
     }
-    return part_1(pImpl->strategyGuide);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay02::Part2()
-{
-    if (!pImpl || (pImpl->strategyGuide.size() < 2))
+    ParseMode parseMode{};
+    LineCarry lines;
+    State state{State::parsing};
+    TurnHistogram turns{};
+};
+
+template <> class SessionImpl<2u> final {
+public:
+    explicit SessionImpl(const PuzzleOptions &options) : strategyGuide(options.parseMode) {}
+
+    void update(const EditableInput &input, const EditableInput::LineEdit &edit)
     {
-        return std::monostate{};
+        static_cast<void>(strategyGuide.update(input, edit));
+    }
+
+    [[nodiscard]] IPuzzle::Solutions solve() const
+    {
+        if (!strategyGuide.valid() || (strategyGuide.size() < 2u))
+        {
+            return {};
+        }
+        const auto &turns = strategyGuide.totals();
+        return {.part1 = static_cast<std::int64_t>(turns.score(part1Points)),
+                .part2 = static_cast<std::int64_t>(turns.score(part2Points))};
     }
-    return part_2(pImpl->strategyGuide);
-}
+
+private:
+    struct TurnLines final
+    {
+        using Item = Turn;
+        using Totals = TurnHistogram;
+
+        static bool parse(const std::string_view line, Turn &turn, const ParseMode mode)
+        {
+            return parse_turn(line, turn, mode);
+        }
+
+        static Totals contribution(const Turn &turn)
+        {
+            Totals turns{};
+            turns.add(turn);
+            return turns;
+        }
+    };
+
+    ParsedLines<TurnLines> strategyGuide;
+};
+
+template class Puzzle<2u>;
+template class StreamingPuzzle<2u>;
+template class PuzzleSession<2u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -178,14 +584,34 @@ C Z
 )DAY02";
 consteval bool TestDay02()
 {
-    PuzzleDay02Impl parsed{parse_input(exampleInput)};
+    const PuzzleImpl<2u> parsed{exampleInput};
+    if (IPuzzle::Solution_t{std::int64_t{15}} != parsed.part1())
+    {
+        return false;
+    }
+    if (IPuzzle::Solution_t{std::int64_t{12}} != parsed.part2())
+    {
+        return false;
+    }
 
-    if (15 != part_1(parsed.strategyGuide))
+    const auto trusted = count_guide(exampleInput, ParseMode::trusted).turns;
+    if ((3u != trusted.number_of_turns()) || (15u != trusted.score(part1Points)) ||
+        (12u != trusted.score(part2Points)))
     {
         return false;
     }
 
-    return 12 == part_2(parsed.strategyGuide);
+    // split in front of a line and within lines, the empty line ends the guide
+    const std::string_view input{"A Y\nB X\n\nC Z\n"};
+    GuideLines combined{};
+    for (const auto &[begin, end] : {std::pair{0u, 4u}, std::pair{4u, 6u}, std::pair{6u, 9u}, std::pair{9u, 13u}})
+    {
+        GuideLines part{};
+        count_turns(input, begin, end, part);
+        combined = combine(combined, part);
+    }
+    const auto &turns = combined.turns;
+    return (2u == turns.number_of_turns()) && (9u == turns.score(part1Points)) && (5u == turns.score(part2Points));
 }
 
 static_assert(TestDay02(), "");
@@ -198,6 +624,9 @@ static_assert(Shape::paper == select_shape(Shape::scissors, Winner::first), "");
 static_assert(Shape::paper == select_shape(Shape::rock, Winner::second), "");
 static_assert(Shape::scissors == select_shape(Shape::paper, Winner::second), "");
 static_assert(Shape::rock == select_shape(Shape::scissors, Winner::second), "");
+static_assert(8u == part1Points[0u][1u] && 1u == part1Points[1u][0u] && 6u == part1Points[2u][2u], "");
+static_assert(4u == part2Points[0u][1u] && 1u == part2Points[1u][0u] && 7u == part2Points[2u][2u], "");
+static_assert(0u == part2Points[0u][3u] && 7u == part1Points[3u][3u], "");
 
 } // namespace
 #endif // AOC_Y2022_CONSTEXPR_UNIT_TEST
@@ -1,9 +1,11 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 #include "ctre.hpp"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <limits>
 #include <memory>
@@ -11,6 +13,7 @@
 #include <ranges>
 #include <string_view>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace AOC::Y2022
@@ -21,35 +24,55 @@ namespace {
     using Bitset = std::uint64_t; // std::bitset would be nicer, however, C++23 is required for `constexpr`
     using Rucksack = std::pair<Bitset, Bitset>;
 
-    AOC_Y2022_CONSTEXPR auto parse_input(std::string_view input_string_view)
+    /*! \brief Splits the items into both compartments, there has to be exactly one item in both of them. */
+    AOC_Y2022_CONSTEXPR bool split_rucksack(const std::string_view line, Rucksack &rucksack)
     {
-        std::vector<Rucksack> rucksacks;
-        bool parsingError = false;
-        for_each_line(input_string_view, [&rucksacks, &parsingError](const std::string_view &line) -> bool {
-            if (ctre::match<"^(?:[A-Za-z]{2})+$">(line))
+        const auto middle = line.size() / 2u;
+        const auto compartment1 = line.substr(0u, middle);
+        const auto compartment2 = line.substr(middle);
+        const auto createBitset = [](const auto &input) {
+            Bitset bitset = 0u;
+            for (const auto c : input)
             {
-                const auto middle = line.size() / 2u;
-                const auto compartment1 = line.substr(0u, middle);
-                const auto compartment2 = line.substr(middle);
-                const auto createBitset = [](const auto &input) {
-                    Bitset bitset = 0u;
-                    for (const auto c : input)
-                    {
-                        if (std::islower(c))
-                        {
-                            bitset |= 1ull << (c - 'a');
-                            continue;
-                        }
-                        bitset |= 1ull << (c - 'A' + 26);
-                    }
-                    return bitset;
-                };
-                rucksacks.emplace_back(createBitset(compartment1), createBitset(compartment2));
-                if (std::popcount(rucksacks.back().first & rucksacks.back().second) != 1u)
+                // the mask only matters for trusted input which holds other characters than letters
+                if ((c >= 'a') && (c <= 'z'))
                 {
-                    parsingError = true;
-                    return false;
+                    bitset |= 1ull << ((c - 'a') & 63);
+                    continue;
                 }
+                bitset |= 1ull << ((c - 'A' + 26) & 63);
+            }
+            return bitset;
+        };
+        rucksack = Rucksack{createBitset(compartment1), createBitset(compartment2)};
+        return std::popcount(rucksack.first & rucksack.second) == 1u;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_rucksack_validated(const std::string_view line, Rucksack &rucksack)
+    {
+        if (!ctre::match<"^(?:[A-Za-z]{2})+$">(line))
+        {
+            return false;
+        }
+        return split_rucksack(line, rucksack);
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_rucksack(const std::string_view line, Rucksack &rucksack,
+                                            const ParseMode mode = ParseMode::validate)
+    {
+        return parse_in_mode(mode, line, rucksack, parse_rucksack_validated, split_rucksack);
+    }
+
+    AOC_Y2022_CONSTEXPR auto parse_input(std::string_view input_string_view,
+                                         const ParseMode mode = ParseMode::validate,
+                                         const ResourceAllocator<Rucksack> &allocator = {})
+    {
+        ResourceVector<Rucksack> rucksacks(allocator);
+        bool parsingError = false;
+        for_each_line(input_string_view, [&rucksacks, &parsingError, mode](const std::string_view &line) -> bool {
+            if (Rucksack rucksack{}; parse_rucksack(line, rucksack, mode))
+            {
+                rucksacks.push_back(rucksack);
                 return true;
             }
             parsingError = true;
@@ -82,7 +105,7 @@ namespace {
 
     AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_2(const auto &rucksacks)
     {
-        static constexpr std::size_t groupSize = 3u;
+        constexpr std::size_t groupSize = 3u;
         const auto numRucksacks = rucksacks.size();
         if (numRucksacks % groupSize != 0u)
         {
@@ -120,38 +143,225 @@ namespace {
 
 }
 
-class PuzzleDay03Impl final {
+template <> class PuzzleImpl<3u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay03Impl(std::vector<Rucksack> &&rucksacks) : rucksacks(rucksacks) {}
-    std::vector<Rucksack> rucksacks;
+    AOC_Y2022_CONSTEXPR PuzzleImpl(ResourceVector<Rucksack> &&rucksacks) : rucksacks(std::move(rucksacks)) {}
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const std::string_view input) : rucksacks(parse_input(input)) {}
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : rucksacks(should_parse_in_parallel(input, options)
+                        ? parse_lines_in_parallel<Rucksack>(input, options,
+                              [mode = options.parseMode](const auto line, Rucksack &rucksack) {
+                                  return parse_rucksack(line, rucksack, mode);
+                              })
+                        : parse_input(input, options.parseMode, options.memoryResource))
+    {
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        if (rucksacks.size() < 2)
+        {
+            return std::monostate{};
+        }
+        return part_1(rucksacks);
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        if (rucksacks.size() < 2)
+        {
+            return std::monostate{};
+        }
+        return part_2(rucksacks);
+    }
+
+    static constexpr bool partsAreIndependent = true;
+    ResourceVector<Rucksack> rucksacks;
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(03)
+template <> class StreamingPuzzleImpl<3u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions &options) : parseMode(options.parseMode) {}
 
-PuzzleDay03::PuzzleDay03(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay03Impl>(parse_input(input)))
-{
-}
+    bool push(const std::string_view chunk)
+    {
+        if (state != State::parsing)
+        {
+            return state != State::failed;
+        }
+        lines.push(chunk, [this](const std::string_view line) { return add_rucksack(line); });
+        return state != State::failed;
+    }
 
-PuzzleDay03::~PuzzleDay03() = default;
+    [[nodiscard]] IPuzzle::Solutions finish()
+    {
+        if (state == State::parsing)
+        {
+            lines.finish([this](const std::string_view line) { return add_rucksack(line); });
+        }
+        if ((state == State::failed) || (numberOfRucksacks < 2u))
+        {
+            return {};
+        }
+        IPuzzle::Solutions solutions{.part1 = static_cast<std::int64_t>(prioSum1), .part2 = std::monostate{}};
+        if (((numberOfRucksacks % group.size()) == 0u) && !badgeMissing)
+        {
+            solutions.part2 = static_cast<std::int64_t>(prioSum2);
+        }
+        return solutions;
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay03::Part1()
-{
-    if (!pImpl || (pImpl->rucksacks.size() < 2))
+private:
+    enum class State : std::uint8_t
     {
-        return std::monostate{};
+        parsing, stopped, failed,
+    };
+
+    // mirrors parse_input: an empty line ends the list, an invalid rucksack discards it
+    AOC_Y2022_CONSTEXPR bool add_rucksack(const std::string_view line)
+    {
+        if (line.empty())
+        {
+            state = State::stopped;
+            return false;
+        }
+        auto &rucksack = group[numberOfRucksacks % group.size()];
+        if (!parse_rucksack(line, rucksack, parseMode))
+        {
+            state = State::failed;
+            return false;
+        }
+        ++numberOfRucksacks;
+        prioSum1 += part_1(std::array<Rucksack, 1u>{rucksack});
+        if ((numberOfRucksacks % group.size()) == 0u)
+        {
+            const auto groupPrio = part_2(group);
+            if (std::holds_alternative<std::monostate>(groupPrio))
+            {
+                badgeMissing = true;
+                return true;
+            }
+            prioSum2 += static_cast<std::uint32_t>(std::get<std::int64_t>(groupPrio));
+        }
+        return true;
     }
-    return part_1(pImpl->rucksacks);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay03::Part2()
-{
-    if (!pImpl || (pImpl->rucksacks.size() < 2))
+    ParseMode parseMode{};
+    LineCarry lines;
+    State state{State::parsing};
+    std::size_t numberOfRucksacks{};
+    std::array<Rucksack, 3u> group{};
+    bool badgeMissing{};
+    std::uint32_t prioSum1{};
+    std::uint32_t prioSum2{};
+};
+
+template <> class SessionImpl<3u> final {
+public:
+    explicit SessionImpl(const PuzzleOptions &options) : rucksacks(options.parseMode) {}
+
+    void update(const EditableInput &input, const EditableInput::LineEdit &edit)
     {
-        return std::monostate{};
+        const auto firstChanged = rucksacks.update(input, edit);
+        const auto numberOfGroups = rucksacks.size() / groupSize;
+        // an edit which keeps the number of rucksacks only changes its own groups, otherwise all groups behind the
+        // first changed rucksack are formed anew
+        const bool groupsKept = (edit.removed == edit.inserted) && (rucksacks.size() == numberOfRucksacks);
+        const auto firstGroup = firstChanged / groupSize;
+        const auto endGroup = groupsKept
+            ? std::min(numberOfGroups, (edit.first + edit.inserted + groupSize - 1u) / groupSize)
+            : numberOfGroups;
+        for (auto group = firstGroup; group < (groupsKept ? endGroup : badges.size()); ++group)
+        {
+            remove_badge(badges[group]);
+        }
+        badges.resize(numberOfGroups);
+        for (auto group = firstGroup; group < endGroup; ++group)
+        {
+            const std::array<Rucksack, groupSize> members{rucksacks[group * groupSize],
+                                                          rucksacks[(group * groupSize) + 1u],
+                                                          rucksacks[(group * groupSize) + 2u]};
+            const auto priority = part_2(members);
+            badges[group] = std::holds_alternative<std::int64_t>(priority)
+                ? static_cast<std::uint32_t>(std::get<std::int64_t>(priority))
+                : 0u;
+            add_badge(badges[group]);
+        }
+        numberOfRucksacks = rucksacks.size();
     }
-    return part_2(pImpl->rucksacks);
-}
+
+    [[nodiscard]] IPuzzle::Solutions solve() const
+    {
+        if (!rucksacks.valid() || (numberOfRucksacks < 2u))
+        {
+            return {};
+        }
+        IPuzzle::Solutions solutions{.part1 = static_cast<std::int64_t>(rucksacks.totals().priorities),
+                                     .part2 = std::monostate{}};
+        if (((numberOfRucksacks % groupSize) == 0u) && (missingBadges == 0u))
+        {
+            solutions.part2 = static_cast<std::int64_t>(badgePriorities);
+        }
+        return solutions;
+    }
+
+private:
+    static constexpr std::size_t groupSize = 3u;
+
+    struct RucksackLines final
+    {
+        using Item = Rucksack;
+        struct Totals final
+        {
+            std::uint32_t priorities{};
+
+            Totals &operator+=(const Totals &other)
+            {
+                priorities += other.priorities;
+                return *this;
+            }
+
+            Totals &operator-=(const Totals &other)
+            {
+                priorities -= other.priorities;
+                return *this;
+            }
+        };
+
+        static bool parse(const std::string_view line, Rucksack &rucksack, const ParseMode mode)
+        {
+            return parse_rucksack(line, rucksack, mode);
+        }
+
+        static Totals contribution(const Rucksack &rucksack)
+        {
+            return {.priorities = part_1(std::array<Rucksack, 1u>{rucksack})};
+        }
+    };
+
+    // a group without a single shared item has the priority 0, which no item has
+    void add_badge(const std::uint32_t priority)
+    {
+        badgePriorities += priority;
+        missingBadges += (priority == 0u) ? 1u : 0u;
+    }
+
+    void remove_badge(const std::uint32_t priority)
+    {
+        badgePriorities -= priority;
+        missingBadges -= (priority == 0u) ? 1u : 0u;
+    }
+
+    ParsedLines<RucksackLines> rucksacks;
+    std::size_t numberOfRucksacks{};
+    std::vector<std::uint32_t> badges;
+    std::uint32_t badgePriorities{};
+    std::size_t missingBadges{};
+};
+
+template class Puzzle<3u>;
+template class StreamingPuzzle<3u>;
+template class PuzzleSession<3u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -166,16 +376,22 @@ CrZsJsPPZsGzwwsLwLmpwMDw
 )ExampleInput";
 consteval bool TestDay03()
 {
-    PuzzleDay03Impl parsed{parse_input(exampleInput)};
+    PuzzleImpl<3u> parsed{parse_input(exampleInput)};
 
     if (157 != part_1(parsed.rucksacks))
     {
         return false;
     }
+    if (parse_input(exampleInput, ParseMode::trusted) != parsed.rucksacks)
+    {
+        return false;
+    }
 
     return 70 == std::get<std::int64_t>(part_2(parsed.rucksacks));
 }
 
+static_assert(TestDay03(), "Wrong results for example input");
+
 } // namespace
 #endif // AOC_Y2022_CONSTEXPR_UNIT_TEST
 
@@ -1,14 +1,17 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 #include "ctre.hpp"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -21,92 +24,273 @@ namespace {
     struct Elf {
         std::uint32_t x;
         std::uint32_t y;
+        AOC_Y2022_CONSTEXPR bool operator==(const Elf &) const = default;
     };
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(std::string_view input_string_view, auto &&predicate)
+    using ElfPairs = ResourceVector<std::pair<Elf, Elf>>;
+
+    AOC_Y2022_CONSTEXPR bool parse_elf_pair_validated(const std::string_view line, std::pair<Elf, Elf> &elfPair)
+    {
+        if (auto [m, start1, end1, start2, end2] = ctre::match<"^([0-9]+)-([0-9]+),([0-9]+)-([0-9]+)$">(line); m)
+        {
+            elfPair = std::pair<Elf, Elf>{
+                Elf{parse_decimal<std::uint32_t>(start1), parse_decimal<std::uint32_t>(end1)},
+                Elf{parse_decimal<std::uint32_t>(start2), parse_decimal<std::uint32_t>(end2)}
+            };
+            return (elfPair.first.y >= elfPair.first.x) && (elfPair.second.y >= elfPair.second.x);
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_elf_pair_trusted(std::string_view line, std::pair<Elf, Elf> &elfPair)
     {
-        std::vector<std::pair<Elf, Elf>> elves;
+        std::array<std::uint32_t, 4u> sections{};
+        if (parse_all_numbers(line, std::span{sections}) != sections.size())
+        {
+            return false;
+        }
+        elfPair = std::pair<Elf, Elf>{Elf{sections[0u], sections[1u]}, Elf{sections[2u], sections[3u]}};
+        return (elfPair.first.y >= elfPair.first.x) && (elfPair.second.y >= elfPair.second.x);
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_elf_pair(const std::string_view line, std::pair<Elf, Elf> &elfPair,
+                                            const ParseMode mode = ParseMode::validate)
+    {
+        return parse_in_mode(mode, line, elfPair, parse_elf_pair_validated, parse_elf_pair_trusted);
+    }
+
+    /*! \brief Parses all section assignments, returns an empty list on invalid input. */
+    AOC_Y2022_CONSTEXPR ElfPairs parse_elf_pairs(std::string_view input_string_view,
+                                                 const ParseMode mode = ParseMode::validate,
+                                                 const ElfPairs::allocator_type &allocator = {})
+    {
+        ElfPairs elves(allocator);
         for (const auto line : LinesView{input_string_view})
         {
             if (line.empty())
             {
                 break;
             }
-            if (auto [m, start1, end1, start2, end2] = ctre::match<"^([0-9]+)-([0-9]+),([0-9]+)-([0-9]+)$">(line); m)
-            {
-                elves.emplace_back(
-                    Elf{parse_number<std::uint32_t>(start1), parse_number<std::uint32_t>(end1)},
-                    Elf{parse_number<std::uint32_t>(start2), parse_number<std::uint32_t>(end2)}
-                );
-                if ((elves.back().first.y < elves.back().first.x) || (elves.back().second.y < elves.back().second.x))
-                {
-                    return std::monostate{};
-                }
-            }
-            else
+            if (!parse_elf_pair(line, elves.emplace_back(), mode))
             {
-                return std::monostate{};
+                return ElfPairs(allocator);
             }
         }
+        return elves;
+    }
+
+    /*! \brief True if the input is at least two bytes long and starts with an empty line, so it lists no pairs. */
+    AOC_Y2022_CONSTEXPR bool lists_no_elf_pairs(const std::string_view input_string_view)
+    {
+        if (input_string_view.size() < 2u)
+        {
+            return false;
+        }
+        for (const auto line : LinesView{input_string_view})
+        {
+            return line.empty();
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool fully_contained(const std::pair<Elf, Elf> &e)
+    {
+        return ((e.first.x >= e.second.x) && (e.first.y <= e.second.y))
+            || ((e.second.x >= e.first.x) && (e.second.y <= e.first.y));
+    }
+
+    AOC_Y2022_CONSTEXPR bool overlapping(const std::pair<Elf, Elf> &e)
+    {
+        // x1           y1
+        //              x2                   y2
+        //
+        //                        x1           y1
+        //   x2                   y2
+        return (e.first.y >= e.second.x) && (e.first.x <= e.second.y);
+    }
+
+    /*! \brief Counts the pairs matching the predicate, an empty list is only solved if the input lists no pairs. */
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(const ElfPairs &elves, const bool noElfPairs, auto &&predicate)
+    {
+        if (elves.empty() && !noElfPairs)
+        {
+            return std::monostate{};
+        }
         return std::count_if(elves.begin(), elves.end(), predicate);
     }
 
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_1(std::string_view input)
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_1(const ElfPairs &elves, const bool noElfPairs = false)
     {
-        const auto predicate1 = [](const std::pair<Elf, Elf> &e) {
-           const bool fullyContained = ((e.first.x >= e.second.x) && (e.first.y <= e.second.y))
-               || ((e.second.x >= e.first.x) && (e.second.y <= e.first.y));
-           return fullyContained;
-        };
-        return solve_part(input, predicate1);
+        return solve_part(elves, noElfPairs, fully_contained);
     }
 
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_2(std::string_view input)
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_2(const ElfPairs &elves, const bool noElfPairs = false)
     {
-        const auto predicate2 = [](const std::pair<Elf, Elf> &e) {
-            // x1           y1
-            //              x2                   y2
-            //
-            //                        x1           y1
-            //   x2                   y2
-            const bool overlapping = (e.first.y >= e.second.x) && (e.first.x <= e.second.y);
-            return overlapping;
-        };
-        return solve_part(input, predicate2);
+        return solve_part(elves, noElfPairs, overlapping);
     }
 
 }
 
-class PuzzleDay04Impl final {
+template <> class PuzzleImpl<4u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay04Impl(std::string_view input) : input(input) {}
-    std::string input;
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const ElfPairs::allocator_type &allocator = {})
+        : elves(parse_elf_pairs(input, ParseMode::validate, allocator)), noElfPairs(lists_no_elf_pairs(input))
+    {
+    }
+    AOC_Y2022_CONSTEXPR PuzzleImpl(ElfPairs &&elves) : elves(std::move(elves)) {}
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : elves(should_parse_in_parallel(input, options)
+                    ? parse_lines_in_parallel<ElfPairs::value_type>(input, options,
+                          [mode = options.parseMode](const auto line, auto &elfPair) {
+                              return parse_elf_pair(line, elfPair, mode);
+                          })
+                    : parse_elf_pairs(input, options.parseMode, options.memoryResource)),
+          noElfPairs(lists_no_elf_pairs(input))
+    {
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        return part_1(elves, noElfPairs);
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        return part_2(elves, noElfPairs);
+    }
+
+    static constexpr bool partsAreIndependent = true;
+    ElfPairs elves;
+    // an input starting with an empty line is valid and counts 0 pairs
+    bool noElfPairs{};
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(04)
+template <> class StreamingPuzzleImpl<4u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions &options) : parseMode(options.parseMode) {}
 
-PuzzleDay04::PuzzleDay04(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay04Impl>(input))
-{
-}
-PuzzleDay04::~PuzzleDay04() = default;
+    bool push(const std::string_view chunk)
+    {
+        inputSize += chunk.size();
+        if (state != State::parsing)
+        {
+            return state != State::failed;
+        }
+        lines.push(chunk, [this](const std::string_view line) { return add_elf_pair(line); });
+        return state != State::failed;
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay04::Part1()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+    [[nodiscard]] IPuzzle::Solutions finish()
     {
-        return std::monostate{};
+        if (state == State::parsing)
+        {
+            lines.finish([this](const std::string_view line) { return add_elf_pair(line); });
+        }
+        // like lists_no_elf_pairs, an input of at least two bytes starting with an empty line counts 0 pairs
+        if ((state == State::failed) || ((numberOfPairs == 0u) && ((state != State::stopped) || (inputSize < 2u))))
+        {
+            return {};
+        }
+        return {.part1 = numberFullyContained, .part2 = numberOverlapping};
     }
-    return part_1(pImpl->input);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay04::Part2()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+private:
+    enum class State : std::uint8_t
     {
-        return std::monostate{};
+        parsing, stopped, failed,
+    };
+
+    // mirrors parse_elf_pairs: an empty line ends the list, an invalid line discards it
+    AOC_Y2022_CONSTEXPR bool add_elf_pair(const std::string_view line)
+    {
+        if (line.empty())
+        {
+            state = State::stopped;
+            return false;
+        }
+        std::pair<Elf, Elf> elfPair{};
+        if (!parse_elf_pair(line, elfPair, parseMode))
+        {
+            state = State::failed;
+            return false;
+        }
+        ++numberOfPairs;
+        numberFullyContained += fully_contained(elfPair) ? 1 : 0;
+        numberOverlapping += overlapping(elfPair) ? 1 : 0;
+        return true;
     }
-    return part_2(pImpl->input);
-}
+
+    ParseMode parseMode{};
+    LineCarry lines;
+    State state{State::parsing};
+    std::size_t inputSize{};
+    std::size_t numberOfPairs{};
+    std::int64_t numberFullyContained{};
+    std::int64_t numberOverlapping{};
+};
+
+template <> class SessionImpl<4u> final {
+public:
+    explicit SessionImpl(const PuzzleOptions &options) : elves(options.parseMode) {}
+
+    void update(const EditableInput &input, const EditableInput::LineEdit &edit)
+    {
+        static_cast<void>(elves.update(input, edit));
+        noElfPairs = lists_no_elf_pairs(input.text());
+    }
+
+    [[nodiscard]] IPuzzle::Solutions solve() const
+    {
+        if (!elves.valid() || ((elves.size() == 0u) && !noElfPairs))
+        {
+            return {};
+        }
+        return {.part1 = static_cast<std::int64_t>(elves.totals().fullyContained),
+                .part2 = static_cast<std::int64_t>(elves.totals().overlapping)};
+    }
+
+private:
+    struct ElfPairLines final
+    {
+        using Item = ElfPairs::value_type;
+        struct Totals final
+        {
+            std::size_t fullyContained{};
+            std::size_t overlapping{};
+
+            Totals &operator+=(const Totals &other)
+            {
+                fullyContained += other.fullyContained;
+                overlapping += other.overlapping;
+                return *this;
+            }
+
+            Totals &operator-=(const Totals &other)
+            {
+                fullyContained -= other.fullyContained;
+                overlapping -= other.overlapping;
+                return *this;
+            }
+        };
+
+        static bool parse(const std::string_view line, Item &elfPair, const ParseMode mode)
+        {
+            return parse_elf_pair(line, elfPair, mode);
+        }
+
+        static Totals contribution(const Item &elfPair)
+        {
+            return {.fullyContained = fully_contained(elfPair) ? 1u : 0u,
+                    .overlapping = overlapping(elfPair) ? 1u : 0u};
+        }
+    };
+
+    ParsedLines<ElfPairLines> elves;
+    bool noElfPairs{};
+};
+
+template class Puzzle<4u>;
+template class StreamingPuzzle<4u>;
+template class PuzzleSession<4u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -121,13 +305,17 @@ R"ExampleInput(2-4,6-8
 )ExampleInput";
 consteval bool TestDay04()
 {
-
-    if (2 != std::get<std::int64_t>(part_1(exampleInput)))
+    const PuzzleImpl<4u> parsed{exampleInput};
+    if (2 != std::get<std::int64_t>(part_1(parsed.elves)))
+    {
+        return false;
+    }
+    if (parse_elf_pairs(exampleInput, ParseMode::trusted) != parsed.elves)
     {
         return false;
     }
 
-    return 4 == std::get<std::int64_t>(part_2(exampleInput));
+    return 4 == std::get<std::int64_t>(part_2(parsed.elves));
 }
 static_assert(TestDay04(), "Wrong results for example input");
 
@@ -4,12 +4,14 @@
 #include "ctre.hpp"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <numeric>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -19,16 +21,57 @@ namespace AOC::Y2022
 
 namespace {
 
+    using Stacks = ResourceVector<ResourceVector<char>>;
+
+    struct Move final {
+        std::uint32_t quantity;
+        std::uint8_t source;
+        std::uint8_t destination;
+    };
+
+    /*! \brief Starting stacks (bottom crate first) and the rearrangement procedure, shared by both parts. */
+    struct CrateArrangement final {
+        Stacks stacks;
+        ResourceVector<Move> moves;
+        bool valid{};
+    };
+
+    //! quantity, source stack and destination stack of a move, as they are written
+    using MoveNumbers = std::array<std::uint64_t, 3u>;
+
+    AOC_Y2022_CONSTEXPR bool parse_move_validated(const std::string_view line, MoveNumbers &numbers)
+    {
+        if (auto [m, quantityString, sourceString, destinationString] = ctre::match<"^move ([0-9]+) from ([0-9]+) to ([0-9]+)">(line); m)
+        {
+            numbers = MoveNumbers{parse_decimal<std::uint64_t>(quantityString), parse_decimal<std::uint64_t>(sourceString),
+                                  parse_decimal<std::uint64_t>(destinationString)};
+            return true;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_move_trusted(std::string_view line, MoveNumbers &numbers)
+    {
+        return parse_all_numbers(line, std::span{numbers}) == numbers.size();
+    }
+
     enum class SearchMode {
         crates,
         numbers,
         instructions,
     };
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(std::string_view input_string_view, bool retainOrder, const std::string_view *expectedResult = nullptr)
+    AOC_Y2022_CONSTEXPR CrateArrangement parse_crate_arrangement(std::string_view input_string_view,
+                                                                 const ParseMode parseMode = ParseMode::validate,
+                                                                 const Stacks::allocator_type &allocator = {})
     {
         const auto lines = LinesView{input_string_view};
         SearchMode mode{SearchMode::crates};
-        std::vector<std::vector<char>> stacks(10u);
+        CrateArrangement arrangement{
+            .stacks = Stacks(10u, allocator),
+            .moves = ResourceVector<Move>(allocator),
+            .valid = false,
+        };
+        auto &stacks = arrangement.stacks;
         for (const auto &line : lines)
         {
             switch (mode)
@@ -37,7 +80,7 @@ namespace {
                 {
                     if (line.size() < 3u)
                     {
-                        return std::monostate{};
+                        return {};
                     }
                     if ((line[1] >= '0') && (line[1] <= '9'))
                     {
@@ -58,7 +101,7 @@ namespace {
                         }
                         else if (!stacks[stackNumber].empty())
                         {
-                            return std::monostate{};
+                            return {};
                         }
                     }
                     break;
@@ -66,7 +109,7 @@ namespace {
                 case SearchMode::numbers:
                     if(!line.empty())
                     {
-                        return std::monostate{};
+                        return {};
                     }
                     mode = SearchMode::instructions;
                     for (auto &stack : stacks)
@@ -77,42 +120,62 @@ namespace {
                 case SearchMode::instructions:
                 {
                     const auto numOfStacks = stacks.size();
-                    if (auto [m, quantityString, sourceString, destinationString] = ctre::match<"^move ([0-9]+) from ([0-9]+) to ([0-9]+)">(line); m)
+                    if (MoveNumbers numbers{}; parse_in_mode(parseMode, line, numbers, parse_move_validated, parse_move_trusted))
                     {
-                        const auto quantity = parse_number<std::int32_t>(quantityString);
-                        const auto source = parse_number<std::size_t>(sourceString) - 1u;
-                        const auto destination = parse_number<std::size_t>(destinationString) - 1u;
-                        if ((source >= numOfStacks) || (destination >= numOfStacks))
-                        {
-                            return std::monostate{};
-                        }
-                        auto &from = stacks[source];
-                        auto &to = stacks[destination];
-                        if ((quantity < 1) || (from.size() < static_cast<std::size_t>(quantity)))
-                        {
-                            return std::monostate{};
-                        }
-                        if (retainOrder)
-                        {
-                            to.insert(to.end(), std::make_move_iterator(from.end() - quantity), std::make_move_iterator(from.end()));
-                        }
-                        else
+                        const auto quantity = static_cast<std::uint32_t>(numbers[0u]);
+                        const auto source = static_cast<std::size_t>(numbers[1u]) - 1u;
+                        const auto destination = static_cast<std::size_t>(numbers[2u]) - 1u;
+                        if ((source >= numOfStacks) || (destination >= numOfStacks) || (quantity < 1u))
                         {
-                            to.insert(to.end(), std::make_move_iterator(from.rbegin()), std::make_move_iterator(from.rbegin() + quantity));
+                            return {};
                         }
-                        from.erase(from.end() - quantity, from.end());
+                        arrangement.moves.push_back(Move{
+                            .quantity = quantity,
+                            .source = static_cast<std::uint8_t>(source),
+                            .destination = static_cast<std::uint8_t>(destination),
+                        });
                     }
                     else
                     {
-                        return std::monostate{};
+                        return {};
                     }
                     break;
                 }
                 
                 default:
-                    return std::monostate{};
+                    return {};
             }
         }
+        arrangement.valid = (mode == SearchMode::instructions);
+        return arrangement;
+    }
+
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(const CrateArrangement &arrangement, bool retainOrder, const std::string_view *expectedResult = nullptr)
+    {
+        if (!arrangement.valid)
+        {
+            return std::monostate{};
+        }
+        auto stacks = arrangement.stacks;
+        for (const auto &move : arrangement.moves)
+        {
+            auto &from = stacks[move.source];
+            auto &to = stacks[move.destination];
+            const auto quantity = static_cast<std::ptrdiff_t>(move.quantity);
+            if (from.size() < move.quantity)
+            {
+                return std::monostate{};
+            }
+            if (retainOrder)
+            {
+                to.insert(to.end(), std::make_move_iterator(from.end() - quantity), std::make_move_iterator(from.end()));
+            }
+            else
+            {
+                to.insert(to.end(), std::make_move_iterator(from.rbegin()), std::make_move_iterator(from.rbegin() + quantity));
+            }
+            from.erase(from.end() - quantity, from.end());
+        }
         if (expectedResult != nullptr)
         {
             auto remaining = expectedResult->size();
@@ -146,49 +209,45 @@ namespace {
         return result;
     }
 
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_1(std::string_view input)
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_1(const CrateArrangement &arrangement)
     {
-        return solve_part(input, false);
+        return solve_part(arrangement, false);
     }
 
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_2(std::string_view input)
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part_2(const CrateArrangement &arrangement)
     {
-        return solve_part(input, true);
+        return solve_part(arrangement, true);
     }
 
 }
 
-class PuzzleDay05Impl final {
+template <> class PuzzleImpl<5u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay05Impl(std::string_view input) : input(input) {}
-    std::string input;
-};
-
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(05)
-
-PuzzleDay05::PuzzleDay05(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay05Impl>(input))
-{
-}
-PuzzleDay05::~PuzzleDay05() = default;
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const ParseMode parseMode = ParseMode::validate,
+                                   const Stacks::allocator_type &allocator = {})
+        : arrangement(parse_crate_arrangement(input, parseMode, allocator))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : PuzzleImpl(input, options.parseMode, options.memoryResource)
+    {
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay05::Part1()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
     {
-        return std::monostate{};
+        return part_1(arrangement);
     }
-    return part_1(pImpl->input);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay05::Part2()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
     {
-        return std::monostate{};
+        return part_2(arrangement);
     }
-    return part_2(pImpl->input);
-}
+
+    static constexpr bool partsAreIndependent = true;
+    CrateArrangement arrangement;
+};
+
+template class Puzzle<5u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -206,14 +265,20 @@ move 1 from 1 to 2
 )ExampleInput";
 consteval bool TestDay05()
 {
+    const PuzzleImpl<5u> parsed{exampleInput};
     std::string_view expectPart1 = "CMZ";
-    if (1 != std::get<std::int64_t>(solve_part(exampleInput, false, &expectPart1)))
+    if (1 != std::get<std::int64_t>(solve_part(parsed.arrangement, false, &expectPart1)))
+    {
+        return false;
+    }
+    const PuzzleImpl<5u> trusted{exampleInput, ParseMode::trusted};
+    if (1 != std::get<std::int64_t>(solve_part(trusted.arrangement, false, &expectPart1)))
     {
         return false;
     }
 
     std::string_view expectPart2 = "MCD";
-    return 1 == std::get<std::int64_t>(solve_part(exampleInput, true, &expectPart2));
+    return 1 == std::get<std::int64_t>(solve_part(parsed.arrangement, true, &expectPart2));
 }
 static_assert(TestDay05(), "Wrong results for example input");
 
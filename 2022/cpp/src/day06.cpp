@@ -2,8 +2,12 @@
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <memory>
 #include <numeric>
+#include <string>
 #include <string_view>
 #include <utility>
 namespace AOC::Y2022
@@ -11,14 +15,24 @@ namespace AOC::Y2022
 
 namespace {
 
-    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(std::string_view input_string_view, const std::size_t windowSize)
+    /*! \brief Returns the datastream without its line ending, its characters are checked by solve_part. */
+    AOC_Y2022_CONSTEXPR std::string_view parse_datastream(std::string_view input_string_view)
     {
-        for (auto marker = windowSize; marker <= input_string_view.size(); ++marker)
+        while (!input_string_view.empty() && ((input_string_view.back() == '\n') || (input_string_view.back() == '\r')))
+        {
+            input_string_view.remove_suffix(1u);
+        }
+        return input_string_view;
+    }
+
+    AOC_Y2022_CONSTEXPR IPuzzle::Solution_t solve_part(std::string_view datastream, const std::size_t windowSize)
+    {
+        for (auto marker = windowSize; marker <= datastream.size(); ++marker)
         {
             std::uint32_t bitset{};
             for (std::size_t offset = windowSize; offset > 0u; --offset)
             {
-                const auto &c = input_string_view[marker - offset];
+                const auto &c = datastream[marker - offset];
                 if ((c < 'a') || (c > 'z'))
                 {
                     return std::monostate{};
@@ -51,37 +65,126 @@ namespace {
 
 }
 
-class PuzzleDay06Impl final {
+template <> class PuzzleImpl<6u> final {
 public:
-    AOC_Y2022_CONSTEXPR PuzzleDay06Impl(std::string_view input) : input(input) {}
-    std::string input;
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const PuzzleOptions &options)
+      : datastream(parse_datastream(input)), ownedDatastream(options.memoryResource)
+    {
+        if (options.inputLifetime == InputLifetime::copied)
+        {
+            ownedDatastream = datastream;
+            datastream = ownedDatastream;
+        }
+    }
+    // only the embedded input is solved without options, it lives as long as the program
+    AOC_Y2022_CONSTEXPR explicit PuzzleImpl(const std::string_view input)
+      : PuzzleImpl(input, PuzzleOptions{.inputLifetime = InputLifetime::borrowed})
+    {
+    }
+    PuzzleImpl(const PuzzleImpl &) = delete;
+    PuzzleImpl &operator=(const PuzzleImpl &) = delete;
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        if (datastream.size() < 2u)
+        {
+            return std::monostate{};
+        }
+        return part_1(datastream);
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        if (datastream.size() < 2u)
+        {
+            return std::monostate{};
+        }
+        return part_2(datastream);
+    }
+
+    static constexpr bool partsAreIndependent = true;
+    // points either into the caller's buffer (borrowed input) or into ownedDatastream
+    std::string_view datastream;
+    ResourceString ownedDatastream;
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(06)
+template <> class StreamingPuzzleImpl<6u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions & /*options*/) {}
 
-PuzzleDay06::PuzzleDay06(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay06Impl>(input))
-{
-}
-PuzzleDay06::~PuzzleDay06() = default;
+    bool push(const std::string_view chunk)
+    {
+        for (auto it = chunk.begin(); valid && (it != chunk.end()); ++it)
+        {
+            valid = add_character(*it);
+        }
+        return valid;
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay06::Part1()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+    [[nodiscard]] IPuzzle::Solutions finish() const
     {
-        return std::monostate{};
+        // markers found before an invalid character are kept, as solve_part never looks past them
+        if (length < 2u)
+        {
+            return {};
+        }
+        IPuzzle::Solutions solutions{};
+        if (markers[0u] != 0u)
+        {
+            solutions.part1 = static_cast<std::int64_t>(markers[0u]);
+        }
+        if (markers[1u] != 0u)
+        {
+            solutions.part2 = static_cast<std::int64_t>(markers[1u]);
+        }
+        return solutions;
     }
-    return part_1(pImpl->input);
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay06::Part2()
-{
-    if (!pImpl || (pImpl->input.size() < 2u))
+private:
+    static constexpr std::array<std::size_t, 2u> windowSizes{4u, 14u};
+
+    // mirrors parse_datastream and solve_part: only the last 14 characters are needed to find both markers
+    AOC_Y2022_CONSTEXPR bool add_character(const char c)
     {
-        return std::monostate{};
+        if ((c == '\n') || (c == '\r'))
+        {
+            lineEnded = true;
+            return true;
+        }
+        if (lineEnded || (c < 'a') || (c > 'z'))
+        {
+            return false;
+        }
+        window[length % window.size()] = c;
+        ++length;
+        for (std::size_t part = 0u; part < windowSizes.size(); ++part)
+        {
+            if ((markers[part] != 0u) || (length < windowSizes[part]))
+            {
+                continue;
+            }
+            std::uint32_t bitset{};
+            for (std::size_t offset = 1u; offset <= windowSizes[part]; ++offset)
+            {
+                bitset |= static_cast<std::uint32_t>(1u) << (window[(length - offset) % window.size()] - 'a');
+            }
+            if (static_cast<std::size_t>(std::popcount(bitset)) == windowSizes[part])
+            {
+                markers[part] = length;
+            }
+        }
+        return true;
     }
-    return part_2(pImpl->input);
-}
+
+    std::array<char, windowSizes.back()> window{};
+    std::array<std::size_t, windowSizes.size()> markers{};
+    std::size_t length{};
+    bool lineEnded{};
+    bool valid{true};
+};
+
+template class Puzzle<6u>;
+template class StreamingPuzzle<6u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 
@@ -41,7 +41,18 @@ namespace
             std::array<char, 32u> m_name{};
         };
     public:
-        AOC_Y2022_CONSTEXPR Directory(Directory *parent = nullptr) : parent(parent) {}
+        //! makes vectors of directories construct their elements with the vector's allocator
+        using allocator_type = ResourceAllocator<Directory>;
+
+        AOC_Y2022_CONSTEXPR Directory(Directory *parent = nullptr, const allocator_type &allocator = {})
+            : parent(parent), subdirectories(allocator), files(allocator)
+        {
+        }
+        AOC_Y2022_CONSTEXPR Directory(Directory &&other, const allocator_type &allocator)
+            : parent(other.parent), subdirectories(std::move(other.subdirectories), allocator),
+              files(std::move(other.files), allocator)
+        {
+        }
 
         AOC_Y2022_CONSTEXPR auto get_files_size() const -> size_type
         {
@@ -94,63 +105,132 @@ namespace
         }
     private:
         Directory *parent;
-        std::vector<std::pair<Name, Directory>> subdirectories;
-        std::vector<std::pair<Name, size_type>> files;
+        ResourceVector<std::pair<Name, Directory>> subdirectories;
+        ResourceVector<std::pair<Name, size_type>> files;
+    };
+
+    /*! \brief A command or a line of the output of ls. */
+    struct TerminalLine final
+    {
+        enum class Kind : std::uint8_t
+        {
+            ls, cd, dir, file,
+        };
+        Kind kind{};
+        std::string_view name{}; //!< target of cd, name of a directory or file
+        Directory::size_type size{};
+        AOC_Y2022_CONSTEXPR bool operator==(const TerminalLine &) const = default;
     };
 
-    AOC_Y2022_CONSTEXPR std::unique_ptr<Directory> parse_file_system(std::string_view input)
+    AOC_Y2022_CONSTEXPR bool parse_terminal_line_validated(const std::string_view line, TerminalLine &terminalLine)
     {
-        auto root = std::make_unique<Directory>();
+        if (line == "$ ls")
+        {
+            terminalLine = TerminalLine{.kind = TerminalLine::Kind::ls};
+            return true;
+        }
+        if (line == "$ cd /")
+        {
+            terminalLine = TerminalLine{.kind = TerminalLine::Kind::cd, .name = "/"};
+            return true;
+        }
+        if (auto [cdMatch, subdirectory] = ctre::match<"^\\$ cd ([a-zA-Z0-9]+|[.]{2})$">(line); cdMatch)
+        {
+            terminalLine = TerminalLine{.kind = TerminalLine::Kind::cd, .name = subdirectory.to_view()};
+            return true;
+        }
+        if (auto [dirMatch, dirName] = ctre::match<"^dir ([a-zA-Z0-9]+)$">(line); dirMatch)
+        {
+            terminalLine = TerminalLine{.kind = TerminalLine::Kind::dir, .name = dirName.to_view()};
+            return true;
+        }
+        if (auto [fileMatch, fileSize, fileName] = ctre::match<"([0-9]+) ([a-zA-Z0-9\\.]+)$">(line); fileMatch)
+        {
+            terminalLine = TerminalLine{
+                .kind = TerminalLine::Kind::file,
+                .name = fileName.to_view(),
+                .size = parse_decimal<Directory::size_type>(fileSize),
+            };
+            return true;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_terminal_line_trusted(const std::string_view line, TerminalLine &terminalLine)
+    {
+        constexpr std::size_t shortestLine = 3u; // a file with a single digit size and a single character name
+        if (line.size() < shortestLine)
+        {
+            return false;
+        }
+        if (line[0u] == '$')
+        {
+            terminalLine = (line[2u] == 'l') ? TerminalLine{.kind = TerminalLine::Kind::ls}
+                                             : TerminalLine{.kind = TerminalLine::Kind::cd, .name = skip_prefix(line, 5u)};
+            return true;
+        }
+        if (line.starts_with("dir "))
+        {
+            terminalLine = TerminalLine{.kind = TerminalLine::Kind::dir, .name = skip_prefix(line, 4u)};
+            return true;
+        }
+        auto rest = line;
+        const auto size = static_cast<Directory::size_type>(detail::consume_digits(rest));
+        terminalLine = TerminalLine{.kind = TerminalLine::Kind::file, .name = skip_prefix(rest, 1u), .size = size};
+        return true;
+    }
+
+    AOC_Y2022_CONSTEXPR std::unique_ptr<Directory> parse_file_system(std::string_view input,
+                                                                     const ParseMode mode = ParseMode::validate,
+                                                                     const Directory::allocator_type &allocator = {})
+    {
+        auto root = std::make_unique<Directory>(nullptr, allocator);
         Directory *current = nullptr;
         bool isLsOutput = false;
         for (const auto &line : LinesView(input))
         {
-            if (line.size() < 1u)
+            TerminalLine terminalLine{};
+            if (line.empty() ||
+                !parse_in_mode(mode, line, terminalLine, parse_terminal_line_validated, parse_terminal_line_trusted))
             {
                 return nullptr;
             }
-            if (line[0] == '$')
+            switch (terminalLine.kind)
             {
-                if (line == "$ ls")
-                {
+                case TerminalLine::Kind::ls:
                     isLsOutput = true;
                     continue;
-                }
-                isLsOutput = false;
-            }
-            if (line == "$ cd /")
-            {
-                current = root.get();
-                continue;
-            }
-            if (current == nullptr)
-            {
-                return nullptr;
-            }
-            if (auto [cdMatch, subdirectory] = ctre::match<"^\\$ cd ([a-zA-Z0-9]+|[.]{2})$">(line); cdMatch)
-            {
-                current = current->get_subdirectory(subdirectory);
-                if (current == nullptr)
-                {
-                return nullptr;
-                }
-                continue;
+                case TerminalLine::Kind::cd:
+                    isLsOutput = false;
+                    if (terminalLine.name == "/")
+                    {
+                        current = root.get();
+                        continue;
+                    }
+                    if (current == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    current = current->get_subdirectory(terminalLine.name);
+                    if (current == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    continue;
+                case TerminalLine::Kind::dir:
+                case TerminalLine::Kind::file:
+                    break;
             }
             if (!isLsOutput || (current == nullptr))
             {
                 return nullptr;
             }
-            if (auto [dirMatch, dirName] = ctre::match<"^dir ([a-zA-Z0-9]+)$">(line); dirMatch)
-            {
-                current->add_subdirectory(dirName);
-                continue;
-            }
-            if (auto [fileMatch, fileSize, fileName] = ctre::match<"([0-9]+) ([a-zA-Z0-9\\.]+)$">(line); fileMatch)
+            if (terminalLine.kind == TerminalLine::Kind::dir)
             {
-                current->add_file(fileName, parse_number<std::uint32_t>(fileSize));
+                current->add_subdirectory(terminalLine.name);
                 continue;
             }
-            return nullptr;
+            current->add_file(terminalLine.name, terminalLine.size);
         }
         return root;
     }
@@ -209,37 +289,41 @@ namespace
 } // namespace
 
 
-class PuzzleDay07Impl final {
+template <> class PuzzleImpl<7u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay07Impl(std::string_view input) : root(parse_file_system(input)) {}
-    std::unique_ptr<Directory> root;
-};
-
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(07)
-
-PuzzleDay07::PuzzleDay07(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay07Impl>(input))
-{
-}
-PuzzleDay07::~PuzzleDay07() = default;
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const ParseMode mode = ParseMode::validate,
+                                   const Directory::allocator_type &allocator = {})
+        : root(parse_file_system(input, mode, allocator))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : PuzzleImpl(input, options.parseMode, options.memoryResource)
+    {
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay07::Part1()
-{
-    if (!pImpl || (pImpl->root == nullptr))
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
     {
-        return std::monostate{};
+        if (root == nullptr)
+        {
+            return std::monostate{};
+        }
+        return part_1(*root);
     }
-    return part_1(*(pImpl->root));
-}
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay07::Part2()
-{
-    if (!pImpl || (pImpl->root == nullptr))
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
     {
-        return std::monostate{};
+        if (root == nullptr)
+        {
+            return std::monostate{};
+        }
+        return part_2(*root);
     }
-    return part_2(*(pImpl->root));
-}
+
+    static constexpr bool partsAreIndependent = true;
+    std::unique_ptr<Directory> root;
+};
+
+template class Puzzle<7u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -276,6 +360,10 @@ consteval bool TestDay07()
     {
         return false;
     }
+    if (95437 != std::get<std::int64_t>(part_1(*parse_file_system(exampleInput, ParseMode::trusted))))
+    {
+        return false;
+    }
     return (24933642 == std::get<std::int64_t>(part_2(*parse_file_system(exampleInput))));
 
 
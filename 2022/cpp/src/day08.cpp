@@ -146,29 +146,31 @@ namespace
 } // namespace
 
 
-class PuzzleDay08Impl final {
+template <> class PuzzleImpl<8u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay08Impl(std::string_view input) : forest(parse_to_vector_2d(input)) {}
-    Vector2D<std::uint8_t> forest;
-};
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const ResourceAllocator<std::uint8_t> &allocator = {})
+        : forest(parse_to_vector_2d(input, false, allocator))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options) : PuzzleImpl(input, options.memoryResource)
+    {
+    }
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(08)
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        return part_1(forest);
+    }
 
-PuzzleDay08::PuzzleDay08(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay08Impl>(input))
-{
-}
-PuzzleDay08::~PuzzleDay08() = default;
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        return part_2(forest);
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay08::Part1()
-{
-    return part_1(pImpl->forest);
-}
+    static constexpr bool partsAreIndependent = true;
+    Vector2D<std::uint8_t> forest;
+};
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay08::Part2()
-{
-    return part_2(pImpl->forest);
-}
+template class Puzzle<8u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -183,7 +185,7 @@ R"ExampleInput(30373
 
 consteval bool TestDay08()
 {
-    PuzzleDay08Impl parsed{exampleInput};
+    PuzzleImpl<8u> parsed{exampleInput};
     if (21 != std::get<std::int64_t>(part_1(parsed.forest)))
     {
         return false;
@@ -1,4 +1,5 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 #include "ctre.hpp"
@@ -23,16 +24,59 @@ namespace
         {
             up, down, left, right, max
         };
-        AOC_Y2022_CONSTEXPR Motion(Direction direction, std::uint8_t steps) : direction(direction), steps(steps) {}
+        AOC_Y2022_CONSTEXPR Motion(Direction direction = Direction::max, std::uint8_t steps = 0u)
+            : direction(direction), steps(steps)
+        {
+        }
         Direction direction;
         std::uint8_t steps;
+        AOC_Y2022_CONSTEXPR bool operator==(const Motion &) const = default;
     };
 
-    using MotionList = std::vector<Motion>;
+    using MotionList = ResourceVector<Motion>;
+
+    AOC_Y2022_CONSTEXPR auto to_direction(const char c) -> Motion::Direction
+    {
+        switch (c)
+        {
+            default: return Motion::Direction::max;
+            case 'U': return Motion::Direction::up;
+            case 'D': return Motion::Direction::down;
+            case 'L': return Motion::Direction::left;
+            case 'R': return Motion::Direction::right;
+        }
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_motion_validated(const std::string_view line, Motion &motion)
+    {
+        if (auto [match, stepsString] = ctre::match<"^[URLD] ([0-9]+)$">(line); match)
+        {
+            motion = Motion{to_direction(line[0u]), parse_decimal<std::uint8_t>(stepsString)};
+            return motion.direction != Motion::Direction::max;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_motion_trusted(const std::string_view line, Motion &motion)
+    {
+        if (line.empty())
+        {
+            return false;
+        }
+        motion = Motion{to_direction(line[0u]), parse_decimal<std::uint8_t>(skip_prefix(line, 2u))};
+        return motion.direction != Motion::Direction::max;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_motion(const std::string_view line, Motion &motion,
+                                          const ParseMode mode = ParseMode::validate)
+    {
+        return parse_in_mode(mode, line, motion, parse_motion_validated, parse_motion_trusted);
+    }
 
-    AOC_Y2022_CONSTEXPR auto parse_motions(std::string_view input) -> MotionList
+    AOC_Y2022_CONSTEXPR auto parse_motions(std::string_view input, const ParseMode mode = ParseMode::validate,
+                                           const MotionList::allocator_type &allocator = {}) -> MotionList
     {
-        MotionList motions;
+        MotionList motions(allocator);
         motions.reserve(128u);
         for (const auto &line : LinesView{input})
         {
@@ -40,26 +84,9 @@ namespace
             {
                 return motions;
             }
-            if (auto [match, stepsString] = ctre::match<"^[URLD] ([0-9]+)$">(line); match)
-            {
-                Motion::Direction direction = Motion::Direction::max;
-                switch (line[0u])
-                {
-                    default: direction = Motion::Direction::max;
-                    break; case 'U': direction = Motion::Direction::up;
-                    break; case 'D': direction = Motion::Direction::down;
-                    break; case 'L': direction = Motion::Direction::left;
-                    break; case 'R': direction = Motion::Direction::right;
-                }
-                if (direction == Motion::Direction::max)
-                {
-                    return MotionList{};
-                }
-                motions.emplace_back(direction, parse_number<std::uint8_t>(stepsString));
-            }
-            else
+            if (!parse_motion(line, motions.emplace_back(), mode))
             {
-                return MotionList{};
+                return MotionList(allocator);
             }
         }
         return motions;
@@ -120,7 +147,7 @@ namespace
         };
         std::array<Knot, RopeLen> knots{};
         knots.fill(Knot{});
-        std::vector<Position> visitedPositions{};
+        ResourceVector<Position> visitedPositions(input.get_allocator());
         const auto visit = [&visitedPositions](const Position &position) -> void {
             visitedPositions.push_back(position);
         };
@@ -157,29 +184,38 @@ namespace
 } // namespace
 
 
-class PuzzleDay09Impl final {
+template <> class PuzzleImpl<9u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay09Impl(std::string_view input) : motions(parse_motions(input)) {}
-    MotionList motions;
-};
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const MotionList::allocator_type &allocator = {})
+        : motions(parse_motions(input, ParseMode::validate, allocator))
+    {
+    }
+    AOC_Y2022_CONSTEXPR PuzzleImpl(MotionList &&motions) : motions(std::move(motions)) {}
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : motions(should_parse_in_parallel(input, options)
+                      ? parse_lines_in_parallel<Motion>(input, options,
+                            [mode = options.parseMode](const auto line, Motion &motion) {
+                                return parse_motion(line, motion, mode);
+                            })
+                      : parse_motions(input, options.parseMode, options.memoryResource))
+    {
+    }
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(09)
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        return part_1(motions);
+    }
 
-PuzzleDay09::PuzzleDay09(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay09Impl>(input))
-{
-}
-PuzzleDay09::~PuzzleDay09() = default;
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        return part_2(motions);
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay09::Part1()
-{
-    return part_1(pImpl->motions);
-}
+    static constexpr bool partsAreIndependent = true;
+    MotionList motions;
+};
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay09::Part2()
-{
-    return part_2(pImpl->motions);
-}
+template class Puzzle<9u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -208,8 +244,8 @@ U 20
 
 consteval bool TestDay09()
 {
-    PuzzleDay09Impl parsed1{exampleInput1};
-    PuzzleDay09Impl parsed2{exampleInput2};
+    PuzzleImpl<9u> parsed1{exampleInput1};
+    PuzzleImpl<9u> parsed2{exampleInput2};
     if (13 != std::get<std::int64_t>(part_1(parsed1.motions)))
     {
         return false;
@@ -218,6 +254,10 @@ consteval bool TestDay09()
     {
         return false;
     }
+    if (parse_motions(exampleInput2, ParseMode::trusted) != parsed2.motions)
+    {
+        return false;
+    }
     return (36 == std::get<std::int64_t>(part_2(parsed2.motions)));
 }
 static_assert(TestDay09(), "Wrong results for example input");
@@ -1,4 +1,5 @@
 #include "ipuzzle.hpp"
+#include "line_index.hpp"
 #include "puzzle_common.hpp"
 #include "utils.hpp"
 #include "ctre.hpp"
@@ -44,16 +45,51 @@ namespace
             noop, addx,
         };
         using Operand = std::int32_t;
-        AOC_Y2022_CONSTEXPR Instruction(Opcode opcode, Operand operand = 0) : opcode(opcode), operand(operand) {}
+        AOC_Y2022_CONSTEXPR Instruction(Opcode opcode = Opcode::noop, Operand operand = 0) : opcode(opcode), operand(operand) {}
         Opcode opcode;
         Operand operand;
+        AOC_Y2022_CONSTEXPR bool operator==(const Instruction &) const = default;
     };
 
-    using InstructionList = std::vector<Instruction>;
+    using InstructionList = ResourceVector<Instruction>;
 
-    AOC_Y2022_CONSTEXPR auto parse_motions(std::string_view input) -> InstructionList
+    AOC_Y2022_CONSTEXPR auto parse_instruction_validated(const std::string_view line, Instruction &instruction) -> bool
     {
-        InstructionList instructions;
+        if (line == "noop")
+        {
+            instruction = Instruction{Instruction::Opcode::noop};
+            return true;
+        }
+        if (auto [match, operandString] = ctre::match<"^addx (-?\\d+)$">(line); match)
+        {
+            instruction = Instruction{Instruction::Opcode::addx, parse_decimal<Instruction::Operand>(operandString)};
+            return true;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR auto parse_instruction_trusted(const std::string_view line, Instruction &instruction) -> bool
+    {
+        if (line.empty())
+        {
+            return false;
+        }
+        instruction = (line[0u] == 'n')
+            ? Instruction{Instruction::Opcode::noop}
+            : Instruction{Instruction::Opcode::addx, parse_decimal<Instruction::Operand>(skip_prefix(line, 5u))};
+        return true;
+    }
+
+    AOC_Y2022_CONSTEXPR auto parse_instruction(const std::string_view line, Instruction &instruction,
+                                               const ParseMode mode = ParseMode::validate) -> bool
+    {
+        return parse_in_mode(mode, line, instruction, parse_instruction_validated, parse_instruction_trusted);
+    }
+
+    AOC_Y2022_CONSTEXPR auto parse_motions(std::string_view input, const ParseMode mode = ParseMode::validate,
+                                           const InstructionList::allocator_type &allocator = {}) -> InstructionList
+    {
+        InstructionList instructions(allocator);
         instructions.reserve(128u);
         for (const auto &line : LinesView{input})
         {
@@ -61,18 +97,9 @@ namespace
             {
                 return instructions;
             }
-            if (line == "noop")
-            {
-                instructions.emplace_back(Instruction::Opcode::noop);
-                continue;
-            }
-            if (auto [match, operandString] = ctre::match<"^addx (-?\\d+)$">(line); match)
-            {
-                instructions.emplace_back(Instruction::Opcode::addx, parse_number<Instruction::Operand>(operandString));
-            }
-            else
+            if (!parse_instruction(line, instructions.emplace_back(Instruction::Opcode::noop), mode))
             {
-                return InstructionList{};
+                return InstructionList(allocator);
             }
         }
         return instructions;
@@ -115,6 +142,16 @@ namespace
     };
 
 
+    /*! \brief Executes one instruction, calling onEachCycle for every cycle it takes. */
+    AOC_Y2022_CONSTEXPR void execute(Cpu &cpu, std::int32_t &cycle, const Instruction &instruction, auto &onEachCycle)
+    {
+        do
+        {
+            ++cycle;
+            onEachCycle(cycle, cpu);
+        } while (Cpu::State::ready != cpu.process_instruction(instruction));
+    }
+
     AOC_Y2022_CONSTEXPR auto simulate_cpu(const InstructionList &input, auto &onEachCycle) -> bool
     {
         if (input.empty())
@@ -125,25 +162,59 @@ namespace
         std::int32_t cycle = 0;
         for (const auto &instruction : input)
         {
-            do
-            {
-                ++cycle;
-                onEachCycle(cycle, cpu);
-            } while (Cpu::State::ready != cpu.process_instruction(instruction));
+            execute(cpu, cycle, instruction, onEachCycle);
         }
         return true;
     }
 
-    AOC_Y2022_CONSTEXPR auto part_1(const InstructionList &input) -> IPuzzle::Solution_t
+    AOC_Y2022_CONSTEXPR void accumulate_signal_strength(const std::int32_t cycle, const Cpu &cpu, std::int64_t &sumOfSignalStrengths)
     {
-        std::int32_t sumOfSignalStrengths = 0;
-        const auto accumulateSignalStrengths = [&sumOfSignalStrengths](const std::int32_t cycle, const Cpu &cpu) {
-            if (((cycle - 20) % 40) != 0)
+        if (((cycle - 20) % 40) != 0)
+        {
+            return;
+        }
+        const std::int64_t signalStrength = static_cast<std::int64_t>(cycle) * cpu.get_register();
+        sumOfSignalStrengths += signalStrength;
+    }
+
+    AOC_Y2022_CONSTEXPR auto draw_pixel(const std::int32_t cycle, const Cpu &cpu, Display &display) -> bool
+    {
+        std::int32_t height{static_cast<std::int32_t>(display.rows.size())};
+        std::int32_t width{static_cast<std::int32_t>(display.rows[0].size())};
+        const std::int32_t pixel = (cycle - 1) % width;
+        const std::int32_t row = (cycle - 1) / width;
+        if (row >= height)
+        {
+            return false;
+        }
+        constexpr std::int32_t spriteWidth = 3;
+        const auto spritePosition = cpu.get_register() - (spriteWidth / 2);
+        if ((pixel >= spritePosition) && (pixel < (spritePosition + spriteWidth)))
+        {
+            display.rows[static_cast<std::size_t>(row)][static_cast<std::size_t>(pixel)] = '#';
+        }
+        return true;
+    }
+
+    AOC_Y2022_CONSTEXPR auto render_display(const Display &display) -> std::string
+    {
+        std::string output;
+        for (const auto &row : display.rows)
+        {
+            for (const auto c : row)
             {
-                return;
+                output += c;
             }
-            const decltype(sumOfSignalStrengths) signalStrength = cycle * cpu.get_register();
-            sumOfSignalStrengths += signalStrength;
+            output += '\n';
+        }
+        return output;
+    }
+
+    AOC_Y2022_CONSTEXPR auto part_1(const InstructionList &input) -> IPuzzle::Solution_t
+    {
+        std::int64_t sumOfSignalStrengths = 0;
+        const auto accumulateSignalStrengths = [&sumOfSignalStrengths](const std::int32_t cycle, const Cpu &cpu) {
+            accumulate_signal_strength(cycle, cpu, sumOfSignalStrengths);
         };
         if (simulate_cpu(input, accumulateSignalStrengths))
         {
@@ -156,21 +227,7 @@ namespace
     {
         bool noError = true;
         const auto drawToDisplay = [&display, &noError](const std::int32_t cycle, const Cpu &cpu) {
-            std::int32_t height{static_cast<std::int32_t>(display.rows.size())};
-            std::int32_t width{static_cast<std::int32_t>(display.rows[0].size())};
-            const std::int32_t pixel = (cycle - 1) % width;
-            const std::int32_t row = (cycle - 1) / width;
-            if (row >= height)
-            {
-                noError = false;
-                return;
-            }
-            constexpr std::int32_t spriteWidth = 3;
-            const auto spritePosition = cpu.get_register() - (spriteWidth / 2);
-            if ((pixel >= spritePosition) && (pixel < (spritePosition + spriteWidth)))
-            {
-                display.rows[static_cast<std::size_t>(row)][static_cast<std::size_t>(pixel)] = '#';
-            }
+            noError = draw_pixel(cycle, cpu, display) && noError;
         };
         if (simulate_cpu(input, drawToDisplay))
         {
@@ -182,43 +239,187 @@ namespace
 } // namespace
 
 
-class PuzzleDay10Impl final {
+template <> class PuzzleImpl<10u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay10Impl(std::string_view input) : instructions(parse_motions(input)) {}
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const InstructionList::allocator_type &allocator = {})
+        : instructions(parse_motions(input, ParseMode::validate, allocator))
+    {
+    }
+    AOC_Y2022_CONSTEXPR PuzzleImpl(InstructionList &&instructions) : instructions(std::move(instructions)) {}
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : instructions(should_parse_in_parallel(input, options)
+                           ? parse_lines_in_parallel<Instruction>(input, options,
+                                 [mode = options.parseMode](const auto line, auto &instruction) {
+                                     return parse_instruction(line, instruction, mode);
+                                 })
+                           : parse_motions(input, options.parseMode, options.memoryResource))
+    {
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part1() const
+    {
+        return part_1(instructions);
+    }
+
+    [[nodiscard]] AOC_Y2022_CONSTEXPR IPuzzle::Solution_t part2() const
+    {
+        Display display;
+        if (!part_2(instructions, display))
+        {
+            return std::monostate{};
+        }
+        return render_display(display);
+    }
+
+    static constexpr bool partsAreIndependent = true;
     InstructionList instructions;
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(10)
+template <> class StreamingPuzzleImpl<10u> final {
+public:
+    explicit StreamingPuzzleImpl(const PuzzleOptions &options) : parseMode(options.parseMode) {}
 
-PuzzleDay10::PuzzleDay10(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay10Impl>(input))
-{
-}
-PuzzleDay10::~PuzzleDay10() = default;
+    bool push(const std::string_view chunk)
+    {
+        if (state != State::parsing)
+        {
+            return state != State::failed;
+        }
+        lines.push(chunk, [this](const std::string_view line) { return add_instruction(line); });
+        return state != State::failed;
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay10::Part1()
-{
-    return part_1(pImpl->instructions);
-}
+    [[nodiscard]] IPuzzle::Solutions finish()
+    {
+        if (state == State::parsing)
+        {
+            lines.finish([this](const std::string_view line) { return add_instruction(line); });
+        }
+        if ((state == State::failed) || (numberOfInstructions == 0u))
+        {
+            return {};
+        }
+        IPuzzle::Solutions solutions{.part1 = sumOfSignalStrengths, .part2 = std::monostate{}};
+        if (displayValid)
+        {
+            solutions.part2 = render_display(display);
+        }
+        return solutions;
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay10::Part2()
-{
-    Display display;
-    if (!part_2(pImpl->instructions, display))
+private:
+    enum class State : std::uint8_t
     {
-        return std::monostate{};
+        parsing, stopped, failed,
+    };
+
+    // mirrors parse_motions and simulate_cpu, but executes every instruction as soon as it is parsed
+    AOC_Y2022_CONSTEXPR bool add_instruction(const std::string_view line)
+    {
+        if (line.empty())
+        {
+            state = State::stopped;
+            return false;
+        }
+        Instruction instruction{Instruction::Opcode::noop};
+        if (!parse_instruction(line, instruction, parseMode))
+        {
+            state = State::failed;
+            return false;
+        }
+        ++numberOfInstructions;
+        const auto onEachCycle = [this](const std::int32_t currentCycle, const Cpu &currentCpu) {
+            accumulate_signal_strength(currentCycle, currentCpu, sumOfSignalStrengths);
+            displayValid = draw_pixel(currentCycle, currentCpu, display) && displayValid;
+        };
+        execute(cpu, cycle, instruction, onEachCycle);
+        return true;
     }
-    std::string output;
-    for (const auto &row : display.rows)
+
+    ParseMode parseMode{};
+    LineCarry lines;
+    State state{State::parsing};
+    std::size_t numberOfInstructions{};
+    Cpu cpu{};
+    std::int32_t cycle{};
+    std::int64_t sumOfSignalStrengths{};
+    Display display{};
+    bool displayValid{true};
+};
+
+template <> class SessionImpl<10u> final {
+public:
+    explicit SessionImpl(const PuzzleOptions &options) : instructions(options.parseMode) {}
+
+    void update(const EditableInput &input, const EditableInput::LineEdit &edit)
     {
-        for (const auto c : row)
+        // the state in front of every instruction is kept, so only the instructions from the first changed one on
+        // are executed again
+        const auto resume = std::min(instructions.update(input, edit), checkpoints.size() - 1u);
+        checkpoints.resize(resume + 1u);
+        auto [cpu, cycle, sumOfSignalStrengths] = checkpoints.back();
+        for (auto pixel = static_cast<std::size_t>(cycle); pixel < (display.rows.size() * rowWidth); ++pixel)
+        {
+            display.rows[pixel / rowWidth][pixel % rowWidth] = '.';
+        }
+        const auto onEachCycle = [this, &sumOfSignalStrengths](const std::int32_t currentCycle, const Cpu &currentCpu) {
+            accumulate_signal_strength(currentCycle, currentCpu, sumOfSignalStrengths);
+            static_cast<void>(draw_pixel(currentCycle, currentCpu, display));
+        };
+        for (auto instruction = resume; instruction < instructions.size(); ++instruction)
         {
-            output += c;
+            execute(cpu, cycle, instructions[instruction], onEachCycle);
+            checkpoints.push_back(Checkpoint{.cpu = cpu, .cycle = cycle, .sumOfSignalStrengths = sumOfSignalStrengths});
         }
-        output += '\n';
     }
-    return output;
-}
+
+    [[nodiscard]] IPuzzle::Solutions solve() const
+    {
+        if (!instructions.valid() || (instructions.size() == 0u))
+        {
+            return {};
+        }
+        const auto &last = checkpoints.back();
+        IPuzzle::Solutions solutions{.part1 = last.sumOfSignalStrengths, .part2 = std::monostate{}};
+        // draw_pixel fails for every cycle behind the last row
+        if (static_cast<std::size_t>(last.cycle) <= (display.rows.size() * rowWidth))
+        {
+            solutions.part2 = render_display(display);
+        }
+        return solutions;
+    }
+
+private:
+    static constexpr std::size_t rowWidth = std::tuple_size_v<Display::Row>;
+
+    struct InstructionLines final
+    {
+        using Item = Instruction;
+        using Totals = NoTotals;
+
+        static bool parse(const std::string_view line, Instruction &instruction, const ParseMode mode)
+        {
+            return parse_instruction(line, instruction, mode);
+        }
+
+        static Totals contribution(const Instruction & /*instruction*/) { return {}; }
+    };
+
+    struct Checkpoint final
+    {
+        Cpu cpu{};
+        std::int32_t cycle{};
+        std::int64_t sumOfSignalStrengths{};
+    };
+
+    ParsedLines<InstructionLines> instructions;
+    std::vector<Checkpoint> checkpoints{Checkpoint{}}; //!< state in front of every instruction and behind the last
+    Display display{};
+};
+
+template class Puzzle<10u>;
+template class StreamingPuzzle<10u>;
+template class PuzzleSession<10u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -374,11 +575,15 @@ noop
 
 consteval bool TestDay10()
 {
-    PuzzleDay10Impl parsed1{exampleInput1};
+    PuzzleImpl<10u> parsed1{exampleInput1};
     if (13140 != std::get<std::int64_t>(part_1(parsed1.instructions)))
     {
         return false;
     }
+    if (parse_motions(exampleInput1, ParseMode::trusted) != parsed1.instructions)
+    {
+        return false;
+    }
     Display display{};
     if (!part_2(parsed1.instructions, display))
     {
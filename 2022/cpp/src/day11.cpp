@@ -10,6 +10,7 @@
 #include <iterator>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -34,48 +35,128 @@ namespace
 
     using WorryLevel = std::int64_t;
 
-    struct Monkey final
+    /*! \brief Calculation of the new worry level, an operand is either the old worry level or an immediate. */
+    struct Expression final
     {
-        std::vector<WorryLevel> items{};
         OperandType operandTypeL{};
         OperandType operandTypeR{};
         Operation operation{};
         WorryLevel immediateL{};
         WorryLevel immediateR{};
+        AOC_Y2022_CONSTEXPR bool operator==(const Expression &) const = default;
+    };
+
+    struct Monkey final
+    {
+        ResourceVector<WorryLevel> items{};
+        Expression expression{};
         WorryLevel divisor{};
         std::size_t throwTargetIfTrue{};
         std::size_t throwTargetIfFalse{};
     };
 
-    using MonkeyList = std::vector<Monkey>;
-
-#if 0
-^Monkey \\d+:$
-^  Starting items: (\\d+)(?:, \\d+)*$
-^  Operation: new = (old|\\d+) (\\+|\\-|\\*) (old|\\d+)$
-^  Test: divisible by (\\d+)$
-^    If true: throw to monkey (\\d+)$
-^    If false: throw to monkey (\\d+)$
-#endif
-    AOC_Y2022_CONSTEXPR auto parse_monkeys(std::string_view input) -> MonkeyList
+    using MonkeyList = ResourceVector<Monkey>;
+
+    constexpr std::string_view monkeyPrefix{"Monkey "};
+    constexpr std::string_view startingItemsPrefix{"  Starting items: "};
+    constexpr std::string_view operationPrefix{"  Operation: new = "};
+    constexpr std::string_view testPrefix{"  Test: divisible by "};
+    constexpr std::string_view throwTargetIfTruePrefix{"    If true: throw to monkey "};
+    constexpr std::string_view throwTargetIfFalsePrefix{"    If false: throw to monkey "};
+
+    /*! \brief Trusted parser of a line which holds a single number behind a text of fixed length. */
+    template <typename T, std::size_t PREFIX_LENGTH>
+    AOC_Y2022_CONSTEXPR bool parse_number_behind(const std::string_view line, T &number)
+    {
+        number = parse_decimal<T>(skip_prefix(line, PREFIX_LENGTH));
+        return line.size() > PREFIX_LENGTH;
+    }
+
+    AOC_Y2022_CONSTEXPR void append_items(std::string_view items, ResourceVector<WorryLevel> &parsedItems)
+    {
+        std::array<WorryLevel, 32u> buffer{};
+        while (!items.empty())
+        {
+            const auto count = parse_all_numbers(items, std::span{buffer});
+            parsedItems.insert(parsedItems.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_expression_validated(const std::string_view line, Expression &expression)
+    {
+        if (auto [m, oldL, numL, opMul, opPlus, opMinus, oldR, numR] = ctre::match<"^  Operation: new = (?:(old)|(\\d+)) (?:(\\*)|(\\+)|(-)) (?:(old)|(\\d+))$">(line); m)
+        {
+            expression = Expression{};
+            if (oldL)
+            {
+                expression.operandTypeL = OperandType::old;
+            }
+            else if (numL)
+            {
+                expression.operandTypeL = OperandType::immediate;
+                expression.immediateL = parse_decimal<WorryLevel>(numL);
+            }
+            if (oldR)
+            {
+                expression.operandTypeR = OperandType::old;
+            }
+            else if (numR)
+            {
+                expression.operandTypeR = OperandType::immediate;
+                expression.immediateR = parse_decimal<WorryLevel>(numR);
+            }
+            expression.operation = opMul ? Operation::multiply : (opPlus ? Operation::add : Operation::subtract);
+            return true;
+        }
+        return false;
+    }
+
+    AOC_Y2022_CONSTEXPR bool parse_expression_trusted(const std::string_view line, Expression &expression)
+    {
+        auto rest = skip_prefix(line, operationPrefix.size());
+        const auto takeOperand = [&rest](OperandType &type, WorryLevel &immediate) {
+            if (rest.starts_with("old"))
+            {
+                type = OperandType::old;
+                rest = skip_prefix(rest, 3u);
+                return;
+            }
+            type = OperandType::immediate;
+            immediate = static_cast<WorryLevel>(detail::consume_digits(rest));
+        };
+        expression = Expression{};
+        takeOperand(expression.operandTypeL, expression.immediateL);
+        // the operator is surrounded by single spaces
+        if (rest.size() < 4u)
+        {
+            return false;
+        }
+        expression.operation = (rest[1u] == '*') ? Operation::multiply : ((rest[1u] == '+') ? Operation::add : Operation::subtract);
+        rest = skip_prefix(rest, 3u);
+        takeOperand(expression.operandTypeR, expression.immediateR);
+        return true;
+    }
+
+    AOC_Y2022_CONSTEXPR auto parse_monkeys(std::string_view input, const ParseMode mode = ParseMode::validate,
+                                           const MonkeyList::allocator_type &allocator = {}) -> MonkeyList
     {
         enum class ParseState
         {
             emptyLine, newMonkey, startingItems, operation, test, ThrowTargetTrue, throwTargetFalse,
         };
-        MonkeyList parsedMonkeys;
+        MonkeyList parsedMonkeys(allocator);
         ParseState parse = ParseState::newMonkey;
         for (const auto &line : LinesView{input})
         {
             switch (parse)
             {
                 default:
-                    return MonkeyList{};
+                    return MonkeyList(allocator);
                 case ParseState::emptyLine:
                 {
                     if (!line.empty())
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
                     parse = ParseState::newMonkey;
                     continue;
@@ -83,137 +164,127 @@ namespace
 
                 case ParseState::newMonkey:
                 {
-                    if (auto [m, numString] = ctre::match<"^Monkey (\\d+):$">(line); m)
-                    {
-                        if (parsedMonkeys.size() != parse_number<std::size_t>(numString))
+                    const auto parseValidated = [](const std::string_view monkeyLine, std::size_t &number) {
+                        if (auto [m, numString] = ctre::match<"^Monkey (\\d+):$">(monkeyLine); m)
                         {
-                            return MonkeyList{};
+                            number = parse_decimal<std::size_t>(numString);
+                            return true;
                         }
-                        parsedMonkeys.emplace_back();
-                        parse = ParseState::startingItems;
-                        continue;
-                    }
-                    else
+                        return false;
+                    };
+                    std::size_t number{};
+                    if (!parse_in_mode(mode, line, number, parseValidated, parse_number_behind<std::size_t, monkeyPrefix.size()>) ||
+                        (parsedMonkeys.size() != number))
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    parsedMonkeys.push_back(Monkey{.items = ResourceVector<WorryLevel>(allocator)});
+                    parse = ParseState::startingItems;
+                    continue;
                 }
 
                 case ParseState::startingItems:
                 {
-                    if (auto [m, itemMatch] = ctre::match<"^  Starting items: (\\d+)(?:, \\d+)*$">(line); m)
-                    {
-                        auto &monkey = parsedMonkeys.back();
-                        auto items = line.substr(18u);
-                        while(items.size() > 0u) {
-                            const auto delimiterPosition= items.find(", ");
-                            const auto item = items.substr(0u, delimiterPosition == items.npos ? items.size() : delimiterPosition);
-                            monkey.items.push_back(parse_number<WorryLevel>(item));
-                            if (delimiterPosition == items.npos)
-                            {
-                                break;
-                            }
-                            items.remove_prefix(delimiterPosition + 2u);
+                    const auto parseValidated = [](const std::string_view itemsLine, ResourceVector<WorryLevel> &items) {
+                        if (!ctre::match<"^  Starting items: (\\d+)(?:, \\d+)*$">(itemsLine))
+                        {
+                            return false;
                         }
-                        std::reverse(monkey.items.begin(), monkey.items.end());
-                        parse = ParseState::operation;
-                        continue;
-                    }
-                    else
+                        append_items(itemsLine.substr(startingItemsPrefix.size()), items);
+                        return true;
+                    };
+                    const auto parseTrusted = [](const std::string_view itemsLine, ResourceVector<WorryLevel> &items) {
+                        append_items(skip_prefix(itemsLine, startingItemsPrefix.size()), items);
+                        return !items.empty();
+                    };
+                    auto &monkey = parsedMonkeys.back();
+                    if (!parse_in_mode(mode, line, monkey.items, parseValidated, parseTrusted))
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    std::reverse(monkey.items.begin(), monkey.items.end());
+                    parse = ParseState::operation;
+                    continue;
                 }
 
                 case ParseState::operation:
                 {
-                    if (auto [m, oldL, numL, opMul, opPlus, opMinus, oldR, numR] = ctre::match<"^  Operation: new = (?:(old)|(\\d+)) (?:(\\*)|(\\+)|(-)) (?:(old)|(\\d+))$">(line); m)
+                    if (!parse_in_mode(mode, line, parsedMonkeys.back().expression, parse_expression_validated, parse_expression_trusted))
                     {
-                        auto &monkey = parsedMonkeys.back();
-                        if (oldL)
-                        {
-                            monkey.operandTypeL = OperandType::old;
-                        }
-                        else if (numL)
-                        {
-                            monkey.operandTypeL = OperandType::immediate;
-                            monkey.immediateL = parse_number<WorryLevel>(numL);
-                        }
-                        if (oldR)
-                        {
-                            monkey.operandTypeR = OperandType::old;
-                        }
-                        else if (numR)
-                        {
-                            monkey.operandTypeR = OperandType::immediate;
-                            monkey.immediateR = parse_number<WorryLevel>(numR);
-                        }
-                        monkey.operation = opMul ? Operation::multiply : (opPlus ? Operation::add : Operation::subtract);
-                        parse = ParseState::test;
-                        continue;
-                    }
-                    else
-                    {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    parse = ParseState::test;
+                    continue;
                 }
 
                 case ParseState::test:
                 {
-                    if (auto [m, divisorString] = ctre::match<"^  Test: divisible by (\\d+)$">(line); m)
-                    {
-                        parsedMonkeys.back().divisor = parse_number<WorryLevel>(divisorString);
-                        if (0 == parsedMonkeys.back().divisor)
+                    const auto parseValidated = [](const std::string_view testLine, WorryLevel &divisor) {
+                        if (auto [m, divisorString] = ctre::match<"^  Test: divisible by (\\d+)$">(testLine); m)
                         {
-                            return MonkeyList{};
+                            divisor = parse_decimal<WorryLevel>(divisorString);
+                            return true;
                         }
-                        parse = ParseState::ThrowTargetTrue;
-                        continue;
-                    }
-                    else
+                        return false;
+                    };
+                    auto &divisor = parsedMonkeys.back().divisor;
+                    if (!parse_in_mode(mode, line, divisor, parseValidated, parse_number_behind<WorryLevel, testPrefix.size()>) ||
+                        (0 == divisor))
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    parse = ParseState::ThrowTargetTrue;
+                    continue;
                 }
 
                 case ParseState::ThrowTargetTrue:
                 {
-                    if (auto [m, targetString] = ctre::match<"^    If true: throw to monkey (\\d+)$">(line); m)
-                    {
-                        parsedMonkeys.back().throwTargetIfTrue = parse_number<std::size_t>(targetString);
-                        parse = ParseState::throwTargetFalse;
-                        continue;
-                    }
-                    else
+                    const auto parseValidated = [](const std::string_view targetLine, std::size_t &target) {
+                        if (auto [m, targetString] = ctre::match<"^    If true: throw to monkey (\\d+)$">(targetLine); m)
+                        {
+                            target = parse_decimal<std::size_t>(targetString);
+                            return true;
+                        }
+                        return false;
+                    };
+                    if (!parse_in_mode(mode, line, parsedMonkeys.back().throwTargetIfTrue, parseValidated,
+                                       parse_number_behind<std::size_t, throwTargetIfTruePrefix.size()>))
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    parse = ParseState::throwTargetFalse;
+                    continue;
                 }
 
                 case ParseState::throwTargetFalse:
                 {
-                    if (auto [m, targetString] = ctre::match<"^    If false: throw to monkey (\\d+)$">(line); m)
-                    {
-                        parsedMonkeys.back().throwTargetIfFalse = parse_number<std::size_t>(targetString);
-                        parse = ParseState::emptyLine;
-                        continue;
-                    }
-                    else
+                    const auto parseValidated = [](const std::string_view targetLine, std::size_t &target) {
+                        if (auto [m, targetString] = ctre::match<"^    If false: throw to monkey (\\d+)$">(targetLine); m)
+                        {
+                            target = parse_decimal<std::size_t>(targetString);
+                            return true;
+                        }
+                        return false;
+                    };
+                    if (!parse_in_mode(mode, line, parsedMonkeys.back().throwTargetIfFalse, parseValidated,
+                                       parse_number_behind<std::size_t, throwTargetIfFalsePrefix.size()>))
                     {
-                        return MonkeyList{};
+                        return MonkeyList(allocator);
                     }
+                    parse = ParseState::emptyLine;
+                    continue;
                 }
             }
         }
         if (parse != ParseState::emptyLine)
         {
-            return MonkeyList{};
+            return MonkeyList(allocator);
         }
         for (const auto &monkey : parsedMonkeys)
         {
             if ((monkey.divisor == 0) || (monkey.throwTargetIfTrue >= parsedMonkeys.size()) || (monkey.throwTargetIfFalse >= parsedMonkeys.size()))
             {
-                return MonkeyList{};
+                return MonkeyList(allocator);
             }
         }
         return parsedMonkeys;
@@ -228,7 +299,7 @@ namespace
             return std::monostate{};
         }
         MonkeyList playingMonkeys = monkeys;
-        std::vector<std::int64_t> numberOfInspections(numberOfMonkeys);
+        ResourceVector<std::int64_t> numberOfInspections(numberOfMonkeys, 0, monkeys.get_allocator());
         for (std::size_t round = 0u; round != ROUNDS; ++round)
         {
             for (std::size_t monkeyIdx = 0u; monkeyIdx != numberOfMonkeys; ++monkeyIdx)
@@ -243,9 +314,10 @@ namespace
                 for (std::size_t itemIdx = 0u; itemIdx != numItems; ++itemIdx)
                 {
                     const auto reverseItem = numItems - itemIdx - 1u;
-                    const auto operandL = (player.operandTypeL == OperandType::old) ? player.items[reverseItem] : player.immediateL;
-                    const auto operandR = (player.operandTypeR == OperandType::old) ? player.items[reverseItem] : player.immediateR;
-                    switch (player.operation)
+                    const auto &expression = player.expression;
+                    const auto operandL = (expression.operandTypeL == OperandType::old) ? player.items[reverseItem] : expression.immediateL;
+                    const auto operandR = (expression.operandTypeR == OperandType::old) ? player.items[reverseItem] : expression.immediateR;
+                    switch (expression.operation)
                     {
                         default:
                         return std::monostate{};
@@ -295,29 +367,33 @@ namespace
 } // namespace
 
 
-class PuzzleDay11Impl final {
+template <> class PuzzleImpl<11u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay11Impl(std::string_view input) : monkeys(parse_monkeys(input)) {}
-    MonkeyList monkeys;
-};
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const ParseMode mode = ParseMode::validate,
+                                   const MonkeyList::allocator_type &allocator = {})
+        : monkeys(parse_monkeys(input, mode, allocator))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options)
+        : PuzzleImpl(input, options.parseMode, options.memoryResource)
+    {
+    }
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(11)
+    [[nodiscard]] IPuzzle::Solution_t part1() const
+    {
+        return part_1(monkeys);
+    }
 
-PuzzleDay11::PuzzleDay11(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay11Impl>(input))
-{
-}
-PuzzleDay11::~PuzzleDay11() = default;
+    [[nodiscard]] IPuzzle::Solution_t part2() const
+    {
+        return part_2(monkeys);
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay11::Part1()
-{
-    return part_1(pImpl->monkeys);
-}
+    static constexpr bool partsAreIndependent = true;
+    MonkeyList monkeys;
+};
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay11::Part2()
-{
-    return part_2(pImpl->monkeys);
-}
+template class Puzzle<11u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -355,11 +431,16 @@ Monkey 3:
 
 consteval bool TestDay11()
 {
-    PuzzleDay11Impl parsed1{exampleInput1};
+    PuzzleImpl<11u> parsed1{exampleInput1};
     if (10605 != std::get<std::int64_t>(part_1(parsed1.monkeys)))
     {
         return false;
     }
+    PuzzleImpl<11u> trusted1{exampleInput1, ParseMode::trusted};
+    if (10605 != std::get<std::int64_t>(part_1(trusted1.monkeys)))
+    {
+        return false;
+    }
 
     // This takes way too long
     // if (2713310158 != std::get<std::int64_t>(part_2(parsed1.monkeys)))
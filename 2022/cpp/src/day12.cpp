@@ -24,8 +24,8 @@ namespace
     using Coordinate = std::int32_t;
     using Distance = Coordinate;
     using Index = std::size_t;
-    using Row = std::vector<char>;
-    using Map = std::vector<Row>;
+    using Row = ResourceVector<char>;
+    using Map = ResourceVector<Row>;
     static constexpr auto invalidIndex = std::numeric_limits<Index>::max();
     static constexpr auto infiniteDistance = std::numeric_limits<Distance>::max();
     struct Position final
@@ -41,7 +41,7 @@ namespace
     };
     struct DistanceMap final
     {
-        std::vector<std::vector<Distance>> distancesFromE{};
+        ResourceVector<ResourceVector<Distance>> distancesFromE{};
         Distance distanceFromEtoS{infiniteDistance};
     };
 
@@ -50,9 +50,10 @@ namespace
         return Position{lhs.row + rhs.row, lhs.col + rhs.col};
     }
 
-    [[nodiscard]] AOC_Y2022_CONSTEXPR auto parse_map(std::string_view input) -> Input
+    [[nodiscard]] AOC_Y2022_CONSTEXPR auto parse_map(std::string_view input,
+                                                     const Map::allocator_type &allocator = {}) -> Input
     {
-        Input parsed;
+        Input parsed{.map = Map(allocator)};
         auto &map = parsed.map;
         map.reserve(2048);
         Index currentIndex = 0u;
@@ -158,7 +159,9 @@ namespace
         constexpr Distance initialDistance = 0;
         const auto rows = map.size();
         const auto cols = map[0].size();
-        std::vector<std::vector<Distance>> distancesFromDestination(rows, std::vector<Distance>(cols, infiniteDistance));
+        const ResourceAllocator<Distance> allocator{map.get_allocator()};
+        ResourceVector<ResourceVector<Distance>> distancesFromDestination(
+            rows, ResourceVector<Distance>(cols, infiniteDistance, allocator), allocator);
         distancesFromDestination[static_cast<std::size_t>(destination.row)][static_cast<std::size_t>(destination.col)] = initialDistance;
         struct Vertex
         {
@@ -177,12 +180,15 @@ namespace
             Position position;
             Distance distance;
         };
-        std::set<Vertex> prioritySearchQueue
+        std::set<Vertex, std::less<Vertex>, ResourceAllocator<Vertex>> prioritySearchQueue
         {
             {
-                .position = destination,
-                .distance = initialDistance,
+                {
+                    .position = destination,
+                    .distance = initialDistance,
+                },
             },
+            allocator,
         };
         do
         {
@@ -217,7 +223,7 @@ namespace
         const auto distanceFromEtoS = (startIndex == invalidIndex)
             ? infiniteDistance
             : distancesFromDestination[static_cast<std::size_t>(start.row)][static_cast<std::size_t>(start.col)];
-        return { .distancesFromE = distancesFromDestination, .distanceFromEtoS = distanceFromEtoS };
+        return { .distancesFromE = std::move(distancesFromDestination), .distanceFromEtoS = distanceFromEtoS };
     }
 
     [[nodiscard]] AOC_Y2022_CONSTEXPR auto find_square_of_height(const Map &map, char searchForHeight, Index startIndex = 0u) -> Index
@@ -268,35 +274,34 @@ namespace
 
 } // namespace
 
-class PuzzleDay12Impl final {
+template <> class PuzzleImpl<12u> final {
   public:
-    PuzzleDay12Impl(std::string_view input)
-      : parsed(parse_map(input))
+    PuzzleImpl(std::string_view input, const Map::allocator_type &allocator = {})
+      : parsed(parse_map(input, allocator))
       , distancesToE(dijkstra(this->parsed))
     {
     }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options) : PuzzleImpl(input, options.memoryResource)
+    {
+    }
+
+    [[nodiscard]] IPuzzle::Solution_t part1() const
+    {
+        return part_1(distancesToE);
+    }
+
+    [[nodiscard]] IPuzzle::Solution_t part2() const
+    {
+        return part_2(distancesToE, parsed);
+    }
+
+    static constexpr bool partsAreIndependent = true;
     //  the order the class members appear in is important because
     // of cross-referencing during construction
     Input parsed;
     DistanceMap distancesToE;
 };
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(12)
-
-PuzzleDay12::PuzzleDay12(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay12Impl>(input))
-{
-}
-PuzzleDay12::~PuzzleDay12() = default;
-
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay12::Part1()
-{
-    return part_1(pImpl->distancesToE);
-}
-
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay12::Part2()
-{
-    return part_2(pImpl->distancesToE, pImpl->parsed);
-}
+template class Puzzle<12u>;
 
 } // namespace AOC::Y2022
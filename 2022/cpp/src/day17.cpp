@@ -26,16 +26,17 @@ namespace
     {
         left, right,
     };
-    using Blasts = std::vector<Blast>;
+    using Blasts = ResourceVector<Blast>;
 
-    [[nodiscard]] AOC_Y2022_CONSTEXPR auto parse(const std::string_view input) -> Blasts
+    [[nodiscard]] AOC_Y2022_CONSTEXPR auto parse(const std::string_view input,
+                                                 const Blasts::allocator_type &allocator = {}) -> Blasts
     {
-        Blasts blasts;
+        Blasts blasts(allocator);
         for (const char &c : input)
         {
             switch (c)
             {
-                default: return Blasts{};
+                default: return Blasts(allocator);
                 break; case '<': blasts.push_back(Blast::left);
                 break; case '>': blasts.push_back(Blast::right);
                 break; case '\r': case '\n': return blasts;
@@ -49,7 +50,7 @@ namespace
         buildTower, detectPeriodicity,
     };
     using Row = std::uint8_t;
-    using Chamber = std::vector<Row>;
+    using Chamber = ResourceVector<Row>;
     using Rock = std::array<Row, 4u>;
     using Displacement = int;
     static constexpr Displacement startDisplacement = 2;
@@ -154,8 +155,9 @@ namespace
             }
             return rockAndMaxDisplacement;
         };
-        Chamber chamber{};
-        std::vector<std::pair<std::int64_t, std::int64_t>> gameStates(maxRockTypes * blasts.size(), {0u, 0u});
+        Chamber chamber(blasts.get_allocator());
+        ResourceVector<std::pair<std::int64_t, std::int64_t>> gameStates(maxRockTypes * blasts.size(), {0u, 0u},
+                                                                        blasts.get_allocator());
         auto repeatedPatternHeight = std::numeric_limits<std::int64_t>::max();
         const auto repeatedPatternAcceleration = [&chamber, &repeatedPatternHeight, &rockCount, &maxRockCount](auto &savedGame) {
             const auto currentHeight = static_cast<int64_t>(chamber.size());
@@ -295,30 +297,31 @@ namespace
 
 } // namespace
 
-class PuzzleDay17Impl final {
+template <> class PuzzleImpl<17u> final {
   public:
-    AOC_Y2022_CONSTEXPR PuzzleDay17Impl(std::string_view input) : input(parse(input)) {}
-    Blasts input;
-};
-
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(17)
+    AOC_Y2022_CONSTEXPR PuzzleImpl(std::string_view input, const Blasts::allocator_type &allocator = {})
+        : input(parse(input, allocator))
+    {
+    }
+    PuzzleImpl(const std::string_view input, const PuzzleOptions &options) : PuzzleImpl(input, options.memoryResource)
+    {
+    }
 
+    [[nodiscard]] IPuzzle::Solution_t part1() const
+    {
+        return part_1(input);
+    }
 
-PuzzleDay17::PuzzleDay17(const std::string_view input)
-    : pImpl(std::make_unique<PuzzleDay17Impl>(input))
-{
-}
-PuzzleDay17::~PuzzleDay17() = default;
+    [[nodiscard]] IPuzzle::Solution_t part2() const
+    {
+        return part_2(input);
+    }
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay17::Part1()
-{
-    return part_1(pImpl->input);
-}
+    static constexpr bool partsAreIndependent = true;
+    Blasts input;
+};
 
-[[nodiscard]] IPuzzle::Solution_t PuzzleDay17::Part2()
-{
-    return part_2(pImpl->input);
-}
+template class Puzzle<17u>;
 
 #if AOC_Y2022_CONSTEXPR_UNIT_TEST
 namespace
@@ -328,7 +331,7 @@ static constexpr const char *exampleInput1 = ">>><<><>><<<>><>>><<<>>><<<><<<>><
 
 consteval bool TestDay17()
 {
-    PuzzleDay17Impl parsed1{exampleInput1};
+    PuzzleImpl<17u> parsed1{exampleInput1};
     if (3068 != std::get<std::int64_t>(part_1(parsed1.input)))
     {
         return false;
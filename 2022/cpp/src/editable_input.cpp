@@ -0,0 +1,73 @@
+#include "editable_input.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+
+namespace AOC::Y2022
+{
+
+EditableInput::EditableInput(const std::string_view input) : input(input)
+{
+    index_lines(0u, this->input.size(), lineBegins);
+}
+
+std::string_view EditableInput::operator[](const std::size_t line) const
+{
+    const std::string_view view{input};
+    const auto begin = lineBegins[line];
+    return view.substr(begin, std::min(find_line_break(view, begin), view.size()) - begin);
+}
+
+bool EditableInput::edit(const std::size_t offset, const std::size_t length, const std::string_view replacement,
+                         LineEdit &lineEdit)
+{
+    if ((offset > input.size()) || (length > (input.size() - offset)))
+    {
+        return false;
+    }
+
+    // The first line to parse again contains the offset. The last one contains the first character behind the
+    // removed range, since removing a line feed joins that line to the previous one.
+    std::size_t first = 0u;
+    std::size_t behindLast = 0u;
+    if (!lineBegins.empty())
+    {
+        const auto lineAfter = [this](const std::size_t pos) {
+            return static_cast<std::size_t>(std::upper_bound(lineBegins.begin(), lineBegins.end(), pos) -
+                                            lineBegins.begin());
+        };
+        first = lineAfter(offset) - 1u;
+        behindLast = lineAfter(offset + length);
+    }
+    const auto regionBegin = lineBegins.empty() ? 0u : lineBegins[first];
+    const auto regionEnd = (behindLast < lineBegins.size()) ? lineBegins[behindLast] : input.size();
+
+    input.replace(offset, length, replacement);
+    std::vector<std::size_t> inserted;
+    index_lines(regionBegin, regionEnd - length + replacement.size(), inserted);
+    std::for_each(lineBegins.begin() + static_cast<std::ptrdiff_t>(behindLast), lineBegins.end(),
+                  [length, &replacement](std::size_t &lineBegin) { lineBegin = lineBegin - length + replacement.size(); });
+    const auto removedBegin = lineBegins.begin() + static_cast<std::ptrdiff_t>(first);
+    lineBegins.insert(lineBegins.erase(removedBegin, lineBegins.begin() + static_cast<std::ptrdiff_t>(behindLast)),
+                      inserted.begin(), inserted.end());
+
+    lineEdit = LineEdit{.first = first, .removed = behindLast - first, .inserted = inserted.size()};
+    return true;
+}
+
+void EditableInput::index_lines(const std::size_t begin, const std::size_t end, std::vector<std::size_t> &lines) const
+{
+    const std::string_view view{input};
+    for (auto lineBegin = begin; lineBegin < end;)
+    {
+        lines.push_back(lineBegin);
+        const auto lf = detail::find_any_of<'\n'>(view, lineBegin);
+        if ((lf == std::string_view::npos) || ((lf + 1u) >= end))
+        {
+            break;
+        }
+        lineBegin = lf + 1u;
+    }
+}
+
+} // namespace AOC::Y2022
@@ -0,0 +1,203 @@
+#if !defined(AOC_Y2022_EDITABLE_INPUT_HPP)
+#define AOC_Y2022_EDITABLE_INPUT_HPP (1)
+
+#include "../include/puzzle_options.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Input of a PuzzleSession, which knows the positions of its lines and keeps them up to date on every edit.
+ *
+ * The lines are the same for_each_line produces with ParseLine::continue_if_empty, so a session can tell the
+ * puzzle exactly which lines an edit replaced.
+ */
+class EditableInput final
+{
+  public:
+    /*! \brief The lines [first, first + removed) of the input were replaced by the lines [first, first + inserted). */
+    struct LineEdit final
+    {
+        std::size_t first{};
+        std::size_t removed{};
+        std::size_t inserted{};
+    };
+
+    explicit EditableInput(std::string_view input);
+
+    /*!
+     * \brief Replaces length bytes at offset and finds the lines which changed.
+     *
+     * A line is only reported if the edit touches it, lines that merely move keep their index relative to the edit.
+     * \return false if the range is not within the input, nothing is changed then
+     */
+    bool edit(std::size_t offset, std::size_t length, std::string_view replacement, LineEdit &lineEdit);
+
+    [[nodiscard]] std::string_view text() const noexcept { return input; }
+    [[nodiscard]] std::size_t size() const noexcept { return lineBegins.size(); }
+    [[nodiscard]] std::string_view operator[](std::size_t line) const;
+    /*! \brief The edit which turns an empty input into the current one. */
+    [[nodiscard]] LineEdit all_lines() const noexcept { return LineEdit{.first = 0u, .removed = 0u, .inserted = size()}; }
+
+  private:
+    /*! \brief Appends the begin of every line starting in [begin, end), end has to be a line begin or the input size. */
+    void index_lines(std::size_t begin, std::size_t end, std::vector<std::size_t> &lines) const;
+
+    std::string input;
+    std::vector<std::size_t> lineBegins;
+};
+
+/*! \brief Totals of a ParsedLines policy for puzzles which sum nothing up. */
+struct NoTotals final
+{
+    constexpr NoTotals &operator+=(const NoTotals &) noexcept { return *this; }
+    constexpr NoTotals &operator-=(const NoTotals &) noexcept { return *this; }
+};
+
+/*!
+ * \brief Parsed lines of a session, for days whose list ends at the first empty line and is discarded as a whole if
+ *        one of its lines is invalid.
+ *
+ * After an edit, only the inserted lines are parsed and the totals are adjusted by the lines which entered or left
+ * the list. Policy provides
+ *     using Item;      // a parsed line
+ *     using Totals;    // sums over the valid lines of the list, supporting += and -=
+ *     static bool parse(std::string_view line, Item &item, ParseMode mode);
+ *     static Totals contribution(const Item &item);
+ */
+template <typename Policy> class ParsedLines final
+{
+  public:
+    using Item = typename Policy::Item;
+    using Totals = typename Policy::Totals;
+
+    explicit ParsedLines(const ParseMode mode) : parseMode(mode) {}
+
+    /*!
+     * \brief Parses the lines inserted by the edit.
+     * \return first line of the list whose item changed or moved, size() if the list did not change
+     */
+    std::size_t update(const EditableInput &input, const EditableInput::LineEdit &edit)
+    {
+        std::vector<Line> inserted(edit.inserted);
+        for (std::size_t line = 0u; line != edit.inserted; ++line)
+        {
+            const auto text = input[edit.first + line];
+            inserted[line].state = text.empty()                                        ? State::empty
+                                   : Policy::parse(text, inserted[line].item, parseMode) ? State::valid
+                                                                                         : State::invalid;
+        }
+
+        const auto oldEnd = listEnd;
+        const bool terminated = oldEnd < lines.size();
+        for (auto line = edit.first; line < std::min(edit.first + edit.removed, oldEnd); ++line)
+        {
+            remove_from_list(lines[line]);
+        }
+        const auto removedBegin = lines.begin() + static_cast<std::ptrdiff_t>(edit.first);
+        lines.insert(lines.erase(removedBegin, removedBegin + static_cast<std::ptrdiff_t>(edit.removed)),
+                     inserted.begin(), inserted.end());
+        if (edit.first > oldEnd)
+        {
+            return listEnd;
+        }
+
+        // the lines behind the edit which belonged to the list before, in their new positions
+        const auto tailBegin = edit.first + edit.inserted;
+        const auto oldTailEnd = (oldEnd >= (edit.first + edit.removed)) ? (oldEnd - edit.removed + edit.inserted)
+                                                                        : tailBegin;
+        const auto insertedEmpty = std::find_if(inserted.begin(), inserted.end(),
+                                                [](const Line &line) { return line.state == State::empty; });
+        if (insertedEmpty != inserted.end())
+        {
+            listEnd = edit.first + static_cast<std::size_t>(insertedEmpty - inserted.begin());
+        }
+        else if (!terminated)
+        {
+            listEnd = lines.size();
+        }
+        else if (oldEnd >= (edit.first + edit.removed))
+        {
+            listEnd = oldTailEnd;
+        }
+        else
+        {
+            // the empty line which ended the list was removed
+            listEnd = static_cast<std::size_t>(
+                std::find_if(lines.begin() + static_cast<std::ptrdiff_t>(tailBegin), lines.end(),
+                             [](const Line &line) { return line.state == State::empty; }) -
+                lines.begin());
+        }
+
+        for (auto line = edit.first; line < std::min(tailBegin, listEnd); ++line)
+        {
+            add_to_list(lines[line]);
+        }
+        for (auto line = std::max(oldTailEnd, tailBegin); line < listEnd; ++line)
+        {
+            add_to_list(lines[line]);
+        }
+        for (auto line = std::max(listEnd, tailBegin); line < oldTailEnd; ++line)
+        {
+            remove_from_list(lines[line]);
+        }
+        return std::min(edit.first, listEnd);
+    }
+
+    /*! \brief Number of lines in the list, which ends in front of the first empty line. */
+    [[nodiscard]] std::size_t size() const noexcept { return listEnd; }
+    /*! \brief False if a line of the list is invalid, the puzzle treats the whole list as empty then. */
+    [[nodiscard]] bool valid() const noexcept { return invalidLines == 0u; }
+    [[nodiscard]] const Item &operator[](const std::size_t line) const noexcept { return lines[line].item; }
+    /*! \brief Sum of the contributions of all valid lines of the list. */
+    [[nodiscard]] const Totals &totals() const noexcept { return listTotals; }
+
+  private:
+    enum class State : std::uint8_t
+    {
+        valid, invalid, empty,
+    };
+
+    struct Line final
+    {
+        Item item{};
+        State state{State::empty};
+    };
+
+    void add_to_list(const Line &line)
+    {
+        if (line.state == State::valid)
+        {
+            listTotals += Policy::contribution(line.item);
+            return;
+        }
+        ++invalidLines;
+    }
+
+    void remove_from_list(const Line &line)
+    {
+        if (line.state == State::valid)
+        {
+            listTotals -= Policy::contribution(line.item);
+            return;
+        }
+        --invalidLines;
+    }
+
+    ParseMode parseMode{};
+    std::vector<Line> lines;
+    std::size_t listEnd{};
+    std::size_t invalidLines{};
+    Totals listTotals{};
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_EDITABLE_INPUT_HPP)
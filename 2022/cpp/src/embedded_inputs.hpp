@@ -0,0 +1,100 @@
+#if !defined(AOC_Y2022_EMBEDDED_INPUTS_HPP)
+#define AOC_Y2022_EMBEDDED_INPUTS_HPP (1)
+
+#include "ipuzzle.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Input of the day which was embedded into the library at build time, empty if there is none.
+ *
+ * The specializations are generated from the input files if AOC_Y2022_EMBED_INPUTS is enabled in CMake.
+ */
+template <std::uint8_t day> inline constexpr std::string_view embeddedInput{};
+template <std::uint8_t day> inline constexpr bool hasEmbeddedInput = !embeddedInput<day>.empty();
+
+/*! \brief Solution of one part in a literal type, so that it can be computed by the compiler and kept as constant. */
+struct PrecomputedSolution final
+{
+    static constexpr std::size_t maxTextLength = 256u; // fits the display of day 10
+
+    enum class Kind : std::uint8_t
+    {
+        none, number, text,
+    };
+
+    Kind kind{Kind::none};
+    std::int64_t number{};
+    std::array<char, maxTextLength> text{};
+    std::size_t textLength{};
+
+    /*! \return false if the solution does not fit */
+    [[nodiscard]] constexpr bool assign(const IPuzzle::Solution_t &solution)
+    {
+        if (const auto *const pNumber = std::get_if<std::int64_t>(&solution))
+        {
+            kind = Kind::number;
+            number = *pNumber;
+        }
+        else if (const auto *const pText = std::get_if<std::string>(&solution))
+        {
+            if (pText->size() > text.size())
+            {
+                return false;
+            }
+            kind = Kind::text;
+            textLength = pText->copy(text.data(), text.size());
+        }
+        return true;
+    }
+
+    [[nodiscard]] IPuzzle::Solution_t to_solution() const
+    {
+        switch (kind)
+        {
+        case Kind::number:
+            return number;
+        case Kind::text:
+            return std::string(text.data(), textLength);
+        case Kind::none:
+        default:
+            return std::monostate{};
+        }
+    }
+};
+
+struct PrecomputedSolutions final
+{
+    bool valid{}; //!< false if a solution did not fit, the input has to be solved at runtime then
+    PrecomputedSolution part1{};
+    PrecomputedSolution part2{};
+
+    [[nodiscard]] static constexpr PrecomputedSolutions from(const IPuzzle::Solution_t &solution1,
+                                                             const IPuzzle::Solution_t &solution2)
+    {
+        PrecomputedSolutions solutions{};
+        solutions.valid = solutions.part1.assign(solution1) && solutions.part2.assign(solution2);
+        return solutions;
+    }
+
+    [[nodiscard]] IPuzzle::Solutions to_solutions() const
+    {
+        return {.part1 = part1.to_solution(), .part2 = part2.to_solution()};
+    }
+};
+
+} // namespace AOC::Y2022
+
+#if defined(AOC_Y2022_EMBED_INPUTS)
+#include "embedded_inputs_generated.hpp"
+#endif
+
+#endif // !defined(AOC_Y2022_EMBEDDED_INPUTS_HPP)
@@ -0,0 +1,98 @@
+#include "line_index.hpp"
+#include "utils.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace AOC::Y2022
+{
+
+LineIndex LineIndex::build(const std::string_view input)
+{
+    LineIndex index;
+    index.input = input;
+    index_lines(input, 0u, input.size(), index.lines);
+    return index;
+}
+
+LineIndex LineIndex::build(const std::string_view input, Scheduler &scheduler)
+{
+    // chunks much smaller than this are indexed faster than a task is scheduled
+    constexpr std::size_t minimumChunkSize = 64u * 1024u;
+    const auto chunkCount = scheduler.chunk_count(input.size(), minimumChunkSize);
+    if (chunkCount <= 1u)
+    {
+        return build(input);
+    }
+
+    // every chunk starts behind a line feed, so each task indexes the lines starting within its chunk
+    std::vector<std::size_t> chunkBegins{0u};
+    for (std::size_t chunk = 1u; chunk < chunkCount; ++chunk)
+    {
+        const auto [approximateBegin, end] = Scheduler::chunk_of(0u, input.size(), chunk, chunkCount);
+        const auto lf = detail::find_any_of<'\n'>(input, std::max(chunkBegins.back(), approximateBegin));
+        if ((lf == std::string_view::npos) || ((lf + 1u) >= input.size()))
+        {
+            break;
+        }
+        chunkBegins.push_back(lf + 1u);
+    }
+    chunkBegins.push_back(input.size());
+
+    std::vector<Lines> chunkLines(chunkBegins.size() - 1u);
+    scheduler.run(chunkLines.size(), [&input, &chunkBegins, &chunkLines](const std::size_t chunk) {
+        index_lines(input, chunkBegins[chunk], chunkBegins[chunk + 1u], chunkLines[chunk]);
+    });
+
+    LineIndex index;
+    index.input = input;
+    std::size_t numberOfLines = 0u;
+    for (const auto &lines : chunkLines)
+    {
+        numberOfLines += lines.size();
+    }
+    index.lines.reserve(numberOfLines);
+    for (const auto &lines : chunkLines)
+    {
+        index.lines.insert(index.lines.end(), lines.begin(), lines.end());
+    }
+    return index;
+}
+
+void LineIndex::index_lines(const std::string_view input, const std::size_t begin, const std::size_t end,
+                            Lines &lines)
+{
+    for (auto lineBegin = begin; lineBegin < end;)
+    {
+        const auto lineBreak = find_line_break(input, lineBegin);
+        lines.emplace_back(lineBegin, std::min(lineBreak, input.size()));
+        lineBegin = find_next_line(input, lineBreak);
+    }
+}
+
+std::vector<LineIndex::Range> LineIndex::split(const std::size_t count) const
+{
+    std::vector<Range> ranges;
+    if (count == 0u)
+    {
+        return ranges;
+    }
+    ranges.reserve(count);
+    std::size_t first = 0u;
+    for (std::size_t range = 1u; range <= count; ++range)
+    {
+        const auto boundary = (input.size() * range) / count;
+        const auto last = (range == count)
+            ? lines.size()
+            : static_cast<std::size_t>(std::distance(
+                  lines.begin(), std::lower_bound(lines.begin() + static_cast<std::ptrdiff_t>(first), lines.end(),
+                                                  boundary, [](const auto &line, const std::size_t position) {
+                                                      return line.first < position;
+                                                  })));
+        ranges.emplace_back(first, last);
+        first = last;
+    }
+    return ranges;
+}
+
+} // namespace AOC::Y2022
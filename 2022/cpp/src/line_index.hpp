@@ -0,0 +1,119 @@
+#if !defined(AOC_Y2022_LINE_INDEX_HPP)
+#define AOC_Y2022_LINE_INDEX_HPP (1)
+
+#include "../include/puzzle_options.hpp"
+#include "../include/scheduler.hpp"
+#include "resource_allocator.hpp"
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Positions of all lines of an input, giving access to any line in constant time.
+ *
+ * The lines are the same for_each_line and LinesView produce: they end in front of the first '\r' or '\n' and the
+ * next line starts behind the following '\n'. The index can be built in parallel and split into ranges of about
+ * the same size, so inputs whose lines can be parsed independently are parsed on several threads.
+ */
+class LineIndex final
+{
+  public:
+    using Range = std::pair<std::size_t, std::size_t>; //!< first line and one behind the last line
+
+    /*! \brief Indexes the input on the calling thread. */
+    [[nodiscard]] static LineIndex build(std::string_view input);
+    /*! \brief Indexes chunks of the input in parallel. */
+    [[nodiscard]] static LineIndex build(std::string_view input, Scheduler &scheduler);
+
+    [[nodiscard]] std::size_t size() const noexcept { return lines.size(); }
+    [[nodiscard]] bool empty() const noexcept { return lines.empty(); }
+    [[nodiscard]] std::string_view operator[](const std::size_t line) const noexcept
+    {
+        return input.substr(lines[line].first, lines[line].second - lines[line].first);
+    }
+
+    /*! \brief Splits all lines into count consecutive ranges which cover about the same number of characters. */
+    [[nodiscard]] std::vector<Range> split(std::size_t count) const;
+
+  private:
+    using Lines = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    static void index_lines(std::string_view input, std::size_t begin, std::size_t end, Lines &lines);
+
+    std::string_view input;
+    Lines lines; //!< begin and end of every line within the input
+};
+
+/*! \brief Inputs below this size are parsed sequentially, since starting threads would take longer. */
+inline constexpr std::size_t parallelParsingThreshold = 1024u * 1024u;
+
+/*! \brief Tells whether the input is large enough and the scheduler of the options has several threads. */
+[[nodiscard]] inline bool should_parse_in_parallel(const std::string_view input, const PuzzleOptions &options)
+{
+    return (input.size() >= parallelParsingThreshold) && (Scheduler::resolve(options.scheduler).thread_count() > 1u);
+}
+
+/*!
+ * \brief Parses an input of independent lines on several threads.
+ *
+ * fnParseLine(line, item) parses a single line and returns false if it is invalid. The result equals parsing the
+ * lines one after the other: parsing ends at the first empty line, and an invalid line in front of it makes the
+ * whole result empty.
+ */
+template <typename T>
+[[nodiscard]] ResourceVector<T> parse_lines_in_parallel(const std::string_view input, const PuzzleOptions &options,
+                                                        const auto &fnParseLine)
+{
+    struct RangeResult final
+    {
+        std::vector<T> items;
+        bool invalid{};
+        bool endedByEmptyLine{};
+    };
+    auto &scheduler = Scheduler::resolve(options.scheduler);
+    const auto index = LineIndex::build(input, scheduler);
+    const auto ranges = index.split(scheduler.chunk_count(index.size()));
+    std::vector<RangeResult> results(ranges.size());
+    scheduler.run(ranges.size(), [&index, &ranges, &results, &fnParseLine](const std::size_t idx) {
+        auto &result = results[idx];
+        result.items.reserve(ranges[idx].second - ranges[idx].first);
+        for (auto line = ranges[idx].first; line != ranges[idx].second; ++line)
+        {
+            if (index[line].empty())
+            {
+                result.endedByEmptyLine = true;
+                return;
+            }
+            if (!fnParseLine(index[line], result.items.emplace_back()))
+            {
+                result.invalid = true;
+                return;
+            }
+        }
+    });
+
+    ResourceVector<T> parsed(options.memoryResource);
+    parsed.reserve(index.size());
+    for (const auto &result : results)
+    {
+        if (result.invalid)
+        {
+            return ResourceVector<T>(options.memoryResource);
+        }
+        parsed.insert(parsed.end(), result.items.begin(), result.items.end());
+        if (result.endedByEmptyLine)
+        {
+            break;
+        }
+    }
+    return parsed;
+}
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_LINE_INDEX_HPP)
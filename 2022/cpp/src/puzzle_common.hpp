@@ -1,18 +1,197 @@
 #if !defined(AOC_Y2022_PUZZLE_COMMON_HPP)
 #define AOC_Y2022_PUZZLE_COMMON_HPP (1)
 
-#define AOC_Y2022_PUZZLE_CLASS_DECLARATION(day)                                                                        \
-    class PuzzleDay##day##Impl;                                                                                        \
-    class PuzzleDay##day final : public IPuzzle                                                                        \
-    {                                                                                                                  \
-      public:                                                                                                          \
-        explicit PuzzleDay##day(std::string_view input);                                                               \
-        [[nodiscard]] Solution_t Part1() override;                                                                     \
-        [[nodiscard]] Solution_t Part2() override;                                                                     \
-        ~PuzzleDay##day() override;                                                                                    \
-                                                                                                                       \
-      private:                                                                                                         \
-        std::unique_ptr<PuzzleDay##day##Impl> pImpl;                                                                   \
-    };
+#include "editable_input.hpp"
+#include "embedded_inputs.hpp"
+#include "istreaming_puzzle.hpp"
+#include "puzzle_options.hpp"
+#include "puzzle_registry.hpp"
+
+#include <memory>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+// The members of Puzzle and StreamingPuzzle only forward to the PuzzleImpl and StreamingPuzzleImpl of the day.
+// Every day specializes those next to its parser and instantiates both class templates, so only the source file of
+// a day needs its parsed input type.
+//
+// PuzzleImpl<day> provides:
+//     PuzzleImpl(std::string_view input, const PuzzleOptions &options);
+//     IPuzzle::Solution_t part1() const;
+//     IPuzzle::Solution_t part2() const;
+//     static constexpr bool partsAreIndependent;
+// and, if its input may be embedded, constexpr versions of
+//     explicit PuzzleImpl(std::string_view input);
+//     IPuzzle::Solution_t part1() const;
+//     IPuzzle::Solution_t part2() const;
+// StreamingPuzzleImpl<day> provides:
+//     explicit StreamingPuzzleImpl(const PuzzleOptions &options);
+//     bool push(std::string_view chunk);
+//     IPuzzle::Solutions finish();
+// SessionImpl<day> provides:
+//     explicit SessionImpl(const PuzzleOptions &options);
+//     void update(const EditableInput &input, const EditableInput::LineEdit &edit);
+//     IPuzzle::Solutions solve() const;
+
+/*! \brief Solutions of the embedded input of the day, evaluated by the compiler. */
+template <std::uint8_t day>
+    requires hasEmbeddedInput<day>
+inline constexpr PrecomputedSolutions precomputedSolutions = []() {
+    const PuzzleImpl<day> impl{embeddedInput<day>};
+    return PrecomputedSolutions::from(impl.part1(), impl.part2());
+}();
+
+/*! \brief True if the solutions of the input were computed at build time, which is done with the default options. */
+template <std::uint8_t day>
+[[nodiscard]] bool is_precomputed(const std::string_view input, const PuzzleOptions &options)
+{
+    if constexpr (hasEmbeddedInput<day>)
+    {
+        // comparing the sizes rules out nearly every other input before a single byte is looked at
+        return precomputedSolutions<day>.valid && !options.changes_solutions() && (input == embeddedInput<day>);
+    }
+    else
+    {
+        static_cast<void>(input);
+        static_cast<void>(options);
+        return false;
+    }
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+Puzzle<day>::Puzzle(const std::string_view input, const PuzzleOptions &options)
+    : pImpl(is_precomputed<day>(input, options) ? nullptr : std::make_unique<PuzzleImpl<day>>(input, options))
+{
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+Puzzle<day>::~Puzzle() = default;
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+IPuzzle::Solution_t Puzzle<day>::Part1()
+{
+    if constexpr (hasEmbeddedInput<day>)
+    {
+        if (pImpl == nullptr)
+        {
+            return precomputedSolutions<day>.part1.to_solution();
+        }
+    }
+    return pImpl->part1();
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+IPuzzle::Solution_t Puzzle<day>::Part2()
+{
+    if constexpr (hasEmbeddedInput<day>)
+    {
+        if (pImpl == nullptr)
+        {
+            return precomputedSolutions<day>.part2.to_solution();
+        }
+    }
+    return pImpl->part2();
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+bool Puzzle<day>::IsPrecomputed() const noexcept
+{
+    return pImpl == nullptr;
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+bool Puzzle<day>::PartsAreIndependent() const
+{
+    return PuzzleImpl<day>::partsAreIndependent;
+}
+
+template <std::uint8_t day>
+    requires SupportedDay<day>
+IPuzzle::Solutions Puzzle<day>::Solve(const std::string_view input, const PuzzleOptions &options)
+{
+    if constexpr (hasEmbeddedInput<day>)
+    {
+        if (is_precomputed<day>(input, options))
+        {
+            return precomputedSolutions<day>.to_solutions();
+        }
+    }
+    const PuzzleImpl<day> impl{input, options};
+    return {.part1 = impl.part1(), .part2 = impl.part2()};
+}
+
+template <std::uint8_t day>
+    requires StreamingDay<day>
+StreamingPuzzle<day>::StreamingPuzzle(const PuzzleOptions &options)
+    : pImpl(std::make_unique<StreamingPuzzleImpl<day>>(options))
+{
+}
+
+template <std::uint8_t day>
+    requires StreamingDay<day>
+StreamingPuzzle<day>::~StreamingPuzzle() = default;
+
+template <std::uint8_t day>
+    requires StreamingDay<day>
+bool StreamingPuzzle<day>::Push(const std::string_view chunk)
+{
+    return pImpl->push(chunk);
+}
+
+template <std::uint8_t day>
+    requires StreamingDay<day>
+IPuzzle::Solutions StreamingPuzzle<day>::Finish()
+{
+    return pImpl->finish();
+}
+
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+PuzzleSession<day>::PuzzleSession(const std::string_view input, const PuzzleOptions &options)
+    : pInput(std::make_unique<EditableInput>(input)), pImpl(std::make_unique<SessionImpl<day>>(options))
+{
+    pImpl->update(*pInput, pInput->all_lines());
+}
+
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+PuzzleSession<day>::~PuzzleSession() = default;
+
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+bool PuzzleSession<day>::Edit(const std::size_t offset, const std::size_t length, const std::string_view replacement)
+{
+    EditableInput::LineEdit lineEdit{};
+    if (!pInput->edit(offset, length, replacement, lineEdit))
+    {
+        return false;
+    }
+    pImpl->update(*pInput, lineEdit);
+    return true;
+}
+
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+std::string_view PuzzleSession<day>::Input() const
+{
+    return pInput->text();
+}
+
+template <std::uint8_t day>
+    requires IncrementalDay<day>
+IPuzzle::Solutions PuzzleSession<day>::Solve()
+{
+    return pImpl->solve();
+}
+
+} // namespace AOC::Y2022
 
 #endif // !defined(AOC_Y2022_PUZZLE_COMMON_HPP)
@@ -1,56 +1,197 @@
 #include "puzzle_factory.hpp"
-#include "puzzle_common.hpp"
-#include "utils.hpp"
-
-#define AOC_Y2022_SUPPORTED_PUZZLES_LIST(xMacro)                   \
-    xMacro(01)                                                     \
-    xMacro(02)                                                     \
-    xMacro(03)                                                     \
-    xMacro(04)                                                     \
-    xMacro(05)                                                     \
-    xMacro(06)                                                     \
-    xMacro(07)                                                     \
-    xMacro(08)                                                     \
-    xMacro(09)                                                     \
-    xMacro(10)                                                     \
-    xMacro(11)                                                     \
-    xMacro(12)                                                     \
-    xMacro(17)                                                     \
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <string>
 
 namespace AOC::Y2022
 {
 
-AOC_Y2022_SUPPORTED_PUZZLES_LIST(AOC_Y2022_PUZZLE_CLASS_DECLARATION)
+namespace
+{
 
-[[nodiscard]] std::unique_ptr<IPuzzle> PuzzleFactory::CreatePuzzle(const std::uint8_t game, const std::string_view input)
+/*! \brief Session of a day without an incremental implementation, which solves the whole input after every edit. */
+class RecomputingSession final : public IPuzzleSession
 {
-    switch (game)
+  public:
+    RecomputingSession(const std::uint8_t day, const std::string_view input, const PuzzleOptions &options)
+        : day(day), input(input), options(options)
     {
+        // the session owns the input, so it outlives every puzzle solving it
+        this->options.inputLifetime = InputLifetime::borrowed;
+    }
 
-    default:
-        return nullptr;
-
-#define AOC_Y2022_PUZZLE_CASE(day)                                                                                     \
-    case parse_number<std::uint8_t>(#day): /* avoid that leading zeroes are interpreted as octal */                    \
-        return std::make_unique<PuzzleDay##day>(input);
+    bool Edit(const std::size_t offset, const std::size_t length, const std::string_view replacement) override
+    {
+        if ((offset > input.size()) || (length > (input.size() - offset)))
+        {
+            return false;
+        }
+        input.replace(offset, length, replacement);
+        return true;
+    }
 
-        AOC_Y2022_SUPPORTED_PUZZLES_LIST(AOC_Y2022_PUZZLE_CASE)
+    [[nodiscard]] std::string_view Input() const override
+    {
+        return input;
+    }
 
-#undef AOC_Y2022_PUZZLE_CASE
+    [[nodiscard]] IPuzzle::Solutions Solve() override
+    {
+        IPuzzle::Solutions solutions{};
+        visit_day(day, SupportedDays{},
+                  [this, &solutions](const auto supportedDay) { solutions = solve<supportedDay>(input, options); });
+        return solutions;
     }
+
+  private:
+    std::uint8_t day{};
+    std::string input;
+    PuzzleOptions options{};
+};
+
+} // namespace
+
+[[nodiscard]] std::unique_ptr<IPuzzle> PuzzleFactory::CreatePuzzle(const std::uint8_t game, const std::string_view input,
+                                                     const PuzzleOptions &options)
+{
+    std::unique_ptr<IPuzzle> pPuzzle;
+    visit_day(game, SupportedDays{}, [&](const auto day) { pPuzzle = std::make_unique<Puzzle<day>>(input, options); });
+    return pPuzzle;
 }
 
 [[nodiscard]] bool PuzzleFactory::has_implementation_for_day(const std::uint8_t day)
 {
-    switch (day)
+    return contains_day(SupportedDays{}, day);
+}
+
+[[nodiscard]] std::unique_ptr<IStreamingPuzzle> PuzzleFactory::CreateStreamingPuzzle(const std::uint8_t day,
+                                                                                 const PuzzleOptions &options)
+{
+    std::unique_ptr<IStreamingPuzzle> pPuzzle;
+    visit_day(day, StreamingDays{},
+              [&](const auto streamingDay) { pPuzzle = std::make_unique<StreamingPuzzle<streamingDay>>(options); });
+    return pPuzzle;
+}
+
+[[nodiscard]] bool PuzzleFactory::has_streaming_implementation_for_day(const std::uint8_t day)
+{
+    return contains_day(StreamingDays{}, day);
+}
+
+[[nodiscard]] std::unique_ptr<IPuzzleSession> PuzzleFactory::CreateSession(const std::uint8_t day,
+                                                                           const std::string_view input,
+                                                                           const PuzzleOptions &options)
+{
+    std::unique_ptr<IPuzzleSession> pSession;
+    if (visit_day(day, IncrementalDays{}, [&](const auto incrementalDay) {
+            pSession = std::make_unique<PuzzleSession<incrementalDay>>(input, options);
+        }))
     {
-    #define AOC_Y2022_IS_DAY_SUPPORTED_ENTRY(day)  case parse_number<std::uint8_t>(#day):
-    AOC_Y2022_SUPPORTED_PUZZLES_LIST(AOC_Y2022_IS_DAY_SUPPORTED_ENTRY)
-    #undef AOC_Y2022_IS_DAY_SUPPORTED_ENTRY
-            return true;
-        default:
-            return false;
+        return pSession;
+    }
+    if (has_implementation_for_day(day))
+    {
+        pSession = std::make_unique<RecomputingSession>(day, input, options);
+    }
+    return pSession;
+}
+
+[[nodiscard]] bool PuzzleFactory::has_incremental_implementation_for_day(const std::uint8_t day)
+{
+    return contains_day(IncrementalDays{}, day);
+}
+
+[[nodiscard]] IPuzzle::Solutions PuzzleFactory::SolveConcurrently(IPuzzle &puzzle, Scheduler *const pScheduler)
+{
+    IPuzzle::Solutions solutions{};
+    if (puzzle.PartsAreIndependent())
+    {
+        Scheduler::resolve(pScheduler).fork_join([&solutions, &puzzle]() { solutions.part1 = puzzle.Part1(); },
+                                                 [&solutions, &puzzle]() { solutions.part2 = puzzle.Part2(); });
+        return solutions;
+    }
+    solutions.part1 = puzzle.Part1();
+    solutions.part2 = puzzle.Part2();
+    return solutions;
+}
+
+[[nodiscard]] std::vector<BatchResult> PuzzleFactory::SolveBatch(const std::span<const BatchJob> jobs,
+                                                                  const PuzzleOptions &options,
+                                                                  const std::size_t threadCount)
+{
+    std::vector<BatchResult> results(jobs.size());
+    if (jobs.empty())
+    {
+        return results;
+    }
+    std::unique_ptr<Scheduler> pOwnScheduler;
+    if (threadCount != 0u)
+    {
+        pOwnScheduler = std::make_unique<Scheduler>(std::min(threadCount, jobs.size()));
+    }
+    auto &scheduler = (pOwnScheduler != nullptr) ? *pOwnScheduler : Scheduler::resolve(options.scheduler);
+
+    std::pmr::memory_resource *const pUpstream =
+        (options.memoryResource != nullptr) ? options.memoryResource : std::pmr::new_delete_resource();
+    scheduler.run(jobs.size(), [&jobs, &results, &options, &scheduler, pUpstream](const std::size_t idx) {
+        // each job has its own arena, so no allocation in the puzzle is contended and all of it is freed at once;
+        // the input size is a good guess for the memory the parsed input needs
+        constexpr std::size_t minimumArenaSize = 4096u;
+        std::pmr::monotonic_buffer_resource arena{std::max(jobs[idx].input.size(), minimumArenaSize), pUpstream};
+        auto jobOptions = options;
+        jobOptions.inputLifetime = InputLifetime::borrowed;
+        jobOptions.memoryResource = &arena;
+        // parsing a large input in parallel shares the threads with the other jobs
+        jobOptions.scheduler = &scheduler;
+        // small inputs are dominated by the fixed cost of a solve, so the puzzle is neither allocated nor called
+        // through virtual functions here
+        results[idx].created = visit_day(jobs[idx].day, SupportedDays{}, [&](const auto day) {
+            results[idx].solutions = Puzzle<day>::Solve(jobs[idx].input, jobOptions);
+        });
+    });
+    return results;
+}
+
+[[nodiscard]] SolveReport PuzzleFactory::SolveInstrumented(const std::uint8_t day, const std::string_view input,
+                                                           const PuzzleOptions &options)
+{
+    SolveReport report{.allocationsTracked = AllocationTracker::is_installed()};
+    const auto measure = [&report](const SolveReport::Phase phase, auto &&action) {
+        AllocationTracker::reset_peak();
+        const auto before = AllocationTracker::snapshot();
+        const auto start = std::chrono::steady_clock::now();
+        action();
+        const auto end = std::chrono::steady_clock::now();
+        const auto after = AllocationTracker::snapshot();
+        report.phases[static_cast<std::size_t>(phase)] = PhaseMetrics{
+            .duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start),
+            .allocations = after.allocations - before.allocations,
+            .bytesAllocated = after.bytesAllocated - before.bytesAllocated,
+            .peakBytes = static_cast<std::uint64_t>(std::max<std::int64_t>(after.peakBytes - before.currentBytes, 0)),
+        };
+    };
+
+    // the allocation counters are per thread, so a large input is not parsed on other threads unless asked for
+    Scheduler sequential{1u};
+    auto instrumentedOptions = options;
+    if (instrumentedOptions.scheduler == nullptr)
+    {
+        instrumentedOptions.scheduler = &sequential;
+    }
+    std::unique_ptr<IPuzzle> pPuzzle;
+    measure(SolveReport::Phase::parse, [&]() { pPuzzle = CreatePuzzle(day, input, instrumentedOptions); });
+    if (pPuzzle == nullptr)
+    {
+        return report;
     }
+    report.created = true;
+    measure(SolveReport::Phase::part1, [&]() { report.part1 = pPuzzle->Part1(); });
+    measure(SolveReport::Phase::part2, [&]() { report.part2 = pPuzzle->Part2(); });
+    return report;
 }
 
 } // namespace AOC::Y2022
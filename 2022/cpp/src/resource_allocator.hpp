@@ -0,0 +1,80 @@
+#if !defined(AOC_Y2022_RESOURCE_ALLOCATOR_HPP)
+#define AOC_Y2022_RESOURCE_ALLOCATOR_HPP (1)
+
+#include "../include/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Allocator which takes its memory from a std::pmr::memory_resource, if one is given.
+ *
+ * Without a resource, and always during constant evaluation, it behaves like std::allocator. This keeps the
+ * containers of the puzzles usable in the constexpr unit tests, which std::pmr::polymorphic_allocator is not.
+ * Like polymorphic_allocator, it passes itself on to the elements of a container, so nested containers share
+ * the resource.
+ */
+template <typename T> class ResourceAllocator
+{
+  public:
+    using value_type = T;
+
+    constexpr ResourceAllocator() noexcept = default;
+    constexpr ResourceAllocator(std::pmr::memory_resource *pResource) noexcept : pResource(pResource) {}
+    template <typename U>
+    constexpr ResourceAllocator(const ResourceAllocator<U> &other) noexcept : pResource(other.resource())
+    {
+    }
+
+    [[nodiscard]] constexpr T *allocate(const std::size_t n)
+    {
+        if (std::is_constant_evaluated() || (pResource == nullptr))
+        {
+            return std::allocator<T>{}.allocate(n);
+        }
+        return static_cast<T *>(pResource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    constexpr void deallocate(T *const p, const std::size_t n)
+    {
+        if (std::is_constant_evaluated() || (pResource == nullptr))
+        {
+            std::allocator<T>{}.deallocate(p, n);
+            return;
+        }
+        pResource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U, typename... Args> constexpr void construct(U *const p, Args &&...args)
+    {
+        std::uninitialized_construct_using_allocator(p, *this, std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] constexpr std::pmr::memory_resource *resource() const noexcept
+    {
+        return pResource;
+    }
+
+    template <typename U> [[nodiscard]] constexpr bool operator==(const ResourceAllocator<U> &other) const noexcept
+    {
+        return pResource == other.resource();
+    }
+
+  private:
+    std::pmr::memory_resource *pResource{};
+};
+
+template <typename T> using ResourceVector = std::vector<T, ResourceAllocator<T>>;
+using ResourceString = std::basic_string<char, std::char_traits<char>, ResourceAllocator<char>>;
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_RESOURCE_ALLOCATOR_HPP)
@@ -0,0 +1,395 @@
+#include "result_cache.hpp"
+#include "puzzle_factory.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#if !defined(AOC_Y2022_BUILD_ID)
+// builds without the hash of the sources at least never mix up entries of differently compiled libraries
+#define AOC_Y2022_BUILD_ID __DATE__ " " __TIME__
+#endif
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+constexpr std::string_view entryMagic{"aoc-y2022-result 1"};
+constexpr std::string_view entryExtension{".result"};
+
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t value) noexcept
+{
+    // finalizer of MurmurHash3, every input bit affects every output bit
+    value ^= value >> 33u;
+    value *= 0xFF51'AFD7'ED55'8CCDull;
+    value ^= value >> 33u;
+    value *= 0xC4CE'B9FE'1A85'EC53ull;
+    value ^= value >> 33u;
+    return value;
+}
+
+[[nodiscard]] std::uint64_t load_word(const char *const pData, const std::size_t size) noexcept
+{
+    std::uint64_t word{};
+    std::memcpy(&word, pData, size);
+    return word;
+}
+
+[[nodiscard]] std::string to_hex(const std::uint64_t value)
+{
+    std::string hex(16u, '0');
+    const auto [pEnd, ec] = std::to_chars(hex.data(), hex.data() + hex.size(), value, 16);
+    static_cast<void>(ec);
+    // right-align, so the names of all entries have the same length
+    std::rotate(hex.begin(), hex.begin() + (pEnd - hex.data()), hex.end());
+    return hex;
+}
+
+void write_solution(std::string &buffer, const IPuzzle::Solution_t &solution)
+{
+    if (const auto *const pNumber = std::get_if<std::int64_t>(&solution))
+    {
+        buffer += "i " + std::to_string(*pNumber) + '\n';
+    }
+    else if (const auto *const pText = std::get_if<std::string>(&solution))
+    {
+        // prefixed by its length, since the text may contain line breaks
+        buffer += "s " + std::to_string(pText->size()) + '\n';
+        buffer += *pText;
+        buffer += '\n';
+    }
+    else
+    {
+        buffer += "n\n";
+    }
+}
+
+[[nodiscard]] std::string serialize(const ResultCache::Key &key, const IPuzzle::Solutions &solutions)
+{
+    std::string buffer{entryMagic};
+    buffer += '\n';
+    buffer += std::string{ResultCache::build_id()} + '\n';
+    buffer += std::to_string(key.day) + ' ' + std::to_string(key.inputSize) + ' ' + to_hex(key.inputHash) + '\n';
+    write_solution(buffer, solutions.part1);
+    write_solution(buffer, solutions.part2);
+    return buffer;
+}
+
+/*! \brief Reads an entry written by serialize(), rejecting everything that does not match the key exactly. */
+class EntryReader final
+{
+  public:
+    explicit EntryReader(std::string_view buffer) : remaining(buffer) {}
+
+    [[nodiscard]] std::optional<IPuzzle::Solutions> read(const ResultCache::Key &key)
+    {
+        const auto expectedKey =
+            std::to_string(key.day) + ' ' + std::to_string(key.inputSize) + ' ' + to_hex(key.inputHash);
+        if ((next_line() != entryMagic) || (next_line() != ResultCache::build_id()) || (next_line() != expectedKey))
+        {
+            return std::nullopt;
+        }
+        IPuzzle::Solutions solutions{};
+        if (!read_solution(solutions.part1) || !read_solution(solutions.part2) || !remaining.empty())
+        {
+            return std::nullopt;
+        }
+        return solutions;
+    }
+
+  private:
+    [[nodiscard]] std::optional<std::string_view> next_line()
+    {
+        const auto lf = remaining.find('\n');
+        if (lf == remaining.npos)
+        {
+            return std::nullopt;
+        }
+        const auto line = remaining.substr(0u, lf);
+        remaining.remove_prefix(lf + 1u);
+        return line;
+    }
+
+    template <typename T> [[nodiscard]] static bool parse_exactly(const std::string_view text, T &value)
+    {
+        const auto [pEnd, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return (ec == std::errc{}) && (pEnd == (text.data() + text.size()));
+    }
+
+    [[nodiscard]] bool read_solution(IPuzzle::Solution_t &solution)
+    {
+        const auto line = next_line();
+        if (!line || line->empty())
+        {
+            return false;
+        }
+        const auto value = (line->size() > 2u) ? line->substr(2u) : std::string_view{};
+        switch ((*line)[0])
+        {
+        case 'n':
+            solution = std::monostate{};
+            return line->size() == 1u;
+        case 'i': {
+            std::int64_t number{};
+            if (!parse_exactly(value, number))
+            {
+                return false;
+            }
+            solution = number;
+            return true;
+        }
+        case 's': {
+            std::size_t length{};
+            if (!parse_exactly(value, length) || (remaining.size() <= length) || (remaining[length] != '\n'))
+            {
+                return false;
+            }
+            solution = std::string{remaining.substr(0u, length)};
+            remaining.remove_prefix(length + 1u);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    std::string_view remaining;
+};
+
+/*! \brief Answers both parts from solutions found in the cache, the input is never looked at. */
+class CachedPuzzle final : public IPuzzle
+{
+  public:
+    explicit CachedPuzzle(Solutions cachedSolutions) : solutions(std::move(cachedSolutions)) {}
+
+    [[nodiscard]] Solution_t Part1() override { return solutions.part1; }
+    [[nodiscard]] Solution_t Part2() override { return solutions.part2; }
+    [[nodiscard]] bool PartsAreIndependent() const override { return true; }
+
+  private:
+    Solutions solutions;
+};
+
+/*! \brief Forwards to the real puzzle and stores the solutions once both parts are solved. */
+class RecordingPuzzle final : public IPuzzle
+{
+  public:
+    RecordingPuzzle(std::unique_ptr<IPuzzle> pSolvingPuzzle, ResultCache &resultCache, const ResultCache::Key &key)
+        : pPuzzle(std::move(pSolvingPuzzle)), cache(resultCache), cacheKey(key)
+    {
+    }
+
+    [[nodiscard]] Solution_t Part1() override { return record(pPuzzle->Part1(), part1); }
+    [[nodiscard]] Solution_t Part2() override { return record(pPuzzle->Part2(), part2); }
+    [[nodiscard]] bool PartsAreIndependent() const override { return pPuzzle->PartsAreIndependent(); }
+
+  private:
+    // both parts may be solved concurrently, see PuzzleFactory::SolveConcurrently
+    Solution_t record(Solution_t solution, std::optional<Solution_t> &part)
+    {
+        const std::lock_guard lock{mutex};
+        const auto alreadyStored = part1.has_value() && part2.has_value();
+        part = solution;
+        if (!alreadyStored && part1.has_value() && part2.has_value())
+        {
+            cache.Store(cacheKey, Solutions{*part1, *part2});
+        }
+        return solution;
+    }
+
+    std::unique_ptr<IPuzzle> pPuzzle;
+    ResultCache &cache;
+    ResultCache::Key cacheKey;
+    std::mutex mutex;
+    std::optional<Solution_t> part1{};
+    std::optional<Solution_t> part2{};
+};
+
+} // namespace
+
+ResultCache::ResultCache(std::filesystem::path directory, const std::uint64_t limit)
+    : cacheDirectory(std::move(directory)), sizeLimit(limit)
+{
+}
+
+std::string_view ResultCache::build_id() noexcept
+{
+    return AOC_Y2022_BUILD_ID;
+}
+
+std::uint64_t ResultCache::hash_input(const std::string_view input) noexcept
+{
+    constexpr std::uint64_t multiplier = 0x9E37'79B9'7F4A'7C15ull;
+    constexpr std::size_t wordSize = sizeof(std::uint64_t);
+    // one multiplication per 8 bytes keeps hashing far below the cost of parsing
+    std::uint64_t hash = input.size() * multiplier;
+    std::size_t pos = 0u;
+    for (; (pos + wordSize) <= input.size(); pos += wordSize)
+    {
+        hash = (std::rotl(hash, 29) ^ load_word(input.data() + pos, wordSize)) * multiplier;
+    }
+    if (pos < input.size())
+    {
+        hash = (std::rotl(hash, 29) ^ load_word(input.data() + pos, input.size() - pos)) * multiplier;
+    }
+    return mix(hash);
+}
+
+ResultCache::Key ResultCache::make_key(const std::uint8_t day, const std::string_view input) noexcept
+{
+    return Key{day, input.size(), hash_input(input)};
+}
+
+std::optional<IPuzzle::Solutions> ResultCache::Lookup(const std::uint8_t day, const std::string_view input)
+{
+    return Lookup(make_key(day, input));
+}
+
+std::optional<IPuzzle::Solutions> ResultCache::Lookup(const Key &key)
+{
+    const auto path = entry_path(key);
+    std::optional<IPuzzle::Solutions> solutions{};
+    {
+        const std::lock_guard lock{mutex};
+        std::ifstream file{path, std::ios::binary};
+        if (file)
+        {
+            const std::string buffer{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+            solutions = EntryReader{buffer}.read(key);
+        }
+        if (solutions)
+        {
+            // the modification time tells eviction which entries were used recently
+            std::error_code ec;
+            std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+        }
+    }
+    ++(solutions ? hitCount : missCount);
+    return solutions;
+}
+
+void ResultCache::Store(const std::uint8_t day, const std::string_view input, const IPuzzle::Solutions &solutions)
+{
+    Store(make_key(day, input), solutions);
+}
+
+void ResultCache::Store(const Key &key, const IPuzzle::Solutions &solutions)
+{
+    const auto buffer = serialize(key, solutions);
+    const auto path = entry_path(key);
+    // written next to the entry and renamed, so other processes never read a partially written entry
+    auto temporaryPath = path;
+    temporaryPath += ".tmp" + to_hex(std::random_device{}());
+
+    const std::lock_guard lock{mutex};
+    std::error_code ec;
+    std::filesystem::create_directories(cacheDirectory, ec);
+    {
+        std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+        if (!file.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+        {
+            file.close();
+            std::filesystem::remove(temporaryPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(temporaryPath, path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temporaryPath, ec);
+        return;
+    }
+    evict();
+}
+
+std::unique_ptr<IPuzzle> ResultCache::CreatePuzzle(const std::uint8_t day, const std::string_view input,
+                                                   const PuzzleOptions &options)
+{
+    if (!PuzzleFactory::has_implementation_for_day(day))
+    {
+        return nullptr;
+    }
+    // the key only covers the solutions of the questions of the puzzle text
+    if (options.changes_solutions())
+    {
+        return PuzzleFactory::CreatePuzzle(day, input, options);
+    }
+    const auto key = make_key(day, input);
+    if (auto solutions = Lookup(key))
+    {
+        return std::make_unique<CachedPuzzle>(std::move(*solutions));
+    }
+    // trusted parsing of a malformed input gives solutions which a validating run must not be served
+    if (options.parseMode == ParseMode::trusted)
+    {
+        return PuzzleFactory::CreatePuzzle(day, input, options);
+    }
+    return std::make_unique<RecordingPuzzle>(PuzzleFactory::CreatePuzzle(day, input, options), *this, key);
+}
+
+std::filesystem::path ResultCache::entry_path(const Key &key) const
+{
+    // the build id is part of the name, so entries of another build are replaced instead of read over and over
+    const auto buildHash = hash_input(build_id());
+    const auto nameHash = mix(key.inputHash ^ std::rotl(buildHash, 17) ^ (key.inputSize * 0x9E37'79B9'7F4A'7C15ull));
+    auto fileName = std::to_string(key.day) + '_' + to_hex(nameHash);
+    fileName += entryExtension;
+    return cacheDirectory / fileName;
+}
+
+void ResultCache::evict()
+{
+    struct Entry final
+    {
+        std::filesystem::path path;
+        std::filesystem::file_time_type lastUse;
+        std::uint64_t size;
+    };
+    std::vector<Entry> entries;
+    std::uint64_t totalSize{};
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it{cacheDirectory, ec}, end; !ec && (it != end); it.increment(ec))
+    {
+        if (it->path().extension() != entryExtension)
+        {
+            continue;
+        }
+        std::error_code entryError;
+        const auto size = it->file_size(entryError);
+        const auto lastUse = it->last_write_time(entryError);
+        if (!entryError)
+        {
+            entries.push_back(Entry{it->path(), lastUse, size});
+            totalSize += size;
+        }
+    }
+    if (totalSize <= sizeLimit)
+    {
+        return;
+    }
+    std::ranges::sort(entries, {}, &Entry::lastUse);
+    for (const auto &entry : entries)
+    {
+        if (totalSize <= sizeLimit)
+        {
+            break;
+        }
+        if (std::filesystem::remove(entry.path, ec))
+        {
+            totalSize -= entry.size;
+            ++evictionCount;
+        }
+    }
+}
+
+} // namespace AOC::Y2022
@@ -0,0 +1,92 @@
+#include "scheduler.hpp"
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define AOC_Y2022_HAS_THREADS (1)
+#endif
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+/*! \brief The calling thread takes part in every fork/join, so the pool only needs the remaining threads. */
+[[nodiscard]] std::size_t worker_count_for(const std::size_t threadCount)
+{
+#if defined(AOC_Y2022_HAS_THREADS)
+    return ((threadCount != 0u) ? threadCount : Scheduler::hardware_thread_count()) - 1u;
+#else
+    static_cast<void>(threadCount);
+    return 0u;
+#endif
+}
+
+} // namespace
+
+Scheduler::Scheduler(const std::size_t threadCount)
+    : pPool(std::make_unique<WorkStealingPool>(worker_count_for(threadCount)))
+{
+}
+
+Scheduler::~Scheduler() = default;
+
+Scheduler &Scheduler::shared()
+{
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+Scheduler &Scheduler::resolve(Scheduler *const pScheduler)
+{
+    return (pScheduler != nullptr) ? *pScheduler : shared();
+}
+
+std::size_t Scheduler::hardware_thread_count() noexcept
+{
+#if defined(AOC_Y2022_HAS_THREADS)
+    return std::max(std::thread::hardware_concurrency(), 1u);
+#else
+    return 1u;
+#endif
+}
+
+std::size_t Scheduler::thread_count() const noexcept
+{
+    return pPool->worker_count() + 1u;
+}
+
+void Scheduler::run(const std::size_t taskCount, const std::function<void(std::size_t)> &fnTask)
+{
+    if ((taskCount == 1u) || (thread_count() == 1u))
+    {
+        for (std::size_t task = 0u; task < taskCount; ++task)
+        {
+            fnTask(task);
+        }
+        return;
+    }
+    WorkStealingPool::TaskGroup group;
+    for (std::size_t task = 0u; task < taskCount; ++task)
+    {
+        pPool->submit([&fnTask, task]() { fnTask(task); }, group);
+    }
+    pPool->wait(group);
+}
+
+std::size_t Scheduler::chunk_count(const std::size_t size, const std::size_t grainSize) const noexcept
+{
+    constexpr std::size_t chunksPerThread = 4u;
+    const auto maximumChunks = size / std::max<std::size_t>(grainSize, 1u);
+    return std::clamp<std::size_t>(thread_count() * chunksPerThread, 1u, std::max<std::size_t>(maximumChunks, 1u));
+}
+
+void Scheduler::fork_join(const std::span<const std::function<void()>> tasks)
+{
+    run(tasks.size(), [&tasks](const std::size_t task) { tasks[task](); });
+}
+
+} // namespace AOC::Y2022
@@ -1,19 +1,131 @@
 #if !defined(AOC_Y2022_UTILS_HPP)
 #define AOC_Y2022_UTILS_HPP (1)
 
+#include "../include/puzzle_options.hpp"
 #include "../include/types.hpp"
+#include "resource_allocator.hpp"
 
 #include <array>
+#include <bit>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <limits>
+#include <span>
+#include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+//! compares every trusted parse with the validating parse, enabled in debug builds unless set explicitly
+#if !defined(AOC_Y2022_CHECK_TRUSTED_PARSING)
+#if defined(NDEBUG)
+#define AOC_Y2022_CHECK_TRUSTED_PARSING (0)
+#else
+#define AOC_Y2022_CHECK_TRUSTED_PARSING (1)
+#endif
+#endif
+
+#if defined(__AVX2__)
+#define AOC_Y2022_SIMD_AVX2 (1)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define AOC_Y2022_SIMD_SSE2 (1)
+#include <emmintrin.h>
+#endif
+
 namespace AOC::Y2022
 {
 
+namespace detail
+{
+
+/*! \brief Returns the first position at or behind pos holding one of the NEEDLES, or std::string_view::npos. */
+template <char... NEEDLES> constexpr std::size_t find_any_of_scalar(const std::string_view input, std::size_t pos)
+{
+    for (; pos < input.size(); ++pos)
+    {
+        if (((input[pos] == NEEDLES) || ...))
+        {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(AOC_Y2022_SIMD_AVX2) || defined(AOC_Y2022_SIMD_SSE2)
+/*! \brief Same as find_any_of_scalar, but compares a whole register of characters at once. */
+template <char... NEEDLES> inline std::size_t find_any_of_simd(const std::string_view input, std::size_t pos)
+{
+    const char *const data = input.data();
+    const auto size = input.size();
+#if defined(AOC_Y2022_SIMD_AVX2)
+    constexpr std::size_t blockSize = 32u;
+    for (; (pos + blockSize) <= size; pos += blockSize)
+    {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+        auto matches = _mm256_setzero_si256();
+        ((matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(block, _mm256_set1_epi8(NEEDLES)))), ...);
+        if (const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(matches)); mask != 0u)
+        {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+#else
+    constexpr std::size_t blockSize = 16u;
+    for (; (pos + blockSize) <= size; pos += blockSize)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+        auto matches = _mm_setzero_si128();
+        ((matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(NEEDLES)))), ...);
+        if (const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches)); mask != 0u)
+        {
+            return pos + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+    return find_any_of_scalar<NEEDLES...>(input, pos);
+}
+#endif
+
+/*! \brief Vectorized search for any of the NEEDLES, falls back to a plain loop during constant evaluation. */
+template <char... NEEDLES> constexpr std::size_t find_any_of(const std::string_view input, const std::size_t pos)
+{
+#if defined(AOC_Y2022_SIMD_AVX2) || defined(AOC_Y2022_SIMD_SSE2)
+    if (!std::is_constant_evaluated())
+    {
+        return find_any_of_simd<NEEDLES...>(input, pos);
+    }
+#endif
+    return find_any_of_scalar<NEEDLES...>(input, pos);
+}
+
+} // namespace detail
+
+/*! \brief Position of the first '\r' or '\n' at or behind pos, which is where the line containing pos ends. */
+constexpr std::size_t find_line_break(const std::string_view input, const std::size_t pos = 0u)
+{
+    return detail::find_any_of<'\r', '\n'>(input, pos);
+}
+
+/*!
+ * \brief Position at which the line following the line break at lineBreak starts, or npos if there is none.
+ *
+ * Only a '\r' needs a further search for the '\n' ending the line, so a line is scanned once in the common case.
+ */
+constexpr std::size_t find_next_line(const std::string_view input, const std::size_t lineBreak)
+{
+    if (lineBreak >= input.size())
+    {
+        return std::string_view::npos;
+    }
+    const auto lf = (input[lineBreak] == '\n') ? lineBreak : detail::find_any_of<'\n'>(input, lineBreak);
+    return ((lf == std::string_view::npos) || ((lf + 1u) >= input.size())) ? std::string_view::npos : (lf + 1u);
+}
+
 /*!
  * \brief Enum class representing the behavior of for_each_line when an empty line is encountered.
  *        break_if_empty: for_each_line will return false when it encounters an empty line.
@@ -41,8 +153,8 @@ constexpr bool for_each_line(std::string_view input, auto &&fnLineCb, ParseLine
 {
     while (!input.empty())
     {
-        const auto crOrLn = input.find_first_of("\r\n");
-        const auto line = (crOrLn == input.npos) ? input.substr(0) : input.substr(0, crOrLn);
+        const auto lineBreak = find_line_break(input);
+        const auto line = input.substr(0, lineBreak);
         if ((mode == ParseLine::break_if_empty) && line.empty())
         {
             return false;
@@ -51,16 +163,77 @@ constexpr bool for_each_line(std::string_view input, auto &&fnLineCb, ParseLine
         {
             return false;
         }
-        const auto lf = input.find('\n');
-        if (lf == input.npos)
+        const auto nextLine = find_next_line(input, lineBreak);
+        if (nextLine == input.npos)
         {
             return true;
         }
-        input.remove_prefix(lf + 1u);
+        input.remove_prefix(nextLine);
     }
     return true;
 }
 
+/*!
+ * \brief Splits input that arrives in chunks of arbitrary size into the same lines for_each_line would produce.
+ *
+ * Lines that are completely contained in a chunk are passed on as views into the chunk, only a line which
+ * crosses a chunk boundary is copied. Thus, the memory usage is bounded by the longest line.
+ */
+class LineCarry final
+{
+  public:
+    /*!
+     * \brief Calls fnLineCb for every line completed by the chunk.
+     * \return false as soon as fnLineCb returns false, the remaining lines of the chunk are skipped then
+     */
+    AOC_Y2022_CONSTEXPR bool push(std::string_view chunk, auto &&fnLineCb)
+    {
+        while (!chunk.empty())
+        {
+            const auto lineBreak = find_line_break(chunk);
+            const auto lf = ((lineBreak == chunk.npos) || (chunk[lineBreak] == '\n'))
+                ? lineBreak
+                : detail::find_any_of<'\n'>(chunk, lineBreak);
+            if (lf == chunk.npos)
+            {
+                carry.append(chunk);
+                return true;
+            }
+            auto line = chunk.substr(0u, lineBreak);
+            if (!carry.empty())
+            {
+                carry.append(chunk.substr(0u, lf));
+                line = carry;
+                line = line.substr(0u, line.find('\r'));
+            }
+            chunk.remove_prefix(lf + 1u);
+            const bool proceed = fnLineCb(line);
+            carry.clear();
+            if (!proceed)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*! \brief Passes on the last line if the input does not end with a line feed. */
+    AOC_Y2022_CONSTEXPR bool finish(auto &&fnLineCb)
+    {
+        if (carry.empty())
+        {
+            return true;
+        }
+        const std::string_view line{carry};
+        const bool proceed = fnLineCb(line.substr(0u, line.find('\r')));
+        carry.clear();
+        return proceed;
+    }
+
+  private:
+    std::string carry;
+};
+
 /*!
  * \brief A view class that provides an iterator over the lines in a given string.
  *
@@ -106,7 +279,10 @@ class LinesView final
         using pointer = T*;
         using reference = T&;
       public:
-        constexpr Iterator(const T *view = nullptr, S pos = T::npos) : view(view), pos(pos) {}
+        constexpr Iterator(const T *view = nullptr, S pos = T::npos) : view(view), pos(pos)
+        {
+            find_line_break();
+        }
 
         constexpr Iterator &operator++()
         {
@@ -115,9 +291,8 @@ class LinesView final
                 pos = T::npos;
                 return *this;
             }
-            const auto ln = view->find('\n', pos);
-            const auto behindLn = ln + 1u;
-            pos = ((ln == T::npos) || (behindLn >= view->size())) ? T::npos : behindLn;
+            pos = find_next_line(std::string_view{*view}, lineBreak);
+            find_line_break();
             return *this;
         }
         constexpr T operator*() const
@@ -126,9 +301,7 @@ class LinesView final
             {
                 return std::string_view{};
             }
-            const auto crOrLn = view->find_first_of("\r\n", pos);
-            const auto line = (crOrLn == view->npos) ? view->substr(pos) : view->substr(pos, crOrLn - pos);
-            return line;
+            return view->substr(pos, lineBreak - pos);
         }
 
         constexpr bool operator!=(const Iterator &other) const
@@ -137,8 +310,17 @@ class LinesView final
         };
 
       private:
+        // the end of the current line is searched once and shared by dereferencing and advancing the iterator
+        constexpr void find_line_break()
+        {
+            lineBreak = ((view == nullptr) || (pos >= view->size()))
+                ? pos
+                : static_cast<S>(AOC::Y2022::find_line_break(std::string_view{*view}, pos));
+        }
+
         const T *view;
         S pos{0u};
+        S lineBreak{T::npos};
     };
   public:
     constexpr LinesView(const T view) : view(view) {}
@@ -225,12 +407,295 @@ static_assert(-14 == parse_number<int>("- 1110", 2));
 static_assert(0xFFFF == parse_number<unsigned int>(" +  FFFF", 16));
 static_assert(0xDEADBEEFul == parse_number<unsigned int>(" +  DeADbEEF", 16));
 
-template <typename T, char DELIMITER> AOC_Y2022_CONSTEXPR std::vector<T> parse_to_vector_of_numbers(std::string_view str)
+namespace detail
+{
+
+/*!
+ * \brief Loads up to 8 characters into a word, the first character into the least significant byte.
+ *
+ * Missing characters are zero, which is not a digit, so the word can be passed to swar_digit_mask as it is.
+ */
+constexpr std::uint64_t load_swar_word(const std::string_view str)
+{
+    const auto count = (str.size() < 8u) ? str.size() : 8u;
+    std::uint64_t word = 0u;
+    if (std::is_constant_evaluated() || (std::endian::native != std::endian::little))
+    {
+        for (std::size_t idx = 0u; idx < count; ++idx)
+        {
+            word |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(str[idx])) << (8u * idx);
+        }
+        return word;
+    }
+    std::memcpy(&word, str.data(), count);
+    return word;
+}
+
+/*! \brief Sets the most significant bit of every byte of the word that holds a decimal digit. */
+constexpr std::uint64_t swar_digit_mask(const std::uint64_t word)
+{
+    constexpr std::uint64_t lowBits = 0x7F7F'7F7F'7F7F'7F7Full;
+    constexpr std::uint64_t highBits = 0x8080'8080'8080'8080ull;
+    // the additions cannot carry into the next byte, as the high bit of every byte is cleared beforehand
+    const auto atLeast0 = ((word & lowBits) + 0x5050'5050'5050'5050ull) & highBits;
+    const auto above9 = ((word & lowBits) + 0x4646'4646'4646'4646ull) & highBits;
+    return atLeast0 & ~above9 & ~word & highBits;
+}
+
+/*! \brief Converts the first 1 to 8 characters of the word, which have to be digits, to their value. */
+constexpr std::uint64_t swar_digits_to_number(std::uint64_t word, const std::size_t digits)
+{
+    word -= 0x3030'3030'3030'3030ull;
+    // moves the digits into the most significant bytes, so the cleared bytes become leading zeroes
+    word <<= 8u * (8u - digits);
+    word = ((word * 10u) + (word >> 8u)) & 0x00FF'00FF'00FF'00FFull;
+    word = ((word * 100u) + (word >> 16u)) & 0x0000'FFFF'0000'FFFFull;
+    word = ((word * 10'000u) + (word >> 32u)) & 0x0000'0000'FFFF'FFFFull;
+    return word;
+}
+
+inline constexpr std::array<std::uint64_t, 9u> swarPowersOf10{1u, 10u, 100u, 1'000u, 10'000u, 100'000u, 1'000'000u,
+                                                              10'000'000u, 100'000'000u};
+
+/*! \brief Consumes the leading decimal digits of str, 8 at a time, and returns their value modulo 2^64. */
+constexpr std::uint64_t consume_digits(std::string_view &str)
+{
+    constexpr auto &powersOf10 = swarPowersOf10;
+    std::uint64_t value = 0u;
+    while (true)
+    {
+        const auto word = load_swar_word(str);
+        const auto nonDigits = ~swar_digit_mask(word) & 0x8080'8080'8080'8080ull;
+        const auto digits = static_cast<std::size_t>(std::countr_zero(nonDigits)) / 8u;
+        if (digits == 0u)
+        {
+            return value;
+        }
+        value = (value * powersOf10[digits]) + swar_digits_to_number(word, digits);
+        str.remove_prefix(digits);
+        if (digits < 8u)
+        {
+            return value;
+        }
+    }
+}
+
+/*!
+ * \brief Variant of consume_digits which fails instead of wrapping around.
+ * \return false if the value does not fit into 64 bits, the digits are only consumed in part then
+ */
+constexpr bool consume_digits_checked(std::string_view &str, std::uint64_t &value)
+{
+    value = 0u;
+    while (true)
+    {
+        const auto word = load_swar_word(str);
+        const auto nonDigits = ~swar_digit_mask(word) & 0x8080'8080'8080'8080ull;
+        const auto digits = static_cast<std::size_t>(std::countr_zero(nonDigits)) / 8u;
+        if (digits == 0u)
+        {
+            return true;
+        }
+        const auto wordValue = swar_digits_to_number(word, digits);
+        // nothing can overflow while the first word is converted, which is all of nearly every number
+        if ((value != 0u) && (value > ((std::numeric_limits<std::uint64_t>::max() - wordValue) / swarPowersOf10[digits])))
+        {
+            return false;
+        }
+        value = (value * swarPowersOf10[digits]) + wordValue;
+        str.remove_prefix(digits);
+        if (digits < 8u)
+        {
+            return true;
+        }
+    }
+}
+
+/*!
+ * \brief Skips the spaces and signs in front of a number.
+ * \return false if the number is negative, but T is unsigned
+ */
+template <typename T> constexpr bool skip_sign(std::string_view &str, bool &negative)
+{
+    for (; !str.empty(); str.remove_prefix(1u))
+    {
+        const auto c = str.front();
+        if (c == '-')
+        {
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                return false;
+            }
+            negative = true;
+            continue;
+        }
+        if ((c != '+') && (c != ' '))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+template <typename T> constexpr T apply_sign(const std::uint64_t value, [[maybe_unused]] const bool negative)
+{
+    if constexpr (std::is_signed_v<T>)
+    {
+        return static_cast<T>(negative ? (0u - value) : value);
+    }
+    else
+    {
+        return static_cast<T>(value);
+    }
+}
+
+} // namespace detail
+
+/*!
+ * \brief Base 10 variant of parse_number, which converts 8 digits per step with SWAR arithmetic.
+ *
+ * Accepts the same input as parse_number: leading spaces and signs are skipped, parsing stops at the first
+ * character that is not a digit. parse_number stays the reference implementation for all bases.
+ */
+template <typename T> constexpr T parse_decimal(std::string_view str)
+{
+    bool negative = false;
+    if (!detail::skip_sign<std::decay_t<T>>(str, negative))
+    {
+        return T{0};
+    }
+    return detail::apply_sign<std::decay_t<T>>(detail::consume_digits(str), negative);
+}
+static_assert(5 == parse_decimal<int>("5"));
+static_assert(50 == parse_decimal<int>(" 50"));
+static_assert(450 == parse_decimal<int>(" +   450fdsgs"));
+static_assert(-21 == parse_decimal<int>("- 21"));
+static_assert(0u == parse_decimal<unsigned int>("-21"));
+static_assert(1234567890123456789ll == parse_decimal<long long>("1234567890123456789\n"));
+static_assert(12345678u == parse_decimal<std::uint32_t>("12345678"));
+static_assert(0u == parse_decimal<std::uint32_t>("\n1"));
+
+/*!
+ * \brief Variant of parse_decimal which reports numbers that do not fit into T instead of wrapping around.
+ *
+ * Checking costs a comparison per number and a division per 8 digits beyond the first 8.
+ * \return false if the number does not fit, value is left unchanged then
+ */
+template <typename T> constexpr bool parse_decimal_checked(std::string_view str, T &value)
+{
+    bool negative = false;
+    if (!detail::skip_sign<T>(str, negative))
+    {
+        value = T{0};
+        return true;
+    }
+    std::uint64_t magnitude = 0u;
+    if (!detail::consume_digits_checked(str, magnitude))
+    {
+        return false;
+    }
+    const auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+    if (magnitude > limit)
+    {
+        return false;
+    }
+    value = detail::apply_sign<T>(magnitude, negative);
+    return true;
+}
+static_assert([]() {
+    std::uint64_t u64{};
+    std::uint32_t u32{};
+    std::int8_t i8{};
+    std::int64_t i64{};
+    return parse_decimal_checked("18446744073709551615", u64) && (u64 == std::numeric_limits<std::uint64_t>::max()) &&
+           !parse_decimal_checked("18446744073709551616", u64) && !parse_decimal_checked("99999999999999999999", u64) &&
+           parse_decimal_checked("000000000000000000000000012\n", u64) && (u64 == 12u) &&
+           parse_decimal_checked("4294967295", u32) && !parse_decimal_checked("4294967296", u32) &&
+           parse_decimal_checked("-128", i8) && (i8 == -128) && !parse_decimal_checked("128", i8) &&
+           parse_decimal_checked("-9223372036854775808", i64) && (i64 == std::numeric_limits<std::int64_t>::min()) &&
+           !parse_decimal_checked("9223372036854775808", i64) && parse_decimal_checked("", u32) && (u32 == 0u);
+}());
+
+/*! \brief Adds two unsigned numbers, giving the largest value instead of wrapping around. */
+template <typename T>
+    requires std::is_unsigned_v<T>
+constexpr T add_saturated(const T lhs, const T rhs) noexcept
+{
+    const T sum = lhs + rhs;
+    return (sum < lhs) ? std::numeric_limits<T>::max() : sum;
+}
+static_assert(std::numeric_limits<std::uint64_t>::max() ==
+              add_saturated<std::uint64_t>(std::numeric_limits<std::uint64_t>::max() - 1u, 2u));
+static_assert(7u == add_saturated<std::uint64_t>(3u, 4u));
+
+/*!
+ * \brief Parses the decimal numbers in the buffer into numbers, in the order they appear.
+ *
+ * Any character that is not a digit separates numbers; for signed types, a '-' right in front of the digits makes
+ * the number negative. Runs of separators are skipped 8 characters at a time. The parsed part is removed from the
+ * buffer, so parsing can continue once the numbers have been processed.
+ * \return count of numbers written, parsing stops once numbers is full
+ */
+template <typename T, std::size_t EXTENT>
+constexpr std::size_t parse_all_numbers(std::string_view &buffer, const std::span<T, EXTENT> numbers)
+{
+    std::size_t count = 0u;
+    while ((count < numbers.size()) && !buffer.empty())
+    {
+        const auto digits = detail::swar_digit_mask(detail::load_swar_word(buffer));
+        if (digits == 0u)
+        {
+            // a '-' ending the window may be the sign of a number in the next one
+            const auto window = (buffer.size() < 8u) ? buffer.size() : 8u;
+            buffer.remove_prefix(((window > 1u) && (buffer[window - 1u] == '-')) ? (window - 1u) : window);
+            continue;
+        }
+        const auto separators = static_cast<std::size_t>(std::countr_zero(digits)) / 8u;
+        const bool negative = (separators > 0u) && (buffer[separators - 1u] == '-');
+        buffer.remove_prefix(separators);
+        numbers[count++] = detail::apply_sign<T>(detail::consume_digits(buffer), negative);
+    }
+    return count;
+}
+
+/*!
+ * \brief Parses a single line with the validating or the trusted parser of a day, depending on the parse mode.
+ *
+ * Both parsers take (line, item) and return false if they cannot parse the line. The trusted parser only has to
+ * handle well-formed lines. With AOC_Y2022_CHECK_TRUSTED_PARSING, a trusted parse asserts that the validating
+ * parser comes to the same result.
+ */
+template <typename T>
+constexpr bool parse_in_mode(const ParseMode mode, const std::string_view line, T &item, const auto &fnValidate,
+                             const auto &fnTrusted)
+{
+    if (mode == ParseMode::validate)
+    {
+        return fnValidate(line, item);
+    }
+    const bool parsed = fnTrusted(line, item);
+#if AOC_Y2022_CHECK_TRUSTED_PARSING
+    T validatedItem{};
+    [[maybe_unused]] const bool valid = fnValidate(line, validatedItem);
+    assert((valid == parsed) && (!valid || (validatedItem == item)) && "trusted parsing of a malformed line");
+#endif
+    return parsed;
+}
+
+/*! \brief Returns the rest of the line behind a prefix of known length, or an empty view if the line is shorter. */
+constexpr std::string_view skip_prefix(const std::string_view line, const std::size_t prefixLength)
+{
+    return (line.size() > prefixLength) ? line.substr(prefixLength) : std::string_view{};
+}
+
+template <typename T, char DELIMITER>
+AOC_Y2022_CONSTEXPR ResourceVector<T> parse_to_vector_of_numbers(std::string_view str,
+                                                                const ResourceAllocator<T> &allocator = {})
 {
-    std::vector<T> ret{};
+    ResourceVector<T> ret(allocator);
     for (std::size_t start = 0; str.size(); str.remove_prefix(start + 1))
     {
-        ret.push_back(parse_number<T>(str));
+        ret.push_back(parse_decimal<T>(str));
         start = str.find_first_of(DELIMITER);
         if (start == str.npos)
         {
@@ -250,7 +715,8 @@ template <typename T, std::size_t N> consteval auto vector_to_array(const std::v
 template <typename T> class Vector2D
 {
   public:
-    [[nodiscard]] AOC_Y2022_CONSTEXPR Vector2D(std::size_t width, std::vector<T> &&vec) : m_width(width), m_vec(vec)
+    [[nodiscard]] AOC_Y2022_CONSTEXPR Vector2D(std::size_t width, ResourceVector<T> &&vec)
+        : m_width(width), m_vec(std::move(vec))
     {
     }
 
@@ -314,13 +780,14 @@ template <typename T> class Vector2D
 
   private:
     std::size_t m_width;
-    std::vector<T> m_vec;
+    ResourceVector<T> m_vec;
 };
 
-[[nodiscard]] AOC_Y2022_CONSTEXPR inline Vector2D<std::uint8_t> parse_to_vector_2d(std::string_view input,
-                                                                                   const bool requireSquare = false)
+[[nodiscard]] AOC_Y2022_CONSTEXPR inline Vector2D<std::uint8_t>
+parse_to_vector_2d(std::string_view input, const bool requireSquare = false,
+                   const ResourceAllocator<std::uint8_t> &allocator = {})
 {
-    std::vector<std::uint8_t> parsed;
+    ResourceVector<std::uint8_t> parsed(allocator);
     parsed.reserve(input.size());
     std::size_t width{0};
     auto forEachLine = [&parsed, &width](const std::string_view &line) -> bool {
@@ -348,7 +815,7 @@ template <typename T> class Vector2D
     };
     if (!for_each_line(input, forEachLine) || !validateShape())
     {
-        return {0, std::vector<std::uint8_t>()};
+        return {0, ResourceVector<std::uint8_t>(allocator)};
     }
     else
     {
@@ -0,0 +1,193 @@
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+thread_local const WorkStealingPool *currentPool = nullptr;
+thread_local std::size_t currentWorker = 0u;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(const std::size_t workerCount)
+{
+    const auto queueCount = std::max<std::size_t>(workerCount, 1u);
+    queues.reserve(queueCount);
+    for (std::size_t idx = 0u; idx < queueCount; ++idx)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    workers.reserve(workerCount);
+    for (std::size_t idx = 0u; idx < workerCount; ++idx)
+    {
+        workers.emplace_back([this, idx]() { worker_loop(idx); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        const std::lock_guard lock(stateMutex);
+        stopping = true;
+    }
+    stateChanged.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    enqueue({.task = std::move(task)});
+}
+
+void WorkStealingPool::submit(Task task, TaskGroup &group)
+{
+    group.pendingTasks.fetch_add(1u);
+    enqueue({.task = std::move(task), .pGroup = &group});
+}
+
+void WorkStealingPool::enqueue(QueuedTask task)
+{
+    const auto queueIndex = (currentPool == this) ? currentWorker : (nextQueue++ % queues.size());
+    pendingTasks.fetch_add(1u);
+    // counted before it is published, so taking it from the queue can never wrap the counter around
+    queuedTasks.fetch_add(1u);
+    {
+        const std::lock_guard lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->tasks.push_back(std::move(task));
+    }
+    // taking the lock orders the notification after a waiter's check of queuedTasks
+    {
+        const std::lock_guard lock(stateMutex);
+    }
+    stateChanged.notify_all();
+}
+
+void WorkStealingPool::wait()
+{
+    const auto ownQueue = (currentPool == this) ? currentWorker : 0u;
+    while (pendingTasks.load() != 0u)
+    {
+        if (try_run_one(ownQueue))
+        {
+            continue;
+        }
+        std::unique_lock lock(stateMutex);
+        stateChanged.wait(lock, [this]() { return (pendingTasks.load() == 0u) || (queuedTasks.load() != 0u); });
+    }
+    std::unique_lock lock(stateMutex);
+    if (auto taskError = std::exchange(error, nullptr))
+    {
+        lock.unlock();
+        std::rethrow_exception(std::move(taskError));
+    }
+}
+
+void WorkStealingPool::wait(TaskGroup &group)
+{
+    const auto ownQueue = (currentPool == this) ? currentWorker : 0u;
+    while (group.pendingTasks.load() != 0u)
+    {
+        if (try_run_one(ownQueue))
+        {
+            continue;
+        }
+        std::unique_lock lock(stateMutex);
+        stateChanged.wait(lock,
+                          [this, &group]() { return (group.pendingTasks.load() == 0u) || (queuedTasks.load() != 0u); });
+    }
+    // no task of the group is left to touch the error
+    if (auto taskError = std::exchange(group.error, nullptr))
+    {
+        std::rethrow_exception(std::move(taskError));
+    }
+}
+
+void WorkStealingPool::keep_error(std::exception_ptr taskError, TaskGroup *const pGroup)
+{
+    const std::lock_guard lock((pGroup != nullptr) ? pGroup->errorMutex : stateMutex);
+    auto &firstError = (pGroup != nullptr) ? pGroup->error : error;
+    if (!firstError)
+    {
+        firstError = std::move(taskError);
+    }
+}
+
+bool WorkStealingPool::try_run_one(const std::size_t ownQueue)
+{
+    QueuedTask task;
+    for (std::size_t offset = 0u; (offset < queues.size()) && !task.task; ++offset)
+    {
+        auto &queue = *queues[(ownQueue + offset) % queues.size()];
+        const std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+        // the own queue is used like a stack for locality, other queues are robbed from the opposite end
+        if (offset == 0u)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task.task)
+    {
+        return false;
+    }
+    queuedTasks.fetch_sub(1u);
+    // the counters below have to drop even if the task throws, the group and the task's captures outlive it only
+    // until then
+    try
+    {
+        task.task();
+    }
+    catch (...)
+    {
+        keep_error(std::current_exception(), task.pGroup);
+    }
+    // the waiter may destroy the group as soon as its counter drops to zero, it must not be touched afterwards
+    const bool groupFinished = (task.pGroup != nullptr) && (task.pGroup->pendingTasks.fetch_sub(1u) == 1u);
+    if ((pendingTasks.fetch_sub(1u) == 1u) || groupFinished)
+    {
+        // taking the lock orders the notification after a waiter's check of pendingTasks
+        {
+            const std::lock_guard lock(stateMutex);
+        }
+        stateChanged.notify_all();
+    }
+    return true;
+}
+
+void WorkStealingPool::worker_loop(const std::size_t index)
+{
+    currentPool = this;
+    currentWorker = index;
+    while (true)
+    {
+        if (try_run_one(index))
+        {
+            continue;
+        }
+        std::unique_lock lock(stateMutex);
+        stateChanged.wait(lock, [this]() { return stopping || (queuedTasks.load() != 0u); });
+        if (stopping && (queuedTasks.load() == 0u))
+        {
+            return;
+        }
+    }
+}
+
+} // namespace AOC::Y2022
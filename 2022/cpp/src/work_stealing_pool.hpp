@@ -0,0 +1,94 @@
+#if !defined(AOC_Y2022_WORK_STEALING_POOL_HPP)
+#define AOC_Y2022_WORK_STEALING_POOL_HPP (1)
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+/*!
+ * \brief Thread pool with one task queue per worker.
+ *
+ * Workers take tasks from the back of their own queue and steal from the front of the other queues once theirs
+ * is empty, so a few expensive tasks do not leave the remaining workers idle. The thread calling wait() helps
+ * executing tasks; a pool without workers runs everything there. Tasks may submit and wait for further tasks
+ * through a TaskGroup, which makes nested fork/join possible without blocking a worker. An exception thrown by a
+ * task is kept and rethrown by the wait() for it once all its tasks have finished, further ones are dropped.
+ */
+class WorkStealingPool final
+{
+  public:
+    using Task = std::function<void()>;
+
+    /*! \brief Tasks which are waited for together, independent of the other tasks of the pool. */
+    class TaskGroup final
+    {
+        friend class WorkStealingPool;
+        std::atomic<std::size_t> pendingTasks{0u};
+        std::mutex errorMutex;
+        std::exception_ptr error; //!< first exception thrown by a task of the group
+    };
+
+    explicit WorkStealingPool(std::size_t workerCount);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+    WorkStealingPool(WorkStealingPool &&) = delete;
+    WorkStealingPool &operator=(WorkStealingPool &&) = delete;
+
+    /*! \brief Queues a task, tasks submitted from a worker go to that worker's queue. */
+    void submit(Task task);
+    void submit(Task task, TaskGroup &group);
+    /*! \brief Blocks until all submitted tasks have finished, rethrows the first exception of a task without group. */
+    void wait();
+    /*!
+     * \brief Runs queued tasks of any group until all tasks of the given group have finished.
+     *
+     * Rethrows the first exception thrown by a task of the group afterwards.
+     */
+    void wait(TaskGroup &group);
+
+    [[nodiscard]] std::size_t worker_count() const noexcept { return workers.size(); }
+
+  private:
+    struct QueuedTask final
+    {
+        Task task;
+        TaskGroup *pGroup{};
+    };
+
+    struct Queue final
+    {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;
+    };
+
+    void enqueue(QueuedTask task);
+
+    [[nodiscard]] bool try_run_one(std::size_t ownQueue);
+    void keep_error(std::exception_ptr error, TaskGroup *pGroup);
+    void worker_loop(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex stateMutex;
+    std::condition_variable stateChanged; //!< a task was queued or finished, or the pool is stopping
+    std::atomic<std::size_t> queuedTasks{0u};
+    std::atomic<std::size_t> pendingTasks{0u};
+    std::atomic<std::size_t> nextQueue{0u};
+    std::exception_ptr error; //!< first exception thrown by a task without group, guarded by stateMutex
+    bool stopping{};
+};
+
+} // namespace AOC::Y2022
+
+#endif // !defined(AOC_Y2022_WORK_STEALING_POOL_HPP)
@@ -1,17 +1,20 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
+#include "scheduler.hpp"
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <variant>
 
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(01)
-
 namespace
 {
 
@@ -20,7 +23,7 @@ class Day01Test : public ::testing::Test
   protected:
     void SetUp() override
     {
-        pPuzzle = std::make_unique<PuzzleDay01>(exampleInput);
+        pPuzzle = std::make_unique<Puzzle<1u>>(exampleInput);
     }
 
     // void TearDown() override {}
@@ -53,5 +56,84 @@ TEST_F(Day01Test, Part2)
     ASSERT_EQ(std::get<std::int64_t>(pPuzzle->Part2()), 45000);
 }
 
+TEST_F(Day01Test, TopElvesFromOptions)
+{
+    EXPECT_EQ(std::get<std::int64_t>(Puzzle<1u>(exampleInput, {.topElves = 1u}).Part2()), 24000);
+    EXPECT_EQ(std::get<std::int64_t>(Puzzle<1u>(exampleInput, {.topElves = 2u}).Part2()), 35000);
+    // fewer elves than asked for carry everything
+    EXPECT_EQ(std::get<std::int64_t>(Puzzle<1u>(exampleInput, {.topElves = 10u}).Part2()), 55000);
+    EXPECT_EQ(std::get<std::int64_t>(Puzzle<1u>(exampleInput, {.topElves = 0u}).Part1()), 24000);
+    EXPECT_EQ(std::get<std::int64_t>(Puzzle<1u>(exampleInput, {.topElves = 0u}).Part2()), 0);
+}
+
+TEST_F(Day01Test, TopElvesFromOptionsWhenStreamingAndEditing)
+{
+    StreamingPuzzle<1u> streamingPuzzle{{.topElves = 2u}};
+    ASSERT_TRUE(streamingPuzzle.Push(exampleInput));
+    EXPECT_EQ(std::get<std::int64_t>(streamingPuzzle.Finish().part2), 35000);
+
+    PuzzleSession<1u> session{exampleInput, {.topElves = 4u}};
+    EXPECT_EQ(std::get<std::int64_t>(session.Solve().part2), 51000);
+}
+
+TEST(Day01, SumsUpMoreThan32Bits)
+{
+    constexpr std::string_view input{"4000000000\n4000000000\n\n5000000000000\n\n1\n"};
+    Puzzle<1u> puzzle{input};
+    EXPECT_EQ(std::get<std::int64_t>(puzzle.Part1()), 5'000'000'000'000);
+    EXPECT_EQ(std::get<std::int64_t>(puzzle.Part2()), 5'008'000'000'001);
+}
+
+TEST(Day01, NoSolutionForTooManyCalories)
+{
+    const auto expect_no_solutions = [](const std::string_view input, const bool part1Solved) {
+        SCOPED_TRACE(input);
+        Puzzle<1u> puzzle{input};
+        EXPECT_EQ(std::holds_alternative<std::int64_t>(puzzle.Part1()), part1Solved);
+        EXPECT_TRUE(std::holds_alternative<std::monostate>(puzzle.Part2()));
+
+        StreamingPuzzle<1u> streamingPuzzle{};
+        ASSERT_TRUE(streamingPuzzle.Push(input));
+        const auto streamedSolutions = streamingPuzzle.Finish();
+        EXPECT_EQ(std::holds_alternative<std::int64_t>(streamedSolutions.part1), part1Solved);
+        EXPECT_TRUE(std::holds_alternative<std::monostate>(streamedSolutions.part2));
+
+        PuzzleSession<1u> session{input};
+        const auto sessionSolutions = session.Solve();
+        EXPECT_EQ(std::holds_alternative<std::int64_t>(sessionSolutions.part1), part1Solved);
+        EXPECT_TRUE(std::holds_alternative<std::monostate>(sessionSolutions.part2));
+    };
+    // an item beyond 64 bits
+    expect_no_solutions("1\n\n99999999999999999999\n", false);
+    // elves beyond the range of a solution
+    expect_no_solutions("1\n\n5000000000000000000\n5000000000000000000\n", false);
+    expect_no_solutions("1\n18446744073709551615\n1\n", false);
+    // only the top elves together are beyond it
+    expect_no_solutions("5000000000000000000\n\n5000000000000000000\n", true);
+}
+
+TEST(Day01, SumsUpChunksInParallel)
+{
+    // large enough to be split into chunks, with elves of up to 40 items crossing the chunk boundaries
+    std::string input;
+    for (std::uint32_t item = 0u; input.size() < (2u * 1024u * 1024u); ++item)
+    {
+        input += ((item % 41u) == 40u) ? std::string{} : std::to_string(1000u + ((item * 7919u) % 9000u));
+        input += ((item % 3u) == 0u) ? "\r\n" : "\n";
+    }
+    for (const std::size_t topElves : {1u, 3u, 7u})
+    {
+        Scheduler sequential{1u};
+        Puzzle<1u> expected{input, {.scheduler = &sequential, .topElves = topElves}};
+        for (const std::size_t threads : {2u, 3u, 8u})
+        {
+            Scheduler scheduler{threads};
+            Puzzle<1u> puzzle{input, {.scheduler = &scheduler, .topElves = topElves}};
+            EXPECT_EQ(expected.Part1(), puzzle.Part1()) << threads << " threads";
+            EXPECT_EQ(expected.Part2(), puzzle.Part2()) << threads << " threads";
+        }
+    }
+}
+
 } // namespace
 } // namespace AOC::Y2022
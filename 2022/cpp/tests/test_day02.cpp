@@ -1,26 +1,47 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 #include <string_view>
+#include <utility>
 
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(02)
-
 namespace
 {
 
+/*! \brief Builds a guide of count lines cycling through all turns, and its scores computed by the rules. */
+std::pair<std::string, std::pair<std::int64_t, std::int64_t>> make_guide(const std::size_t count,
+                                                                         const std::string_view lineBreak = "\n")
+{
+    std::string guide{};
+    std::int64_t score1 = 0;
+    std::int64_t score2 = 0;
+    for (std::size_t line = 0u; line < count; ++line)
+    {
+        const auto theirs = static_cast<std::int64_t>((line * 7u) % 3u);
+        const auto ours = static_cast<std::int64_t>((line / 3u) % 3u);
+        guide += static_cast<char>('A' + theirs);
+        guide += ' ';
+        guide += static_cast<char>('X' + ours);
+        guide += lineBreak;
+        score1 += (ours + 1) + (3 * ((ours - theirs + 4) % 3));
+        score2 += (3 * ours) + ((theirs + ours + 2) % 3) + 1;
+    }
+    return {guide, {score1, score2}};
+}
+
 class Day02Test : public ::testing::Test
 {
   protected:
     void SetUp() override
     {
-        pPuzzle = std::make_unique<PuzzleDay02>(exampleInput);
+        pPuzzle = std::make_unique<Puzzle<2u>>(exampleInput);
     }
 
     // void TearDown() override {}
@@ -42,5 +63,55 @@ TEST_F(Day02Test, Part2)
     ASSERT_EQ(std::get<std::int64_t>(pPuzzle->Part2()), 12);
 }
 
+TEST(Day02, ScoresLongGuides)
+{
+    // long enough for many blocks of the vectorized kernel, with a few lines left over behind them
+    for (const auto count : {2u, 15u, 16u, 33u, 1000u, 70001u})
+    {
+        const auto [guide, scores] = make_guide(count);
+        Puzzle<2u> puzzle{guide};
+        EXPECT_EQ(std::get<std::int64_t>(puzzle.Part1()), scores.first) << count;
+        EXPECT_EQ(std::get<std::int64_t>(puzzle.Part2()), scores.second) << count;
+    }
+}
+
+TEST(Day02, ScoresGuideOfASingleTurn)
+{
+    std::string guide{};
+    for (std::size_t line = 0u; line < 100'000u; ++line)
+    {
+        guide += "C Z\n";
+    }
+    Puzzle<2u> puzzle{guide};
+    EXPECT_EQ(std::get<std::int64_t>(puzzle.Part1()), 600'000);
+    EXPECT_EQ(std::get<std::int64_t>(puzzle.Part2()), 700'000);
+}
+
+TEST(Day02, ScoresGuidesWithOtherLineBreaks)
+{
+    const auto [guide, scores] = make_guide(100u, "\r\n");
+    Puzzle<2u> crlf{guide};
+    EXPECT_EQ(std::get<std::int64_t>(crlf.Part1()), scores.first);
+    EXPECT_EQ(std::get<std::int64_t>(crlf.Part2()), scores.second);
+
+    // an empty line ends the guide, a line without line break ends the input
+    const auto [head, headScores] = make_guide(50u);
+    auto mixed = head + "\n" + make_guide(50u).first;
+    Puzzle<2u> ended{mixed};
+    EXPECT_EQ(std::get<std::int64_t>(ended.Part1()), headScores.first);
+    mixed = head.substr(0u, head.size() - 1u);
+    Puzzle<2u> unterminated{mixed};
+    EXPECT_EQ(std::get<std::int64_t>(unterminated.Part2()), headScores.second);
+}
+
+TEST(Day02, InvalidLineDiscardsLongGuide)
+{
+    auto guide = make_guide(200u).first;
+    guide.replace(100u * 4u, 3u, "D X");
+    Puzzle<2u> puzzle{guide};
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(puzzle.Part1()));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(puzzle.Part2()));
+}
+
 } // namespace
 } // namespace AOC::Y2022
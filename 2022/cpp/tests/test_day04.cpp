@@ -1,17 +1,16 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
 #include <memory>
 #include <string_view>
+#include <variant>
 
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(04)
-
 namespace
 {
 
@@ -20,7 +19,7 @@ class Day04Test : public ::testing::Test
   protected:
     void SetUp() override
     {
-        pPuzzle = std::make_unique<PuzzleDay04>(exampleInput);
+        pPuzzle = std::make_unique<Puzzle<4u>>(exampleInput);
     }
 
     // void TearDown() override {}
@@ -45,5 +44,19 @@ TEST_F(Day04Test, Part2)
     ASSERT_EQ(std::get<std::int64_t>(pPuzzle->Part2()), 4);
 }
 
+TEST_F(Day04Test, NoPairs)
+{
+    // an input starting with an empty line lists no pairs, a shorter one is invalid
+    Puzzle<4u> puzzle{"\n2-4,6-8\n"};
+    ASSERT_EQ(std::get<std::int64_t>(puzzle.Part1()), 0);
+    ASSERT_EQ(std::get<std::int64_t>(puzzle.Part2()), 0);
+    StreamingPuzzle<4u> streamingPuzzle{};
+    ASSERT_TRUE(streamingPuzzle.Push("\n"));
+    ASSERT_TRUE(streamingPuzzle.Push("\n"));
+    ASSERT_EQ(streamingPuzzle.Finish().part1, IPuzzle::Solution_t{0});
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(Puzzle<4u>{"\n"}.Part1()));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(Puzzle<4u>{"1-2,3-4\nx\n\n"}.Part1()));
+}
+
 } // namespace
 } // namespace AOC::Y2022
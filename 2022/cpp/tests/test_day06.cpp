@@ -1,17 +1,16 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
 #include <string_view>
 
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(06)
-
 namespace
 {
 
@@ -21,19 +20,39 @@ class Day06Test : public ::testing::Test
 
 TEST_F(Day06Test, Part1)
 {
-    ASSERT_EQ( 5, std::get<std::int64_t>(PuzzleDay06{"bvwbjplbgvbhsrlpgdmjqwftvncz"}.Part1()));
-    ASSERT_EQ( 6, std::get<std::int64_t>(PuzzleDay06{"nppdvjthqldpwncqszvftbrmjlhg"}.Part1()));
-    ASSERT_EQ(10, std::get<std::int64_t>(PuzzleDay06{"nznrnfrfntjfmvfwmzdfjlvtqnbhcprsg"}.Part1()));
-    ASSERT_EQ(11, std::get<std::int64_t>(PuzzleDay06{"zcfzfwzzqfrljwzlrfnpqdbhtmscgvjw"}.Part1()));
+    ASSERT_EQ( 5, std::get<std::int64_t>(Puzzle<6u>{"bvwbjplbgvbhsrlpgdmjqwftvncz"}.Part1()));
+    ASSERT_EQ( 6, std::get<std::int64_t>(Puzzle<6u>{"nppdvjthqldpwncqszvftbrmjlhg"}.Part1()));
+    ASSERT_EQ(10, std::get<std::int64_t>(Puzzle<6u>{"nznrnfrfntjfmvfwmzdfjlvtqnbhcprsg"}.Part1()));
+    ASSERT_EQ(11, std::get<std::int64_t>(Puzzle<6u>{"zcfzfwzzqfrljwzlrfnpqdbhtmscgvjw"}.Part1()));
 }
 
 TEST_F(Day06Test, Part2)
 {
-    ASSERT_EQ(19, std::get<std::int64_t>(PuzzleDay06{"mjqjpqmgbljsphdztnvjfqwrcgsmlb"}.Part2()));
-    ASSERT_EQ(23, std::get<std::int64_t>(PuzzleDay06{"bvwbjplbgvbhsrlpgdmjqwftvncz"}.Part2()));
-    ASSERT_EQ(23, std::get<std::int64_t>(PuzzleDay06{"nppdvjthqldpwncqszvftbrmjlhg"}.Part2()));
-    ASSERT_EQ(29, std::get<std::int64_t>(PuzzleDay06{"nznrnfrfntjfmvfwmzdfjlvtqnbhcprsg"}.Part2()));
-    ASSERT_EQ(26, std::get<std::int64_t>(PuzzleDay06{"zcfzfwzzqfrljwzlrfnpqdbhtmscgvjw"}.Part2()));
+    ASSERT_EQ(19, std::get<std::int64_t>(Puzzle<6u>{"mjqjpqmgbljsphdztnvjfqwrcgsmlb"}.Part2()));
+    ASSERT_EQ(23, std::get<std::int64_t>(Puzzle<6u>{"bvwbjplbgvbhsrlpgdmjqwftvncz"}.Part2()));
+    ASSERT_EQ(23, std::get<std::int64_t>(Puzzle<6u>{"nppdvjthqldpwncqszvftbrmjlhg"}.Part2()));
+    ASSERT_EQ(29, std::get<std::int64_t>(Puzzle<6u>{"nznrnfrfntjfmvfwmzdfjlvtqnbhcprsg"}.Part2()));
+    ASSERT_EQ(26, std::get<std::int64_t>(Puzzle<6u>{"zcfzfwzzqfrljwzlrfnpqdbhtmscgvjw"}.Part2()));
+}
+
+TEST_F(Day06Test, BorrowedInput)
+{
+    const std::string input{"mjqjpqmgbljsphdztnvjfqwrcgsmlb\n"};
+    Puzzle<6u> puzzle{input, PuzzleOptions{.inputLifetime = InputLifetime::borrowed}};
+    ASSERT_EQ( 7, std::get<std::int64_t>(puzzle.Part1()));
+    ASSERT_EQ(19, std::get<std::int64_t>(puzzle.Part2()));
+}
+
+TEST_F(Day06Test, InvalidInput)
+{
+    // only the characters up to the marker are checked
+    Puzzle<6u> puzzle{"mjqjpqmgbljsphdztnvjfqwrcgsmlB"};
+    ASSERT_EQ( 7, std::get<std::int64_t>(puzzle.Part1()));
+    ASSERT_EQ(19, std::get<std::int64_t>(puzzle.Part2()));
+    Puzzle<6u> invalidPrefix{"mjqjpqmgbljsphdzBtnvjfqwrcgsmlb"};
+    ASSERT_EQ( 7, std::get<std::int64_t>(invalidPrefix.Part1()));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(invalidPrefix.Part2()));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(Puzzle<6u>{"mjqBjpqmgbljsphdztnvjfqwrcgsmlb"}.Part1()));
 }
 
 } // namespace
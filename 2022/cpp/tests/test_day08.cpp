@@ -1,6 +1,6 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
@@ -10,8 +10,6 @@
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(08)
-
 namespace
 {
 
@@ -20,7 +18,7 @@ class Day08Test : public ::testing::Test
   protected:
     void SetUp() override
     {
-        pPuzzle = std::make_unique<PuzzleDay08>(exampleInput);
+        pPuzzle = std::make_unique<Puzzle<8u>>(exampleInput);
     }
 
     // void TearDown() override {}
@@ -1,6 +1,6 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
@@ -10,8 +10,6 @@
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(09)
-
 namespace
 {
 
@@ -20,8 +18,8 @@ class Day09Test : public ::testing::Test
   protected:
     void SetUp() override
     {
-        pPuzzle1 = std::make_unique<PuzzleDay09>(exampleInput1);
-        pPuzzle2 = std::make_unique<PuzzleDay09>(exampleInput2);
+        pPuzzle1 = std::make_unique<Puzzle<9u>>(exampleInput1);
+        pPuzzle2 = std::make_unique<Puzzle<9u>>(exampleInput2);
     }
 
     // void TearDown() override {}
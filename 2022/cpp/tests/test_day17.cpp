@@ -1,6 +1,6 @@
 
 #include "ipuzzle.hpp"
-#include "puzzle_common.hpp"
+#include "puzzle_registry.hpp"
 
 #include <gtest/gtest.h>
 
@@ -10,8 +10,6 @@
 namespace AOC::Y2022
 {
 
-AOC_Y2022_PUZZLE_CLASS_DECLARATION(17)
-
 namespace
 {
 
@@ -20,7 +18,7 @@ class Day17Test : public ::testing::Test
   protected:
     void SetUp() override
     {
-        pPuzzle1 = std::make_unique<PuzzleDay17>(exampleInput1);
+        pPuzzle1 = std::make_unique<Puzzle<17u>>(exampleInput1);
     }
 
     // void TearDown() override {}
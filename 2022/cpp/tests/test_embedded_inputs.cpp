@@ -0,0 +1,99 @@
+#include "aoc_y2022.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+struct ExampleAnswers final
+{
+    std::uint8_t day{};
+    IPuzzle::Solution_t part1{};
+    IPuzzle::Solution_t part2{};
+};
+
+const std::array exampleAnswers{
+    ExampleAnswers{1u, 24000, 45000},
+    ExampleAnswers{2u, 15, 12},
+    ExampleAnswers{3u, 157, 70},
+    ExampleAnswers{4u, 2, 4},
+    ExampleAnswers{5u, "CMZ", "MCD"},
+    ExampleAnswers{6u, 7, 19},
+    ExampleAnswers{7u, 95437, 24933642},
+    ExampleAnswers{8u, 21, 8},
+    ExampleAnswers{10u, 13140,
+                   "##..##..##..##..##..##..##..##..##..##..\n###...###...###...###...###...###...###.\n"
+                   "####....####....####....####....####....\n#####.....#####.....#####.....#####.....\n"
+                   "######......######......######......####\n#######.......#######.......#######.....\n"},
+};
+
+void PrintTo(const ExampleAnswers &answers, std::ostream *os)
+{
+    *os << "example of day " << unsigned(answers.day);
+}
+
+std::string read_example(const std::uint8_t day)
+{
+    const auto name = std::string{AOC_Y2022_EXAMPLE_INPUT_DIR "/day"} + ((day < 10u) ? "0" : "") +
+                      std::to_string(day) + ".txt";
+    std::ifstream file{name, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+class EmbeddedInputTest : public ::testing::TestWithParam<ExampleAnswers>
+{
+};
+
+TEST_P(EmbeddedInputTest, AnswersArePrecomputed)
+{
+    const auto &expected = GetParam();
+    const auto input = read_example(expected.day);
+    ASSERT_FALSE(input.empty());
+    const auto checked = visit_day(expected.day, SupportedDays{}, [&input, &expected](const auto day) {
+        Puzzle<day> puzzle{input};
+        EXPECT_TRUE(puzzle.IsPrecomputed());
+        EXPECT_EQ(expected.part1, puzzle.Part1());
+        EXPECT_EQ(expected.part2, puzzle.Part2());
+
+        // any other input is still parsed
+        Puzzle<day> other{input + '\n'};
+        EXPECT_FALSE(other.IsPrecomputed());
+    });
+    EXPECT_TRUE(checked);
+}
+
+std::vector<ExampleAnswers> embedded_examples()
+{
+    // the days whose example input was found and embedded by CMake
+    const std::vector<int> embeddedDays{AOC_Y2022_EMBEDDED_DAY_LIST};
+    std::vector<ExampleAnswers> examples{};
+    for (const auto &answers : exampleAnswers)
+    {
+        if (std::ranges::find(embeddedDays, int{answers.day}) != embeddedDays.end())
+        {
+            examples.push_back(answers);
+        }
+    }
+    return examples;
+}
+
+INSTANTIATE_TEST_SUITE_P(EmbeddedInput, EmbeddedInputTest, ::testing::ValuesIn(embedded_examples()),
+                         [](const ::testing::TestParamInfo<ExampleAnswers> &info) {
+                             return "Day" + std::to_string(info.param.day);
+                         });
+
+} // namespace
+} // namespace AOC::Y2022
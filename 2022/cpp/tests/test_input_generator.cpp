@@ -0,0 +1,144 @@
+
+#include "aoc_y2022.hpp"
+#include "input_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <variant>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+struct GeneratedInputCase
+{
+    std::uint8_t day;
+    std::uint64_t size;
+};
+
+class InputGeneratorTest : public ::testing::TestWithParam<GeneratedInputCase>
+{
+};
+
+TEST_P(InputGeneratorTest, IsSolvable)
+{
+    const auto [day, size] = GetParam();
+    ASSERT_TRUE(InputGenerator::has_generator_for_day(day));
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 1u});
+    ASSERT_FALSE(input.empty());
+    auto pPuzzle = PuzzleFactory::CreatePuzzle(day, input);
+    ASSERT_NE(pPuzzle, nullptr);
+    EXPECT_FALSE(std::holds_alternative<std::monostate>(pPuzzle->Part1()));
+    EXPECT_FALSE(std::holds_alternative<std::monostate>(pPuzzle->Part2()));
+}
+
+TEST_P(InputGeneratorTest, IsDeterministic)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 7u});
+    EXPECT_EQ(input, InputGenerator::Generate(day, {.size = size, .seed = 7u}));
+    EXPECT_NE(input, InputGenerator::Generate(day, {.size = size, .seed = 8u}));
+}
+
+// day 10 is limited to 240 cycles, otherwise the display of part 2 overflows
+INSTANTIATE_TEST_SUITE_P(AllDays, InputGeneratorTest,
+                         ::testing::Values(GeneratedInputCase{1u, 500u}, GeneratedInputCase{2u, 500u},
+                                           GeneratedInputCase{3u, 300u}, GeneratedInputCase{4u, 500u},
+                                           GeneratedInputCase{5u, 200u}, GeneratedInputCase{6u, 2000u},
+                                           GeneratedInputCase{7u, 500u}, GeneratedInputCase{8u, 40u},
+                                           GeneratedInputCase{9u, 300u}, GeneratedInputCase{10u, 100u},
+                                           GeneratedInputCase{11u, 40u}, GeneratedInputCase{12u, 40u},
+                                           GeneratedInputCase{17u, 500u}),
+                         [](const auto &info) { return "day" + std::to_string(info.param.day); });
+
+class ParseModeTest : public ::testing::TestWithParam<GeneratedInputCase>
+{
+};
+
+TEST_P(ParseModeTest, TrustedParsingMatchesValidation)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 9u});
+    auto pValidated = PuzzleFactory::CreatePuzzle(day, input, {.parseMode = ParseMode::validate});
+    auto pTrusted = PuzzleFactory::CreatePuzzle(day, input, {.parseMode = ParseMode::trusted});
+    ASSERT_NE(pValidated, nullptr);
+    ASSERT_NE(pTrusted, nullptr);
+    const auto part1 = pValidated->Part1();
+    EXPECT_FALSE(std::holds_alternative<std::monostate>(part1));
+    EXPECT_EQ(part1, pTrusted->Part1());
+    EXPECT_EQ(pValidated->Part2(), pTrusted->Part2());
+}
+
+INSTANTIATE_TEST_SUITE_P(RegexValidatedDays, ParseModeTest,
+                         ::testing::Values(GeneratedInputCase{2u, 500u}, GeneratedInputCase{3u, 300u},
+                                           GeneratedInputCase{4u, 500u}, GeneratedInputCase{5u, 200u},
+                                           GeneratedInputCase{7u, 500u}, GeneratedInputCase{9u, 300u},
+                                           GeneratedInputCase{10u, 100u}, GeneratedInputCase{11u, 40u}),
+                         [](const auto &info) { return "day" + std::to_string(info.param.day); });
+
+class ParallelParsingTest : public ::testing::TestWithParam<GeneratedInputCase>
+{
+  protected:
+    /*! \brief Parsing on several threads has to give the same solutions as parsing on one thread. */
+    static void expect_same_solutions(const std::uint8_t day, const std::string &input)
+    {
+        ASSERT_GE(input.size(), 1024u * 1024u) << "the input is too small to be parsed in parallel";
+        Scheduler sequential{1u};
+        Scheduler parallel{4u};
+        auto pSequential = PuzzleFactory::CreatePuzzle(day, input, {.scheduler = &sequential});
+        auto pParallel = PuzzleFactory::CreatePuzzle(day, input, {.scheduler = &parallel});
+        ASSERT_NE(pSequential, nullptr);
+        ASSERT_NE(pParallel, nullptr);
+        EXPECT_EQ(pSequential->Part1(), pParallel->Part1());
+        EXPECT_EQ(pSequential->Part2(), pParallel->Part2());
+    }
+
+    /*! \brief Inserts text in front of the line closest to the given fraction of the input. */
+    static std::string insert_at_line(std::string input, const std::size_t fractionPercent, const std::string &text)
+    {
+        const auto lineStart = input.find('\n', (input.size() * fractionPercent) / 100u) + 1u;
+        input.insert(lineStart, text);
+        return input;
+    }
+};
+
+TEST_P(ParallelParsingTest, MatchesSequentialParsing)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 11u});
+    expect_same_solutions(day, input);
+}
+
+TEST_P(ParallelParsingTest, EmptyLineEndsInput)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 12u});
+    expect_same_solutions(day, insert_at_line(input, 60u, "\ninvalid line\n"));
+}
+
+TEST_P(ParallelParsingTest, InvalidLineDiscardsInput)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 13u});
+    expect_same_solutions(day, insert_at_line(input, 30u, "invalid line\n\n"));
+}
+
+INSTANTIATE_TEST_SUITE_P(IndependentLineDays, ParallelParsingTest,
+                         // day 9 is left out, simulating a rope over more than 1 MiB of motions takes too long
+                         ::testing::Values(GeneratedInputCase{1u, 220'000u}, GeneratedInputCase{2u, 300'000u}, GeneratedInputCase{3u, 60'000u},
+                                           GeneratedInputCase{4u, 120'000u}, GeneratedInputCase{10u, 200'000u}),
+                         [](const auto &info) { return "day" + std::to_string(info.param.day); });
+
+TEST(InputGenerator, UnknownDay)
+{
+    EXPECT_FALSE(InputGenerator::has_generator_for_day(13u));
+    EXPECT_TRUE(InputGenerator::Generate(13u, {}).empty());
+}
+
+} // namespace
+} // namespace AOC::Y2022
@@ -0,0 +1,109 @@
+#include "aoc_y2022.hpp"
+#include "line_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+constexpr const char *exampleInputDay01 =
+R"ExampleInput(1000
+2000
+3000
+
+4000
+
+5000
+6000
+
+7000
+8000
+9000
+
+10000
+)ExampleInput";
+
+TEST(Instrumentation, ReportsSolutionsAndAllocations)
+{
+    const auto report = PuzzleFactory::SolveInstrumented(1u, exampleInputDay01);
+    ASSERT_TRUE(report.created);
+    ASSERT_TRUE(report.allocationsTracked);
+    EXPECT_EQ(24000, std::get<std::int64_t>(report.part1));
+    EXPECT_EQ(45000, std::get<std::int64_t>(report.part2));
+    const auto &parse = report[SolveReport::Phase::parse];
+    EXPECT_GT(parse.allocations, 0u);
+    EXPECT_GE(parse.bytesAllocated, parse.peakBytes);
+    EXPECT_GT(parse.peakBytes, 0u);
+}
+
+TEST(Instrumentation, CountsAllocationsOfTheCallingThread)
+{
+    const auto before = AllocationTracker::snapshot();
+    auto pValues = std::make_unique<std::vector<std::uint64_t>>(1000u);
+    const auto after = AllocationTracker::snapshot();
+    EXPECT_EQ(2u, after.allocations - before.allocations);
+    EXPECT_EQ(sizeof(std::vector<std::uint64_t>) + (1000u * sizeof(std::uint64_t)),
+              after.bytesAllocated - before.bytesAllocated);
+    pValues.reset();
+    EXPECT_EQ(before.currentBytes, AllocationTracker::snapshot().currentBytes);
+}
+
+TEST(Instrumentation, CountsOverAlignedAllocations)
+{
+    struct alignas(128) CacheLines final
+    {
+        std::uint8_t bytes[256];
+    };
+    const auto before = AllocationTracker::snapshot();
+    auto pLines = std::make_unique<CacheLines>();
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(pLines.get()) % alignof(CacheLines));
+    auto *const pResource = std::pmr::new_delete_resource();
+    void *const pBytes = pResource->allocate(100u, 256u);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(pBytes) % 256u);
+    const auto after = AllocationTracker::snapshot();
+    EXPECT_EQ(2u, after.allocations - before.allocations);
+    EXPECT_EQ(sizeof(CacheLines) + 100u, after.bytesAllocated - before.bytesAllocated);
+    pResource->deallocate(pBytes, 100u, 256u);
+    pLines.reset();
+    EXPECT_EQ(before.currentBytes, AllocationTracker::snapshot().currentBytes);
+}
+
+TEST(Instrumentation, CountsAllocationsOfParsingLargeInputs)
+{
+    // large enough to be parsed in parallel, which would allocate on the threads of the scheduler
+    std::string input{};
+    while (input.size() < parallelParsingThreshold)
+    {
+        input += "vJrwpWtwJgWrhcsFMMfFFhFp\njqHRNqRjqzjGDLGLrsFMfFZSrLrFZsSL\nPmmdzqPrVvPwwTWBwg\n";
+    }
+    const auto report = PuzzleFactory::SolveInstrumented(3u, input);
+    Scheduler sequential{1u};
+    const auto sequentialReport = PuzzleFactory::SolveInstrumented(3u, input, PuzzleOptions{.scheduler = &sequential});
+    ASSERT_TRUE(report.created);
+    const auto &parse = report[SolveReport::Phase::parse];
+    const auto &sequentialParse = sequentialReport[SolveReport::Phase::parse];
+    EXPECT_EQ(sequentialParse.allocations, parse.allocations);
+    EXPECT_EQ(sequentialParse.bytesAllocated, parse.bytesAllocated);
+    EXPECT_EQ(sequentialParse.peakBytes, parse.peakBytes);
+    EXPECT_GT(parse.peakBytes, 0u);
+}
+
+TEST(Instrumentation, UnknownDay)
+{
+    const auto report = PuzzleFactory::SolveInstrumented(25u, exampleInputDay01);
+    EXPECT_FALSE(report.created);
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(report.part1));
+}
+
+} // namespace
+} // namespace AOC::Y2022
@@ -0,0 +1,197 @@
+#include "aoc_y2022.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+class PuzzleFactoryTest : public ::testing::Test
+{
+  protected:
+    static constexpr const char *exampleInputDay09 =
+R"ExampleInput(R 5
+U 8
+L 8
+D 3
+R 17
+D 10
+L 25
+U 20
+)ExampleInput";
+    static constexpr const char *exampleInputDay17 = ">>><<><>><<<>><>>><<<>>><<<><<<>><>><<>>\n";
+};
+
+/*! \brief Only counts how its parts were called, both parts must run even if it is not marked independent. */
+class SequentialPuzzle final : public IPuzzle
+{
+  public:
+    [[nodiscard]] Solution_t Part1() override
+    {
+        return ++calls;
+    }
+    [[nodiscard]] Solution_t Part2() override
+    {
+        return ++calls * 10;
+    }
+
+    std::int64_t calls{};
+};
+
+/*! \brief Thread-safe resource which counts the allocations it passes on to the global heap. */
+class CountingResource final : public std::pmr::memory_resource
+{
+  public:
+    std::atomic<std::size_t> allocations{};
+    std::atomic<std::size_t> outstandingBytes{};
+
+  private:
+    void *do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        ++allocations;
+        outstandingBytes += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void *const p, const std::size_t bytes, const std::size_t alignment) override
+    {
+        outstandingBytes -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+TEST_F(PuzzleFactoryTest, SolveConcurrently)
+{
+    auto pPuzzle = PuzzleFactory::CreatePuzzle(9u, exampleInputDay09);
+    ASSERT_NE(pPuzzle, nullptr);
+    ASSERT_TRUE(pPuzzle->PartsAreIndependent());
+    const auto solutions = PuzzleFactory::SolveConcurrently(*pPuzzle);
+    EXPECT_EQ(88, std::get<std::int64_t>(solutions.part1));
+    EXPECT_EQ(36, std::get<std::int64_t>(solutions.part2));
+
+    pPuzzle = PuzzleFactory::CreatePuzzle(17u, exampleInputDay17);
+    ASSERT_NE(pPuzzle, nullptr);
+    const auto solutions17 = PuzzleFactory::SolveConcurrently(*pPuzzle);
+    EXPECT_EQ(3068, std::get<std::int64_t>(solutions17.part1));
+    EXPECT_EQ(1514285714288, std::get<std::int64_t>(solutions17.part2));
+}
+
+TEST_F(PuzzleFactoryTest, SolveWithoutFactory)
+{
+    const auto solutions = solve<17u>(exampleInputDay17);
+    EXPECT_EQ(3068, std::get<std::int64_t>(solutions.part1));
+    EXPECT_EQ(1514285714288, std::get<std::int64_t>(solutions.part2));
+
+    // everything except the parsed input is allocated by the factory path only
+    CountingResource resource;
+    const auto solutions9 = Puzzle<9u>::Solve(exampleInputDay09, {.memoryResource = &resource});
+    EXPECT_EQ(88, std::get<std::int64_t>(solutions9.part1));
+    EXPECT_EQ(36, std::get<std::int64_t>(solutions9.part2));
+    EXPECT_EQ(resource.outstandingBytes.load(), 0u);
+}
+
+TEST_F(PuzzleFactoryTest, RegistryMatchesFactory)
+{
+    static_assert(contains_day(SupportedDays{}, 17u) && !contains_day(SupportedDays{}, 13u));
+    static_assert(SupportedDay<1u> && !SupportedDay<0u> && StreamingDay<10u> && !StreamingDay<5u>);
+    std::size_t visitedDays{};
+    for (std::uint8_t day = 0u; day <= 26u; ++day)
+    {
+        std::uint8_t visitedDay{};
+        const bool visited =
+            visit_day(day, SupportedDays{}, [&visitedDay](const auto compileTimeDay) { visitedDay = compileTimeDay; });
+        EXPECT_EQ(PuzzleFactory::has_implementation_for_day(day), visited);
+        EXPECT_EQ(visited ? day : 0u, visitedDay);
+        EXPECT_EQ(contains_day(StreamingDays{}, day), PuzzleFactory::has_streaming_implementation_for_day(day));
+        EXPECT_EQ(contains_day(StreamingDays{}, day), PuzzleFactory::CreateStreamingPuzzle(day) != nullptr);
+        visitedDays += visited ? 1u : 0u;
+    }
+    EXPECT_EQ(SupportedDays::size(), visitedDays);
+}
+
+TEST_F(PuzzleFactoryTest, SolveSequentiallyIfPartsDependOnEachOther)
+{
+    SequentialPuzzle puzzle;
+    ASSERT_FALSE(puzzle.PartsAreIndependent());
+    const auto solutions = PuzzleFactory::SolveConcurrently(puzzle);
+    EXPECT_EQ(1, std::get<std::int64_t>(solutions.part1));
+    EXPECT_EQ(20, std::get<std::int64_t>(solutions.part2));
+}
+
+TEST_F(PuzzleFactoryTest, SolveBatchKeepsJobOrder)
+{
+    std::vector<BatchJob> jobs;
+    for (std::size_t idx = 0u; idx < 64u; ++idx)
+    {
+        jobs.push_back((idx % 3u) == 0u ? BatchJob{9u, exampleInputDay09} : BatchJob{17u, exampleInputDay17});
+    }
+    jobs.push_back(BatchJob{25u, exampleInputDay09});
+    for (const std::size_t threadCount : {1u, 3u, 0u})
+    {
+        const auto results = PuzzleFactory::SolveBatch(jobs, {}, threadCount);
+        ASSERT_EQ(jobs.size(), results.size());
+        for (std::size_t idx = 0u; idx < jobs.size(); ++idx)
+        {
+            if (jobs[idx].day == 25u)
+            {
+                EXPECT_FALSE(results[idx].created);
+                continue;
+            }
+            ASSERT_TRUE(results[idx].created);
+            const auto expectedPart2 = (jobs[idx].day == 9u) ? 36 : 1514285714288;
+            EXPECT_EQ(expectedPart2, std::get<std::int64_t>(results[idx].solutions.part2));
+        }
+    }
+    EXPECT_TRUE(PuzzleFactory::SolveBatch({}).empty());
+}
+
+TEST_F(PuzzleFactoryTest, PuzzleAllocatesFromMemoryResource)
+{
+    for (const auto &[day, input] : {std::pair{9u, exampleInputDay09}, std::pair{17u, exampleInputDay17}})
+    {
+        CountingResource resource;
+        auto pPuzzle = PuzzleFactory::CreatePuzzle(static_cast<std::uint8_t>(day), input);
+        auto pPuzzleWithResource =
+            PuzzleFactory::CreatePuzzle(static_cast<std::uint8_t>(day), input, {.memoryResource = &resource});
+        ASSERT_NE(pPuzzle, nullptr);
+        ASSERT_NE(pPuzzleWithResource, nullptr);
+        EXPECT_NE(resource.allocations.load(), 0u);
+        EXPECT_EQ(pPuzzle->Part1(), pPuzzleWithResource->Part1());
+        EXPECT_EQ(pPuzzle->Part2(), pPuzzleWithResource->Part2());
+        pPuzzleWithResource.reset();
+        EXPECT_EQ(resource.outstandingBytes.load(), 0u);
+    }
+}
+
+TEST_F(PuzzleFactoryTest, SolveBatchTakesArenasFromMemoryResource)
+{
+    CountingResource resource;
+    const std::vector<BatchJob> jobs(16u, BatchJob{9u, exampleInputDay09});
+    const auto results = PuzzleFactory::SolveBatch(jobs, {.memoryResource = &resource}, 4u);
+    ASSERT_EQ(jobs.size(), results.size());
+    for (const auto &result : results)
+    {
+        ASSERT_TRUE(result.created);
+        EXPECT_EQ(36, std::get<std::int64_t>(result.solutions.part2));
+    }
+    // at least one arena per job
+    EXPECT_GE(resource.allocations.load(), jobs.size());
+    EXPECT_EQ(resource.outstandingBytes.load(), 0u);
+}
+
+} // namespace
+} // namespace AOC::Y2022
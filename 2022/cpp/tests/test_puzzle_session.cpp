@@ -0,0 +1,179 @@
+#include "aoc_y2022.hpp"
+#include "input_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+struct SessionCase
+{
+    std::uint8_t day;
+    std::uint64_t size;
+};
+
+class PuzzleSessionTest : public ::testing::TestWithParam<SessionCase>
+{
+  protected:
+    /*! \brief Checks that the session solves its current input like a puzzle created from it. */
+    static void expect_same_solutions(IPuzzleSession &session, const std::uint8_t day)
+    {
+        auto pPuzzle = PuzzleFactory::CreatePuzzle(day, session.Input());
+        ASSERT_NE(pPuzzle, nullptr);
+        const auto solutions = session.Solve();
+        EXPECT_EQ(pPuzzle->Part1(), solutions.part1);
+        EXPECT_EQ(pPuzzle->Part2(), solutions.part2);
+    }
+
+    /*!
+     * \brief Applies random edits, mostly pieces of the original input, so that lines are split, joined, moved,
+     *        broken and repaired again.
+     */
+    static void edit_randomly(const std::uint8_t day, const std::string &input, const std::uint32_t seed)
+    {
+        auto pSession = PuzzleFactory::CreateSession(day, input);
+        ASSERT_NE(pSession, nullptr);
+        expect_same_solutions(*pSession, day);
+
+        std::mt19937 random{seed};
+        std::string expectedInput = input;
+        constexpr std::size_t maxEditLength = 12u;
+        for (auto edit = 0; edit != 200; ++edit)
+        {
+            const auto offset = std::uniform_int_distribution<std::size_t>{0u, expectedInput.size()}(random);
+            const auto length = std::uniform_int_distribution<std::size_t>{
+                0u, std::min(maxEditLength, expectedInput.size() - offset)}(random);
+            std::string replacement;
+            switch (std::uniform_int_distribution<int>{0, 4}(random))
+            {
+            case 0:
+                break;
+            case 1:
+                replacement = "\n";
+                break;
+            case 2:
+                replacement = "x";
+                break;
+            default:
+            {
+                const auto source = std::uniform_int_distribution<std::size_t>{0u, input.size()}(random);
+                replacement = input.substr(source, std::uniform_int_distribution<std::size_t>{0u, maxEditLength}(random));
+                break;
+            }
+            }
+            SCOPED_TRACE(testing::Message() << "edit " << edit << ": " << length << " bytes at " << offset);
+            ASSERT_TRUE(pSession->Edit(offset, length, replacement));
+            expectedInput.replace(offset, length, replacement);
+            ASSERT_EQ(expectedInput, pSession->Input());
+            expect_same_solutions(*pSession, day);
+        }
+    }
+};
+
+TEST_P(PuzzleSessionTest, MatchesPuzzleAfterEveryEdit)
+{
+    const auto [day, size] = GetParam();
+    ASSERT_TRUE(PuzzleFactory::has_incremental_implementation_for_day(day));
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 7u});
+    ASSERT_FALSE(input.empty());
+    edit_randomly(day, input, 1u);
+}
+
+TEST_P(PuzzleSessionTest, MatchesPuzzleWithCarriageReturns)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 8u});
+    std::string crlfInput;
+    for (const auto c : input)
+    {
+        if (c == '\n')
+        {
+            crlfInput += '\r';
+        }
+        crlfInput += c;
+    }
+    edit_randomly(day, crlfInput, 2u);
+}
+
+TEST_P(PuzzleSessionTest, TypedLineByLine)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 9u});
+    auto pSession = PuzzleFactory::CreateSession(day, "");
+    ASSERT_NE(pSession, nullptr);
+    for (std::size_t offset = 0u; offset < input.size();)
+    {
+        const auto lineEnd = std::min(input.find('\n', offset), input.size() - 1u) + 1u;
+        ASSERT_TRUE(pSession->Edit(offset, 0u, std::string_view{input}.substr(offset, lineEnd - offset)));
+        offset = lineEnd;
+    }
+    EXPECT_EQ(input, pSession->Input());
+    expect_same_solutions(*pSession, day);
+}
+
+INSTANTIATE_TEST_SUITE_P(IncrementalDays, PuzzleSessionTest,
+                         ::testing::Values(SessionCase{1u, 300u}, SessionCase{2u, 300u}, SessionCase{3u, 300u},
+                                           SessionCase{4u, 300u}, SessionCase{10u, 100u},
+                                           SessionCase{10u, 1000u}));
+
+TEST(PuzzleSession, EditOutsideOfInput)
+{
+    auto pSession = PuzzleFactory::CreateSession(2u, "A Y\nB X\nC Z\n");
+    ASSERT_NE(pSession, nullptr);
+    EXPECT_FALSE(pSession->Edit(13u, 0u, "A X\n"));
+    EXPECT_FALSE(pSession->Edit(10u, 3u, ""));
+    EXPECT_EQ(pSession->Input(), "A Y\nB X\nC Z\n");
+    EXPECT_EQ(pSession->Solve().part1, IPuzzle::Solution_t{15});
+    EXPECT_TRUE(pSession->Edit(12u, 0u, "A X\n"));
+    EXPECT_EQ(pSession->Solve().part1, IPuzzle::Solution_t{19});
+}
+
+TEST(PuzzleSession, EmptyInput)
+{
+    auto pSession = PuzzleFactory::CreateSession(10u, "");
+    ASSERT_NE(pSession, nullptr);
+    const auto solutions = pSession->Solve();
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(solutions.part1));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(solutions.part2));
+}
+
+TEST(PuzzleSession, RecomputesDaysWithoutIncrementalImplementation)
+{
+    EXPECT_FALSE(PuzzleFactory::has_incremental_implementation_for_day(5u));
+    const auto input = InputGenerator::Generate(5u, {.size = 50u, .seed = 10u});
+    auto pSession = PuzzleFactory::CreateSession(5u, input);
+    ASSERT_NE(pSession, nullptr);
+    const auto expect_same_solutions = [&pSession]() {
+        auto pPuzzle = PuzzleFactory::CreatePuzzle(5u, pSession->Input());
+        ASSERT_NE(pPuzzle, nullptr);
+        const auto solutions = pSession->Solve();
+        EXPECT_EQ(pPuzzle->Part1(), solutions.part1);
+        EXPECT_EQ(pPuzzle->Part2(), solutions.part2);
+    };
+    expect_same_solutions();
+    ASSERT_TRUE(pSession->Edit(input.size() - 2u, 1u, "9"));
+    expect_same_solutions();
+    ASSERT_TRUE(pSession->Edit(0u, 0u, "invalid line\n"));
+    expect_same_solutions();
+}
+
+TEST(PuzzleSession, UnsupportedDay)
+{
+    EXPECT_EQ(PuzzleFactory::CreateSession(0u, "input"), nullptr);
+    EXPECT_EQ(PuzzleFactory::CreateSession(13u, "input"), nullptr);
+}
+
+} // namespace
+
+} // namespace AOC::Y2022
@@ -0,0 +1,216 @@
+#include "aoc_y2022.hpp"
+#include "utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+constexpr std::string_view day01Input{"1000\n2000\n3000\n\n4000\n\n5000\n6000\n\n7000\n8000\n9000\n\n10000\n"};
+
+class ResultCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        const auto *const pTestInfo = ::testing::UnitTest::GetInstance()->current_test_info();
+        directory = std::filesystem::temp_directory_path() / (std::string{"aoc-2022-test-cache-"} + pTestInfo->name());
+        std::filesystem::remove_all(directory);
+    }
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    [[nodiscard]] std::size_t entry_count() const
+    {
+        std::size_t count{};
+        for (const auto &entry : std::filesystem::directory_iterator{directory})
+        {
+            count += (entry.path().extension() == ".result") ? 1u : 0u;
+        }
+        return count;
+    }
+
+    std::filesystem::path directory;
+};
+
+TEST_F(ResultCacheTest, HashInput)
+{
+    EXPECT_EQ(ResultCache::hash_input(day01Input), ResultCache::hash_input(std::string{day01Input}));
+    EXPECT_NE(ResultCache::hash_input(""), ResultCache::hash_input(std::string_view{"\0", 1u}));
+    EXPECT_NE(ResultCache::hash_input("1000\n2000\n"), ResultCache::hash_input("1000\n2001\n"));
+    EXPECT_NE(ResultCache::hash_input("123456789"), ResultCache::hash_input("123456788"));
+    EXPECT_FALSE(ResultCache::build_id().empty());
+}
+
+TEST_F(ResultCacheTest, MissThenHit)
+{
+    ResultCache cache{directory};
+    EXPECT_FALSE(cache.Lookup(1u, day01Input).has_value());
+    {
+        const auto pPuzzle = cache.CreatePuzzle(1u, day01Input);
+        ASSERT_NE(nullptr, pPuzzle);
+        const auto solutions = PuzzleFactory::SolveConcurrently(*pPuzzle);
+        EXPECT_EQ(IPuzzle::Solution_t{24000}, solutions.part1);
+        EXPECT_EQ(IPuzzle::Solution_t{45000}, solutions.part2);
+    }
+    EXPECT_EQ(0u, cache.hits());
+    EXPECT_EQ(2u, cache.misses());
+    EXPECT_EQ(1u, entry_count());
+
+    // a second cache on the same directory stands in for the next process
+    ResultCache nextCache{directory};
+    const auto pPuzzle = nextCache.CreatePuzzle(1u, day01Input);
+    ASSERT_NE(nullptr, pPuzzle);
+    EXPECT_EQ(IPuzzle::Solution_t{24000}, pPuzzle->Part1());
+    EXPECT_EQ(IPuzzle::Solution_t{45000}, pPuzzle->Part2());
+    EXPECT_EQ(1u, nextCache.hits());
+    EXPECT_EQ(0u, nextCache.misses());
+    EXPECT_EQ(nullptr, nextCache.CreatePuzzle(25u, day01Input));
+}
+
+TEST_F(ResultCacheTest, HitDoesNotParseInput)
+{
+    ResultCache cache{directory};
+    // not a valid day 11 input at all, so the solutions can only come from the cache
+    constexpr std::string_view input{"no monkeys in here"};
+    cache.Store(11u, input, IPuzzle::Solutions{.part1 = 1, .part2 = 2});
+    const auto pPuzzle = cache.CreatePuzzle(11u, input);
+    ASSERT_NE(nullptr, pPuzzle);
+    EXPECT_EQ(IPuzzle::Solution_t{1}, pPuzzle->Part1());
+    EXPECT_EQ(IPuzzle::Solution_t{2}, pPuzzle->Part2());
+    EXPECT_EQ(1u, cache.hits());
+}
+
+TEST_F(ResultCacheTest, TrustedParsingStoresNothing)
+{
+    ResultCache cache{directory};
+    const PuzzleOptions trusted{.parseMode = ParseMode::trusted};
+    {
+        const auto pPuzzle = cache.CreatePuzzle(1u, day01Input, trusted);
+        ASSERT_NE(nullptr, pPuzzle);
+        EXPECT_EQ(IPuzzle::Solution_t{24000}, PuzzleFactory::SolveConcurrently(*pPuzzle).part1);
+    }
+    EXPECT_FALSE(cache.Lookup(1u, day01Input).has_value());
+
+    // the entry of a validating run is served to trusted runs as well
+    static_cast<void>(PuzzleFactory::SolveConcurrently(*cache.CreatePuzzle(1u, day01Input)));
+    EXPECT_EQ(1u, entry_count());
+    EXPECT_EQ(IPuzzle::Solution_t{45000}, cache.CreatePuzzle(1u, day01Input, trusted)->Part2());
+    EXPECT_EQ(1u, cache.hits());
+}
+
+TEST_F(ResultCacheTest, TrustedSolutionsOfMalformedInputAreNotServed)
+{
+    if (AOC_Y2022_CHECK_TRUSTED_PARSING)
+    {
+        GTEST_SKIP() << "debug builds assert on trusted parsing of a malformed input";
+    }
+    ResultCache cache{directory};
+    constexpr std::string_view malformedInput{"A Y\nB X\nC Zebra\n"};
+    {
+        const auto pPuzzle = cache.CreatePuzzle(2u, malformedInput, PuzzleOptions{.parseMode = ParseMode::trusted});
+        ASSERT_NE(nullptr, pPuzzle);
+        EXPECT_EQ(IPuzzle::Solution_t{15}, PuzzleFactory::SolveConcurrently(*pPuzzle).part1);
+    }
+    const auto pPuzzle = cache.CreatePuzzle(2u, malformedInput);
+    ASSERT_NE(nullptr, pPuzzle);
+    const auto solutions = PuzzleFactory::SolveConcurrently(*pPuzzle);
+    EXPECT_EQ(IPuzzle::Solution_t{}, solutions.part1);
+    EXPECT_EQ(IPuzzle::Solution_t{}, solutions.part2);
+    EXPECT_EQ(0u, cache.hits());
+}
+
+TEST_F(ResultCacheTest, KeyCoversDayAndInput)
+{
+    ResultCache cache{directory};
+    cache.Store(1u, day01Input, IPuzzle::Solutions{.part1 = 1, .part2 = 2});
+    EXPECT_TRUE(cache.Lookup(1u, day01Input).has_value());
+    EXPECT_FALSE(cache.Lookup(2u, day01Input).has_value());
+    EXPECT_FALSE(cache.Lookup(1u, day01Input.substr(1u)).has_value());
+    EXPECT_EQ(1u, cache.hits());
+    EXPECT_EQ(2u, cache.misses());
+}
+
+TEST_F(ResultCacheTest, StoresAllKindsOfSolutions)
+{
+    ResultCache cache{directory};
+    const IPuzzle::Solutions solutions{.part1 = std::int64_t{-1234567890123},
+                                       .part2 = std::string{"#..#\n\n.##. \n"}};
+    cache.Store(10u, "a", solutions);
+    cache.Store(10u, "b", IPuzzle::Solutions{.part1 = std::string{}, .part2 = std::monostate{}});
+
+    const auto first = cache.Lookup(10u, "a");
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(solutions.part1, first->part1);
+    EXPECT_EQ(solutions.part2, first->part2);
+    const auto second = cache.Lookup(10u, "b");
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(IPuzzle::Solution_t{std::string{}}, second->part1);
+    EXPECT_EQ(IPuzzle::Solution_t{}, second->part2);
+}
+
+TEST_F(ResultCacheTest, DamagedEntryIsMiss)
+{
+    ResultCache cache{directory};
+    cache.Store(1u, day01Input, IPuzzle::Solutions{.part1 = 1, .part2 = 2});
+    for (const auto &entry : std::filesystem::directory_iterator{directory})
+    {
+        const auto size = entry.file_size();
+        std::filesystem::resize_file(entry.path(), size - 3u);
+    }
+    EXPECT_FALSE(cache.Lookup(1u, day01Input).has_value());
+}
+
+TEST_F(ResultCacheTest, EvictsLeastRecentlyUsed)
+{
+    const auto store = [](ResultCache &cache, const std::string &input) {
+        cache.Store(3u, input, IPuzzle::Solutions{.part1 = 1, .part2 = 2});
+    };
+    std::uintmax_t entrySize{};
+    {
+        ResultCache cache{directory};
+        store(cache, "size");
+        entrySize = std::filesystem::directory_iterator{directory}->file_size();
+        std::filesystem::remove_all(directory);
+    }
+
+    // room for three entries
+    ResultCache cache{directory, (3u * entrySize) + (entrySize / 2u)};
+    const auto make_older = [this]() {
+        // the modification times are moved explicitly, the file system might not resolve consecutive writes
+        for (const auto &entry : std::filesystem::directory_iterator{directory})
+        {
+            std::filesystem::last_write_time(entry.path(), entry.last_write_time() - std::chrono::seconds{10});
+        }
+    };
+    store(cache, "a");
+    make_older();
+    store(cache, "b");
+    make_older();
+    store(cache, "c");
+    make_older();
+    EXPECT_EQ(3u, entry_count());
+    EXPECT_EQ(0u, cache.evictions());
+
+    // the hit makes "a" the most recently used entry, so "b" is evicted when "d" is stored
+    EXPECT_TRUE(cache.Lookup(3u, "a").has_value());
+    store(cache, "d");
+    EXPECT_EQ(3u, entry_count());
+    EXPECT_EQ(1u, cache.evictions());
+    EXPECT_TRUE(cache.Lookup(3u, "a").has_value());
+    EXPECT_FALSE(cache.Lookup(3u, "b").has_value());
+    EXPECT_TRUE(cache.Lookup(3u, "c").has_value());
+    EXPECT_TRUE(cache.Lookup(3u, "d").has_value());
+}
+
+} // namespace
+
+} // namespace AOC::Y2022
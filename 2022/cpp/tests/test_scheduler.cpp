@@ -0,0 +1,149 @@
+#include "aoc_y2022.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <latch>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+TEST(SchedulerTest, ThreadCount)
+{
+    EXPECT_EQ(1u, Scheduler{1u}.thread_count());
+    EXPECT_EQ(3u, Scheduler{3u}.thread_count());
+    EXPECT_EQ(Scheduler::hardware_thread_count(), Scheduler{}.thread_count());
+    EXPECT_EQ(&Scheduler::shared(), &Scheduler::resolve(nullptr));
+    Scheduler scheduler{2u};
+    EXPECT_EQ(&scheduler, &Scheduler::resolve(&scheduler));
+}
+
+TEST(SchedulerTest, ChunkCount)
+{
+    Scheduler scheduler{8u};
+    EXPECT_EQ(1u, scheduler.chunk_count(0u));
+    EXPECT_EQ(5u, scheduler.chunk_count(5u));
+    EXPECT_EQ(32u, scheduler.chunk_count(1000u));
+    EXPECT_EQ(2u, scheduler.chunk_count(10u, 4u));
+    EXPECT_EQ(1u, scheduler.chunk_count(10u, 100u));
+    static_assert(Scheduler::IndexRange{10u, 13u} == Scheduler::chunk_of(10u, 20u, 0u, 3u));
+    static_assert(Scheduler::IndexRange{16u, 20u} == Scheduler::chunk_of(10u, 20u, 2u, 3u));
+}
+
+TEST(SchedulerTest, ParallelForVisitsEveryIndexOnce)
+{
+    for (const std::size_t threads : {1u, 2u, 5u})
+    {
+        Scheduler scheduler{threads};
+        for (const std::size_t grainSize : {1u, 7u, 1000u})
+        {
+            std::vector<std::atomic<int>> visits(1000u);
+            scheduler.parallel_for(
+                3u, visits.size(),
+                [&visits](const std::size_t begin, const std::size_t end) {
+                    for (auto idx = begin; idx < end; ++idx)
+                    {
+                        ++visits[idx];
+                    }
+                },
+                grainSize);
+            for (std::size_t idx = 0u; idx < visits.size(); ++idx)
+            {
+                ASSERT_EQ((idx < 3u) ? 0 : 1, visits[idx].load()) << "index " << idx;
+            }
+        }
+    }
+}
+
+TEST(SchedulerTest, ParallelReduceCombinesInOrder)
+{
+    Scheduler scheduler{4u};
+    // concatenation is not commutative, so the result shows the order the partial results are combined in
+    const auto digits = scheduler.parallel_reduce(
+        0u, 100u, std::string{},
+        [](const std::size_t begin, const std::size_t end) {
+            std::string partial;
+            for (auto idx = begin; idx < end; ++idx)
+            {
+                partial += static_cast<char>('0' + (idx % 10u));
+            }
+            return partial;
+        },
+        [](std::string left, const std::string &right) { return left + right; });
+    std::string expected;
+    for (std::size_t idx = 0u; idx < 100u; ++idx)
+    {
+        expected += static_cast<char>('0' + (idx % 10u));
+    }
+    EXPECT_EQ(expected, digits);
+    EXPECT_EQ(7, scheduler.parallel_reduce(
+                     5u, 5u, 7, [](std::size_t, std::size_t) { return 1; }, [](int a, int b) { return a + b; }));
+}
+
+/*! \brief Recursive fork/join, every level waits for tasks it started from within a task. */
+std::uint64_t fibonacci(Scheduler &scheduler, const std::uint64_t n)
+{
+    if (n < 2u)
+    {
+        return n;
+    }
+    std::uint64_t left{};
+    std::uint64_t right{};
+    scheduler.fork_join([&]() { left = fibonacci(scheduler, n - 1u); },
+                        [&]() { right = fibonacci(scheduler, n - 2u); });
+    return left + right;
+}
+
+TEST(SchedulerTest, NestedForkJoin)
+{
+    for (const std::size_t threads : {1u, 2u, 4u})
+    {
+        Scheduler scheduler{threads};
+        EXPECT_EQ(610u, fibonacci(scheduler, 15u));
+    }
+}
+
+TEST(SchedulerTest, ForkJoinRunsTasksConcurrently)
+{
+    Scheduler scheduler{3u};
+    // every task waits for the others, so this only finishes if each one runs on a thread of its own
+    std::latch allStarted{3};
+    const auto task = [&allStarted]() { allStarted.arrive_and_wait(); };
+    scheduler.fork_join(task, task, task);
+    EXPECT_TRUE(allStarted.try_wait());
+}
+
+TEST(SchedulerTest, ThrowingTaskIsRethrownAfterTheOthersFinished)
+{
+    Scheduler scheduler{4u};
+    constexpr std::size_t taskCount = 64u;
+    std::atomic<std::size_t> finished{0u};
+    const auto task = [&finished](const std::size_t idx) {
+        if ((idx % 8u) == 3u)
+        {
+            throw std::runtime_error("task " + std::to_string(idx));
+        }
+        ++finished;
+    };
+    EXPECT_THROW(scheduler.run(taskCount, task), std::runtime_error);
+    EXPECT_EQ(taskCount - (taskCount / 8u), finished.load());
+    // the scheduler stays usable and its next run does not see the old exception
+    finished = 0u;
+    scheduler.parallel_for(0u, taskCount, [&finished](const std::size_t begin, const std::size_t end) {
+        finished += end - begin;
+    });
+    EXPECT_EQ(taskCount, finished.load());
+    EXPECT_THROW(scheduler.fork_join([]() {}, []() { throw std::runtime_error("nested"); }), std::runtime_error);
+}
+
+} // namespace
+
+} // namespace AOC::Y2022
@@ -0,0 +1,127 @@
+#include "aoc_y2022.hpp"
+#include "input_generator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+struct StreamingCase
+{
+    std::uint8_t day;
+    std::uint64_t size;
+};
+
+class StreamingPuzzleTest : public ::testing::TestWithParam<StreamingCase>
+{
+  protected:
+    static constexpr std::size_t chunkSizes[]{1u, 7u, 4096u, std::string_view::npos};
+
+    /*! \brief Checks that streaming the input in chunks of every size gives the solutions of the regular puzzle. */
+    static void expect_same_solutions(const std::uint8_t day, std::string_view input)
+    {
+        auto pPuzzle = PuzzleFactory::CreatePuzzle(day, input);
+        ASSERT_NE(pPuzzle, nullptr);
+        const auto expected1 = pPuzzle->Part1();
+        const auto expected2 = pPuzzle->Part2();
+        for (const auto chunkSize : chunkSizes)
+        {
+            SCOPED_TRACE(testing::Message() << "chunk size " << chunkSize);
+            auto pStreamingPuzzle = PuzzleFactory::CreateStreamingPuzzle(day);
+            ASSERT_NE(pStreamingPuzzle, nullptr);
+            for (auto remaining = input; !remaining.empty();)
+            {
+                const auto chunk = remaining.substr(0u, std::min(chunkSize, remaining.size()));
+                // a copy makes sure no view into a previous chunk is kept
+                const std::string chunkCopy{chunk};
+                if (!pStreamingPuzzle->Push(chunkCopy))
+                {
+                    break;
+                }
+                remaining.remove_prefix(chunk.size());
+            }
+            const auto solutions = pStreamingPuzzle->Finish();
+            EXPECT_EQ(expected1, solutions.part1);
+            EXPECT_EQ(expected2, solutions.part2);
+        }
+    }
+};
+
+TEST_P(StreamingPuzzleTest, MatchesPuzzle)
+{
+    const auto [day, size] = GetParam();
+    ASSERT_TRUE(PuzzleFactory::has_streaming_implementation_for_day(day));
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 3u});
+    ASSERT_FALSE(input.empty());
+    expect_same_solutions(day, input);
+}
+
+TEST_P(StreamingPuzzleTest, MatchesPuzzleWithoutTrailingNewline)
+{
+    const auto [day, size] = GetParam();
+    auto input = InputGenerator::Generate(day, {.size = size, .seed = 4u});
+    while (!input.empty() && (input.back() == '\n'))
+    {
+        input.pop_back();
+    }
+    expect_same_solutions(day, input);
+}
+
+TEST_P(StreamingPuzzleTest, MatchesPuzzleWithCarriageReturns)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 5u});
+    std::string crlfInput;
+    for (const auto c : input)
+    {
+        if (c == '\n')
+        {
+            crlfInput += '\r';
+        }
+        crlfInput += c;
+    }
+    expect_same_solutions(day, crlfInput);
+}
+
+TEST_P(StreamingPuzzleTest, MatchesPuzzleOnInvalidInput)
+{
+    const auto [day, size] = GetParam();
+    const auto input = InputGenerator::Generate(day, {.size = size, .seed = 6u});
+    expect_same_solutions(day, input + "invalid line\n");
+    expect_same_solutions(day, "invalid line\n" + input);
+}
+
+INSTANTIATE_TEST_SUITE_P(StreamingDays, StreamingPuzzleTest,
+                         ::testing::Values(StreamingCase{1u, 300u}, StreamingCase{2u, 300u}, StreamingCase{3u, 300u},
+                                           StreamingCase{4u, 300u}, StreamingCase{6u, 300u},
+                                           StreamingCase{10u, 100u}, StreamingCase{10u, 1000u}));
+
+TEST(StreamingPuzzle, EmptyInput)
+{
+    auto pStreamingPuzzle = PuzzleFactory::CreateStreamingPuzzle(1u);
+    ASSERT_NE(pStreamingPuzzle, nullptr);
+    const auto solutions = pStreamingPuzzle->Finish();
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(solutions.part1));
+    EXPECT_TRUE(std::holds_alternative<std::monostate>(solutions.part2));
+}
+
+TEST(StreamingPuzzle, UnsupportedDay)
+{
+    EXPECT_FALSE(PuzzleFactory::has_streaming_implementation_for_day(5u));
+    EXPECT_EQ(PuzzleFactory::CreateStreamingPuzzle(5u), nullptr);
+    EXPECT_EQ(PuzzleFactory::CreateStreamingPuzzle(0u), nullptr);
+}
+
+} // namespace
+
+} // namespace AOC::Y2022
@@ -0,0 +1,275 @@
+#include "embedded_inputs.hpp"
+#include "line_index.hpp"
+#include "utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace AOC::Y2022
+{
+
+namespace
+{
+
+static_assert(3u == find_line_break("abc\r\ndef"));
+static_assert(std::string_view::npos == find_line_break("abcdef"));
+static_assert(5u == find_next_line("abc\r\ndef", 3u));
+
+/*! \brief Random text with a few line breaks, long enough to span several vector registers. */
+std::string random_text(std::mt19937 &generator, const std::size_t maxLength)
+{
+    std::uniform_int_distribution<std::size_t> lengthDistribution{0u, maxLength};
+    std::uniform_int_distribution<int> charDistribution{0, 19};
+    std::string text(lengthDistribution(generator), 'a');
+    for (auto &c : text)
+    {
+        switch (charDistribution(generator))
+        {
+        case 0:
+            c = '\n';
+            break;
+        case 1:
+            c = '\r';
+            break;
+        case 2:
+            c = ' ';
+            break;
+        default:
+            c = static_cast<char>('a' + charDistribution(generator));
+            break;
+        }
+    }
+    return text;
+}
+
+/*! \brief Splits the text like the original scalar implementation of for_each_line did. */
+std::vector<std::string_view> reference_lines(std::string_view input)
+{
+    std::vector<std::string_view> lines;
+    while (!input.empty())
+    {
+        lines.push_back(input.substr(0u, input.find_first_of("\r\n")));
+        const auto lf = input.find('\n');
+        if (lf == input.npos)
+        {
+            break;
+        }
+        input.remove_prefix(lf + 1u);
+    }
+    return lines;
+}
+
+TEST(UtilsTest, FindLineBreakMatchesScalarSearch)
+{
+    std::mt19937 generator{42u};
+    for (std::size_t run = 0u; run < 500u; ++run)
+    {
+        const auto text = random_text(generator, 100u);
+        const std::string_view view{text};
+        for (std::size_t pos = 0u; pos <= view.size(); ++pos)
+        {
+            ASSERT_EQ(view.find_first_of("\r\n", pos), find_line_break(view, pos)) << "position " << pos;
+        }
+    }
+}
+
+TEST(UtilsTest, LinesAreSplitLikeScalarImplementation)
+{
+    std::mt19937 generator{7u};
+    for (std::size_t run = 0u; run < 500u; ++run)
+    {
+        const auto text = random_text(generator, 200u);
+        const auto expected = reference_lines(text);
+
+        std::vector<std::string_view> lines;
+        for_each_line(
+            text,
+            [&lines](const std::string_view line) {
+                lines.push_back(line);
+                return true;
+            },
+            ParseLine::continue_if_empty);
+        EXPECT_EQ(expected, lines);
+
+        // an empty input is seen as a single empty line by LinesView
+        std::vector<std::string_view> viewLines;
+        for (const auto line : LinesView{std::string_view{text}})
+        {
+            viewLines.push_back(line);
+        }
+        EXPECT_EQ(text.empty() ? std::vector<std::string_view>{""} : expected, viewLines);
+
+        std::vector<std::string> carriedLines;
+        const auto collect = [&carriedLines](const std::string_view line) {
+            carriedLines.emplace_back(line);
+            return true;
+        };
+        LineCarry carry;
+        const std::size_t chunkSize = 1u + (run % 23u);
+        for (std::size_t pos = 0u; pos < text.size(); pos += chunkSize)
+        {
+            carry.push(std::string_view{text}.substr(pos, chunkSize), collect);
+        }
+        carry.finish(collect);
+        EXPECT_EQ(std::vector<std::string>(expected.begin(), expected.end()), carriedLines);
+    }
+}
+
+TEST(UtilsTest, ForEachLineStopsAtEmptyLine)
+{
+    std::vector<std::string_view> lines;
+    EXPECT_FALSE(for_each_line("a\r\nb\n\nc\n", [&lines](const std::string_view line) {
+        lines.push_back(line);
+        return true;
+    }));
+    EXPECT_EQ((std::vector<std::string_view>{"a", "b"}), lines);
+}
+
+/*! \brief Checks the lines of the index and that splitting them gives consecutive ranges covering all lines. */
+void expect_index_matches(const LineIndex &index, const std::vector<std::string_view> &expected,
+                          const std::size_t rangeCount)
+{
+    ASSERT_EQ(expected.size(), index.size());
+    for (std::size_t line = 0u; line < index.size(); ++line)
+    {
+        ASSERT_EQ(expected[line], index[line]) << "line " << line;
+    }
+    const auto ranges = index.split(rangeCount);
+    ASSERT_EQ(rangeCount, ranges.size());
+    std::size_t nextLine = 0u;
+    for (const auto &[first, last] : ranges)
+    {
+        EXPECT_EQ(nextLine, first);
+        EXPECT_LE(first, last);
+        nextLine = last;
+    }
+    EXPECT_EQ(index.size(), nextLine);
+}
+
+TEST(UtilsTest, LineIndexMatchesLineSplitting)
+{
+    std::mt19937 generator{5u};
+    for (std::size_t run = 0u; run < 200u; ++run)
+    {
+        const auto text = random_text(generator, 300u);
+        expect_index_matches(LineIndex::build(text), reference_lines(text), 1u + (run % 7u));
+    }
+}
+
+TEST(UtilsTest, LineIndexIsBuiltInParallel)
+{
+    std::mt19937 generator{6u};
+    std::string text;
+    while (text.size() < (1024u * 1024u))
+    {
+        text += random_text(generator, 300u);
+    }
+    const auto expected = reference_lines(text);
+    for (const std::size_t threads : {1u, 2u, 3u, 8u})
+    {
+        Scheduler scheduler{threads};
+        expect_index_matches(LineIndex::build(text, scheduler), expected, scheduler.chunk_count(expected.size()));
+    }
+}
+
+TEST(UtilsTest, ParseDecimalMatchesParseNumber)
+{
+    std::mt19937_64 generator{3u};
+    const std::string_view prefixes[]{"", " ", "+", "-", "- ", " +  ", "x"};
+    const std::string_view suffixes[]{"", "\n", ",", " 17", "-3", "\r\n"};
+    for (std::size_t run = 0u; run < 5000u; ++run)
+    {
+        const auto digits = std::to_string(generator() >> (run % 64u)).substr(0u, 1u + (run % 19u));
+        for (const auto prefix : prefixes)
+        {
+            for (const auto suffix : suffixes)
+            {
+                const auto text = std::string{prefix} + digits + std::string{suffix};
+                ASSERT_EQ(parse_number<std::int64_t>(text), parse_decimal<std::int64_t>(text)) << text;
+                ASSERT_EQ(parse_number<std::uint64_t>(text), parse_decimal<std::uint64_t>(text)) << text;
+                ASSERT_EQ(parse_number<std::int32_t>(text), parse_decimal<std::int32_t>(text)) << text;
+                ASSERT_EQ(parse_number<std::uint8_t>(text), parse_decimal<std::uint8_t>(text)) << text;
+            }
+        }
+    }
+}
+
+TEST(UtilsTest, ParseDecimalCheckedReportsOverflow)
+{
+    std::mt19937_64 generator{4u};
+    constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t run = 0u; run < 5000u; ++run)
+    {
+        const auto value = generator() >> (run % 64u);
+        std::uint64_t parsed{};
+        ASSERT_TRUE(parse_decimal_checked(std::to_string(value) + "\n", parsed));
+        ASSERT_EQ(value, parsed);
+        // one more digit fits if value * 10 + digit does not exceed the maximum
+        const auto digit = run % 10u;
+        const auto text = std::to_string(value) + std::to_string(digit);
+        ASSERT_EQ(value <= ((max - digit) / 10u), parse_decimal_checked(text, parsed)) << text;
+        std::uint32_t parsed32{};
+        ASSERT_EQ(value <= std::numeric_limits<std::uint32_t>::max(), parse_decimal_checked(std::to_string(value), parsed32));
+    }
+}
+
+TEST(UtilsTest, ParseAllNumbers)
+{
+    std::string_view buffer{"  Starting items: 79, 98, 1234567890123, -5\n\n\n\n\n\n\n\n\n\n0x12345678901234567"};
+    std::array<std::int64_t, 4u> numbers{};
+    ASSERT_EQ(4u, parse_all_numbers(buffer, std::span{numbers}));
+    EXPECT_EQ((std::array<std::int64_t, 4u>{79, 98, 1234567890123, -5}), numbers);
+    ASSERT_EQ(2u, parse_all_numbers(buffer, std::span{numbers}));
+    EXPECT_EQ(0, numbers[0]);
+    EXPECT_EQ(12345678901234567, numbers[1]);
+    EXPECT_TRUE(buffer.empty());
+
+    std::array<std::uint32_t, 2u> unsignedNumbers{};
+    std::string_view negative{"-7 8"};
+    ASSERT_EQ(2u, parse_all_numbers(negative, std::span{unsignedNumbers}));
+    EXPECT_EQ((std::array<std::uint32_t, 2u>{7u, 8u}), unsignedNumbers);
+    std::string_view empty{};
+    EXPECT_EQ(0u, parse_all_numbers(empty, std::span{unsignedNumbers}));
+
+    // the sign ends a window without any digits
+    std::string_view signAtWindowEnd{"abcdefg-5, x-12"};
+    std::array<std::int32_t, 2u> signedNumbers{};
+    ASSERT_EQ(2u, parse_all_numbers(signAtWindowEnd, std::span{signedNumbers}));
+    EXPECT_EQ((std::array<std::int32_t, 2u>{-5, -12}), signedNumbers);
+    std::string_view signsOnly{"--------------------7"};
+    ASSERT_EQ(1u, parse_all_numbers(signsOnly, std::span{signedNumbers}));
+    EXPECT_EQ(-7, signedNumbers[0]);
+}
+
+TEST(UtilsTest, PrecomputedSolutionsKeepAllKinds)
+{
+    constexpr auto solutions = PrecomputedSolutions::from(std::int64_t{-42}, std::monostate{});
+    static_assert(solutions.valid);
+    EXPECT_EQ(IPuzzle::Solution_t{-42}, solutions.to_solutions().part1);
+    EXPECT_EQ(IPuzzle::Solution_t{}, solutions.to_solutions().part2);
+
+    const std::string display{"#..#\n.##.\n"};
+    const auto textSolutions = PrecomputedSolutions::from(std::string{"BSDMQFLSP"}, display);
+    ASSERT_TRUE(textSolutions.valid);
+    EXPECT_EQ(IPuzzle::Solution_t{"BSDMQFLSP"}, textSolutions.to_solutions().part1);
+    EXPECT_EQ(IPuzzle::Solution_t{display}, textSolutions.to_solutions().part2);
+
+    // such an input is solved at runtime instead
+    const std::string tooLong(PrecomputedSolution::maxTextLength + 1u, '#');
+    EXPECT_FALSE(PrecomputedSolutions::from(tooLong, std::int64_t{1}).valid);
+    static_assert(!hasEmbeddedInput<12u>);
+}
+
+} // namespace
+
+} // namespace AOC::Y2022